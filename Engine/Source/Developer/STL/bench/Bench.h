@@ -0,0 +1,355 @@
+//
+// bench/Bench.h
+//
+// Created by Falldot on 18.10.2026.
+// Copyright (c) 2021 Corsac. All rights reserved.
+//
+#ifndef CORSAC_BENCH_H
+#define CORSAC_BENCH_H
+
+/**
+ * Описание (Falldot 18.10.2026)
+ *
+ * Минимальный каркас микробенчмарков для corsac::STL.
+ *
+ * Каждый замер (run) проходит три фазы:
+ *      калибровка   - число итераций в одном сэмпле удваивается, пока сэмпл не займет
+ *                     не меньше minSampleNs, чтобы точность таймера не влияла на результат;
+ *      прогрев      - warmup сэмплов выполняются и отбрасываются (кеши, предсказатель, страницы);
+ *      измерение    - repetitions сэмплов, по которым считаются медиана, p99, минимум и среднее
+ *                     времени одной итерации.
+ *
+ * Пары замеров с именами "<что>/corsac" и "<что>/std" в одной группе дополнительно
+ * выводятся как отношение corsac / std.
+ *
+ * Параметры командной строки (см. Bench::parse_args):
+ *      --filter <подстрока>    запускать только замеры, в полном имени которых есть подстрока;
+ *      --warmup <n>            число прогревочных сэмплов;
+ *      --repetitions <n>       число измеряемых сэмплов;
+ *      --min-sample-us <n>     минимальная длительность сэмпла;
+ *      --json <файл>           записать результаты в JSON;
+ *      --baseline <файл>       сравнить медианы с ранее записанным JSON;
+ *      --threshold <процент>   допустимое замедление относительно baseline, по умолчанию 10.
+ *
+ * Если хотя бы один замер медленнее baseline больше чем на threshold, finish() возвращает 1.
+ *
+ * Пример использования:
+ *      bench->add_group("vector", [](corsac::Bench* bench) {
+ *          bench->run("push_back/corsac", [] {
+ *              corsac::vector<int> v;
+ *              for(int i = 0; i < 1000; ++i)
+ *                  v.push_back(i);
+ *              corsac::do_not_optimize(v.data());
+ *          });
+ *      });
+ */
+
+#include <new>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+namespace corsac
+{
+    /**
+     * do_not_optimize / clobber_memory
+     *
+     * Барьеры для компилятора: do_not_optimize заставляет считать значение использованным
+     * (и, для неконстантной ссылки, измененным), clobber_memory - считать, что вся память
+     * могла быть прочитана и записана. Ни один из них не генерирует инструкций.
+     */
+    #if defined(_MSC_VER)
+        template <typename T>
+        inline void do_not_optimize(T const& value)
+        {
+            static volatile const void* sink;
+            sink = &value;
+            _ReadWriteBarrier();
+        }
+
+        inline void clobber_memory()
+        {
+            _ReadWriteBarrier();
+        }
+    #else
+        template <typename T>
+        inline void do_not_optimize(T const& value)
+        {
+            __asm__ __volatile__("" : : "r,m"(value) : "memory");
+        }
+
+        template <typename T>
+        inline void do_not_optimize(T& value)
+        {
+            __asm__ __volatile__("" : "+r,m"(value) : : "memory");
+        }
+
+        inline void clobber_memory()
+        {
+            __asm__ __volatile__("" : : : "memory");
+        }
+    #endif
+
+    struct bench_options
+    {
+        size_t      warmup      = 3;
+        size_t      repetitions = 31;
+        double      minSampleNs = 200000.0;
+        double      threshold   = 0.10;
+        const char* filter      = nullptr;
+        const char* jsonPath    = nullptr;
+        const char* baseline    = nullptr;
+    };
+
+    struct bench_result
+    {
+        std::string group;
+        std::string name;
+        size_t      iterations;  // Итераций в одном сэмпле.
+        size_t      repetitions;
+        double      medianNs;    // Время одной итерации.
+        double      p99Ns;
+        double      minNs;
+        double      meanNs;
+    };
+
+    class Bench
+    {
+    public:
+        explicit Bench(const char* name, const bench_options& options = bench_options())
+            : mName(name), mOptions(options) {}
+
+        static bench_options parse_args(int argc, char** argv)
+        {
+            bench_options options;
+            for(int i = 1; i + 1 < argc; i += 2)
+            {
+                const char* key   = argv[i];
+                const char* value = argv[i + 1];
+
+                if(!strcmp(key, "--filter"))             options.filter      = value;
+                else if(!strcmp(key, "--warmup"))        options.warmup      = (size_t)strtoull(value, nullptr, 10);
+                else if(!strcmp(key, "--repetitions"))   options.repetitions = std::max<size_t>(1, (size_t)strtoull(value, nullptr, 10));
+                else if(!strcmp(key, "--min-sample-us")) options.minSampleNs = strtod(value, nullptr) * 1000.0;
+                else if(!strcmp(key, "--json"))          options.jsonPath    = value;
+                else if(!strcmp(key, "--baseline"))      options.baseline    = value;
+                else if(!strcmp(key, "--threshold"))     options.threshold   = strtod(value, nullptr) / 100.0;
+                else
+                {
+                    fprintf(stderr, "unknown option %s\n", key);
+                    --i;
+                }
+            }
+            return options;
+        }
+
+        void add_group(const char* name, const std::function<void(Bench*)>& body)
+        {
+            const std::string previous = mGroup;
+            mGroup = mGroup.empty() ? std::string(name) : mGroup + "/" + name;
+            printf("\n[%s]\n", mGroup.c_str());
+            body(this);
+            print_ratios(mGroup);
+            mGroup = previous;
+        }
+
+        /**
+         * run
+         *
+         * Измеряет fn(), одна итерация - один вызов fn.
+         */
+        template <typename Function>
+        void run(const char* name, Function&& fn)
+        {
+            const std::string fullName = mGroup + "/" + name;
+            if(mOptions.filter && fullName.find(mOptions.filter) == std::string::npos)
+                return;
+
+            size_t iterations = 1;
+            while(sample(fn, iterations) * (double)iterations < mOptions.minSampleNs && iterations < (size_t(1) << 30))
+                iterations *= 2;
+
+            for(size_t i = 0; i < mOptions.warmup; ++i)
+                sample(fn, iterations);
+
+            std::vector<double> samples(mOptions.repetitions);
+            for(double& s : samples)
+                s = sample(fn, iterations);
+            std::sort(samples.begin(), samples.end());
+
+            bench_result result;
+            result.group       = mGroup;
+            result.name        = name;
+            result.iterations  = iterations;
+            result.repetitions = samples.size();
+            result.medianNs    = samples[samples.size() / 2];
+            result.p99Ns       = samples[std::min(samples.size() - 1, (size_t)(samples.size() * 0.99))];
+            result.minNs       = samples.front();
+            result.meanNs      = 0.0;
+            for(double s : samples)
+                result.meanNs += s / (double)samples.size();
+
+            printf("  %-40s median %12.1f ns   p99 %12.1f ns   min %12.1f ns   (%zu x %zu)\n",
+                   name, result.medianNs, result.p99Ns, result.minNs, result.repetitions, result.iterations);
+            mResults.push_back(result);
+        }
+
+        /**
+         * finish
+         *
+         * Записывает JSON, сравнивает с baseline и возвращает код завершения процесса.
+         */
+        int finish()
+        {
+            if(mOptions.jsonPath)
+                write_json(mOptions.jsonPath);
+            return mOptions.baseline ? compare_baseline(mOptions.baseline) : 0;
+        }
+
+        const std::vector<bench_result>& results() const { return mResults; }
+
+    private:
+        template <typename Function>
+        static double sample(Function& fn, size_t iterations)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            for(size_t i = 0; i < iterations; ++i)
+                fn();
+            const auto stop = std::chrono::steady_clock::now();
+            return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count() / (double)iterations;
+        }
+
+        const bench_result* find(const std::string& group, const std::string& name) const
+        {
+            for(const bench_result& r : mResults)
+                if(r.group == group && r.name == name)
+                    return &r;
+            return nullptr;
+        }
+
+        void print_ratios(const std::string& group) const
+        {
+            static const char kSuffix[] = "/corsac";
+            const size_t suffixLength   = sizeof(kSuffix) - 1;
+
+            for(const bench_result& r : mResults)
+            {
+                if(r.group != group || r.name.size() <= suffixLength || r.name.compare(r.name.size() - suffixLength, suffixLength, kSuffix) != 0)
+                    continue;
+                const std::string base = r.name.substr(0, r.name.size() - suffixLength);
+                if(const bench_result* other = find(group, base + "/std"))
+                    printf("  %-40s corsac / std = %.2f\n", base.c_str(), r.medianNs / other->medianNs);
+            }
+        }
+
+        static void write_escaped(FILE* file, const std::string& s)
+        {
+            fputc('"', file);
+            for(char c : s)
+            {
+                if(c == '"' || c == '\\')
+                    fputc('\\', file);
+                fputc(c, file);
+            }
+            fputc('"', file);
+        }
+
+        // Каждый замер пишется одной строкой, на этом основано чтение baseline.
+        void write_json(const char* path) const
+        {
+            FILE* file = fopen(path, "w");
+            if(!file)
+            {
+                fprintf(stderr, "cannot open %s\n", path);
+                return;
+            }
+
+            fprintf(file, "{\n  \"suite\": ");
+            write_escaped(file, mName);
+            fprintf(file, ",\n  \"benchmarks\": [\n");
+            for(size_t i = 0; i < mResults.size(); ++i)
+            {
+                const bench_result& r = mResults[i];
+                fprintf(file, "    {\"group\": ");
+                write_escaped(file, r.group);
+                fprintf(file, ", \"name\": ");
+                write_escaped(file, r.name);
+                fprintf(file, ", \"iterations\": %zu, \"repetitions\": %zu, \"median_ns\": %.3f, \"p99_ns\": %.3f, \"min_ns\": %.3f, \"mean_ns\": %.3f}%s\n",
+                        r.iterations, r.repetitions, r.medianNs, r.p99Ns, r.minNs, r.meanNs, (i + 1 < mResults.size()) ? "," : "");
+            }
+            fprintf(file, "  ]\n}\n");
+            fclose(file);
+        }
+
+        static bool read_string_field(const char* line, const char* key, std::string& out)
+        {
+            const char* p = strstr(line, key);
+            if(!p || !(p = strchr(p + strlen(key), '"')))
+                return false;
+
+            out.clear();
+            for(++p; *p && *p != '"'; ++p)
+            {
+                if(*p == '\\' && p[1])
+                    ++p;
+                out += *p;
+            }
+            return true;
+        }
+
+        int compare_baseline(const char* path) const
+        {
+            FILE* file = fopen(path, "r");
+            if(!file)
+            {
+                fprintf(stderr, "cannot open baseline %s\n", path);
+                return 1;
+            }
+
+            int  regressions = 0;
+            char line[4096];
+            printf("\n[baseline %s, threshold %.0f%%]\n", path, mOptions.threshold * 100.0);
+            while(fgets(line, sizeof(line), file))
+            {
+                std::string group, name;
+                const char* median = strstr(line, "\"median_ns\":");
+                if(!median || !read_string_field(line, "\"group\":", group) || !read_string_field(line, "\"name\":", name))
+                    continue;
+
+                const bench_result* current = find(group, name);
+                if(!current)
+                    continue;
+
+                const double baselineNs = strtod(median + strlen("\"median_ns\":"), nullptr);
+                const double change     = baselineNs > 0.0 ? current->medianNs / baselineNs - 1.0 : 0.0;
+                if(change > mOptions.threshold)
+                {
+                    ++regressions;
+                    printf("  REGRESSION %s/%s: %.1f ns -> %.1f ns (%+.1f%%)\n", group.c_str(), name.c_str(), baselineNs, current->medianNs, change * 100.0);
+                }
+            }
+            fclose(file);
+
+            printf("  %d regression(s)\n", regressions);
+            return regressions ? 1 : 0;
+        }
+
+        std::string               mName;
+        std::string               mGroup;
+        bench_options             mOptions;
+        std::vector<bench_result> mResults;
+    };
+}
+
+#endif //CORSAC_BENCH_H
@@ -0,0 +1,95 @@
+//
+// bench/algorithm_bench.h
+//
+// Created by Falldot on 18.10.2026.
+// Copyright (c) 2021 Corsac. All rights reserved.
+//
+#ifndef CORSAC_ALGORITHM_BENCH_H
+#define CORSAC_ALGORITHM_BENCH_H
+
+#include "Corsac/algorithm.h"
+
+#include <algorithm>
+
+bool algorithm_bench(corsac::Bench* bench)
+{
+    static const size_t kCount = 64 * 1024;
+    static int   source[kCount];
+    static int   dest[kCount];
+    static float grid[kCount];
+
+    for(size_t i = 0; i < kCount; ++i)
+        source[i] = (int)i;
+
+    bench->add_group("algorithm", [](corsac::Bench* bench)
+    {
+        bench->run("copy/corsac", []
+        {
+            corsac::copy(source, source + kCount, dest);
+            corsac::clobber_memory();
+        });
+        bench->run("copy/std", []
+        {
+            std::copy(source, source + kCount, dest);
+            corsac::clobber_memory();
+        });
+
+        bench->run("fill float/corsac", []
+        {
+            corsac::fill(grid, grid + kCount, 1.0f);
+            corsac::clobber_memory();
+        });
+        bench->run("fill float/std", []
+        {
+            std::fill(grid, grid + kCount, 1.0f);
+            corsac::clobber_memory();
+        });
+
+        bench->run("find/corsac", []
+        {
+            corsac::do_not_optimize(corsac::find(source, source + kCount, (int)kCount - 1));
+        });
+        bench->run("find/std", []
+        {
+            corsac::do_not_optimize(std::find(source, source + kCount, (int)kCount - 1));
+        });
+
+        bench->run("min_element/corsac", []
+        {
+            corsac::do_not_optimize(corsac::min_element(source, source + kCount));
+        });
+        bench->run("min_element/std", []
+        {
+            corsac::do_not_optimize(std::min_element(source, source + kCount));
+        });
+
+        bench->run("lower_bound/corsac", []
+        {
+            int sum = 0;
+            for(int key = 0; key < 1024; ++key)
+                sum += *corsac::lower_bound(source, source + kCount, key * 61);
+            corsac::do_not_optimize(sum);
+        });
+        bench->run("lower_bound/std", []
+        {
+            int sum = 0;
+            for(int key = 0; key < 1024; ++key)
+                sum += *std::lower_bound(source, source + kCount, key * 61);
+            corsac::do_not_optimize(sum);
+        });
+
+        bench->run("reverse/corsac", []
+        {
+            corsac::reverse(dest, dest + kCount);
+            corsac::clobber_memory();
+        });
+        bench->run("reverse/std", []
+        {
+            std::reverse(dest, dest + kCount);
+            corsac::clobber_memory();
+        });
+    });
+    return true;
+}
+
+#endif //CORSAC_ALGORITHM_BENCH_H
@@ -0,0 +1,56 @@
+//
+// bench/allocator_bench.h
+//
+// Created by Falldot on 18.10.2026.
+// Copyright (c) 2021 Corsac. All rights reserved.
+//
+#ifndef CORSAC_ALLOCATOR_BENCH_H
+#define CORSAC_ALLOCATOR_BENCH_H
+
+#include "Corsac/allocator.h"
+#include "Corsac/STL/fixed_pool.h"
+
+#include <memory>
+
+bool allocator_bench(corsac::Bench* bench)
+{
+    static const size_t kNodeSize  = 64;
+    static const size_t kNodeCount = 1024;
+
+    bench->add_group("allocator", [](corsac::Bench* bench)
+    {
+        static void* blocks[kNodeCount];
+
+        bench->run("allocate 64B x1024/corsac", []
+        {
+            corsac::allocator allocator;
+            for(void*& p : blocks)
+                p = allocator.allocate(kNodeSize);
+            for(void* p : blocks)
+                allocator.deallocate(p, kNodeSize);
+        });
+        bench->run("allocate 64B x1024/std", []
+        {
+            std::allocator<char> allocator;
+            for(void*& p : blocks)
+                p = allocator.allocate(kNodeSize);
+            for(void* p : blocks)
+                allocator.deallocate(static_cast<char*>(p), kNodeSize);
+        });
+
+        using node_allocator = corsac::fixed_node_allocator<kNodeSize, kNodeCount, 8, 0, false>;
+        static corsac::aligned_buffer<node_allocator::kBufferSize, 8> buffer;
+
+        bench->run("fixed_node_allocator 64B x1024", []
+        {
+            node_allocator allocator(buffer.buffer);
+            for(void*& p : blocks)
+                p = allocator.allocate(kNodeSize);
+            for(void* p : blocks)
+                allocator.deallocate(p, kNodeSize);
+        });
+    });
+    return true;
+}
+
+#endif //CORSAC_ALLOCATOR_BENCH_H
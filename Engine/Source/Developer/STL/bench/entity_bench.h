@@ -0,0 +1,106 @@
+//
+// bench/entity_bench.h
+//
+// Created by Falldot on 18.10.2026.
+// Copyright (c) 2021 Corsac. All rights reserved.
+//
+#ifndef CORSAC_ENTITY_BENCH_H
+#define CORSAC_ENTITY_BENCH_H
+
+#include "Corsac/entity.h"
+
+#include <vector>
+
+bool entity_bench(corsac::Bench* bench)
+{
+    static const uint32_t kCount = 10000;
+    static const uint32_t kBurst = 1000;
+
+    // Эквивалент в стандартной библиотеке - поколения и свободный список в std::vector
+    // и флаг жизни в std::vector<bool>, сущности выдаются по одной.
+    struct std_entities
+    {
+        std::vector<uint32_t> generations;
+        std::vector<uint32_t> free;
+        std::vector<bool>     alive;
+
+        corsac::entity create()
+        {
+            if(!free.empty())
+            {
+                const uint32_t index = free.back();
+                free.pop_back();
+                alive[index] = true;
+                return corsac::entity(index, generations[index]);
+            }
+            generations.push_back(0);
+            alive.push_back(true);
+            return corsac::entity((uint32_t)generations.size() - 1, 0);
+        }
+
+        void destroy(corsac::entity e)
+        {
+            if(e.index < generations.size() && generations[e.index] == e.generation)
+            {
+                ++generations[e.index];
+                alive[e.index] = false;
+                free.push_back(e.index);
+            }
+        }
+    };
+
+    bench->add_group("entity_manager", [](corsac::Bench* bench)
+    {
+        static corsac::entity_manager corsacEntities;
+        static std_entities           stdEntities;
+        if(corsacEntities.size() == 0)
+        {
+            // Каждая третья сущность мертва: маска и флаги с дырами, как после нескольких кадров.
+            static corsac::entity created[kCount];
+            corsacEntities.create(kCount, created);
+            for(uint32_t i = 0; i < kCount; ++i)
+                stdEntities.create();
+            for(uint32_t i = 0; i < kCount; i += 3)
+            {
+                corsacEntities.destroy(created[i]);
+                stdEntities.destroy(created[i]);
+            }
+        }
+
+        // Кадр с залпом: тысяча пуль создается и уничтожается.
+        bench->run("burst/corsac", []
+        {
+            static corsac::entity bullets[kBurst];
+            corsacEntities.create(kBurst, bullets);
+            corsacEntities.destroy(bullets, kBurst);
+            corsac::do_not_optimize(bullets[kBurst - 1]);
+        });
+        bench->run("burst/std", []
+        {
+            static corsac::entity bullets[kBurst];
+            for(uint32_t i = 0; i < kBurst; ++i)
+                bullets[i] = stdEntities.create();
+            for(uint32_t i = 0; i < kBurst; ++i)
+                stdEntities.destroy(bullets[i]);
+            corsac::do_not_optimize(bullets[kBurst - 1]);
+        });
+
+        bench->run("for_each_alive/corsac", []
+        {
+            uint32_t sum = 0;
+            corsacEntities.for_each_alive([&](corsac::entity e) { sum += e.index; });
+            corsac::do_not_optimize(sum);
+        });
+        bench->run("for_each_alive/std", []
+        {
+            uint32_t sum = 0;
+            for(uint32_t i = 0, n = (uint32_t)stdEntities.alive.size(); i < n; ++i)
+                if(stdEntities.alive[i])
+                    sum += i;
+            corsac::do_not_optimize(sum);
+        });
+    });
+    return true;
+}
+
+#endif //CORSAC_ENTITY_BENCH_H
@@ -0,0 +1,86 @@
+//
+// bench/function_bench.h
+//
+// Created by Falldot on 18.10.2026.
+// Copyright (c) 2021 Corsac. All rights reserved.
+//
+#ifndef CORSAC_FUNCTION_BENCH_H
+#define CORSAC_FUNCTION_BENCH_H
+
+#include "Corsac/functional.h"
+
+#include <functional>
+
+inline void function_bench_visit(const int* values, int count, corsac::function_ref<void(int)> visitor)
+{
+    for(int i = 0; i < count; ++i)
+        visitor(values[i]);
+}
+
+inline void function_bench_visit_std(const int* values, int count, const std::function<void(int)>& visitor)
+{
+    for(int i = 0; i < count; ++i)
+        visitor(values[i]);
+}
+
+bool function_bench(corsac::Bench* bench)
+{
+    // Задача с захватом в 40 байт: больше буфера std::function, но меньше буфера unique_function.
+    struct job_payload
+    {
+        uint64_t a, b, c, d;
+        uint64_t* out;
+    };
+    static const int kJobs = 1000;
+
+    bench->add_group("function", [](corsac::Bench* bench)
+    {
+        bench->run("enqueue+run 40B job x1000/corsac", []
+        {
+            static corsac::unique_function<void()> queue[kJobs];
+            uint64_t sum = 0;
+            for(int i = 0; i < kJobs; ++i)
+            {
+                job_payload p = { uint64_t(i), 2, 3, 4, &sum };
+                queue[i] = [p] { *p.out += p.a + p.b + p.c + p.d; };
+            }
+            for(int i = 0; i < kJobs; ++i)
+                queue[i]();
+            corsac::do_not_optimize(sum);
+        });
+        bench->run("enqueue+run 40B job x1000/std", []
+        {
+            static std::function<void()> queue[kJobs];
+            uint64_t sum = 0;
+            for(int i = 0; i < kJobs; ++i)
+            {
+                job_payload p = { uint64_t(i), 2, 3, 4, &sum };
+                queue[i] = [p] { *p.out += p.a + p.b + p.c + p.d; };
+            }
+            for(int i = 0; i < kJobs; ++i)
+                queue[i]();
+            corsac::do_not_optimize(sum);
+        });
+        // Посетитель передается в функцию, вызванную через volatile-указатель, чтобы компилятор не встроил ее
+        // и не убрал стирание типа.
+        bench->run("visitor x1000/corsac", []
+        {
+            static int values[kJobs];
+            uint64_t sum = 0;
+            static void (*volatile visit)(const int*, int, corsac::function_ref<void(int)>) = &function_bench_visit;
+            visit(values, kJobs, [&sum](int v) { sum += uint64_t(v) + 1; });
+            corsac::do_not_optimize(sum);
+        });
+        bench->run("visitor x1000/std", []
+        {
+            static int values[kJobs];
+            uint64_t sum = 0;
+            static void (*volatile visit)(const int*, int, const std::function<void(int)>&) = &function_bench_visit_std;
+            visit(values, kJobs, [&sum](int v) { sum += uint64_t(v) + 1; });
+            corsac::do_not_optimize(sum);
+        });
+    });
+    return true;
+}
+
+#endif //CORSAC_FUNCTION_BENCH_H
@@ -0,0 +1,60 @@
+//
+// bench/hash_bench.h
+//
+// Created by Falldot on 18.10.2026.
+// Copyright (c) 2021 Corsac. All rights reserved.
+//
+#ifndef CORSAC_HASH_BENCH_H
+#define CORSAC_HASH_BENCH_H
+
+#include "Corsac/functional.h"
+
+#include <string.h>
+#include <functional>
+#include <string_view>
+
+bool hash_bench(corsac::Bench* bench)
+{
+    bench->add_group("hash", [](corsac::Bench* bench)
+    {
+        static char path[] = "Content/Characters/Knight/Animations/knight_attack_heavy_02.anim";
+        static char blob[64 * 1024];
+        for(size_t i = 0; i < sizeof(blob) - 1; ++i)
+            blob[i] = char('a' + (i * 7) % 26);
+
+        bench->run("path 64B/corsac", []
+        {
+            corsac::do_not_optimize(corsac::hash_bytes(path, strlen(path)));
+        });
+        bench->run("path 64B/std", []
+        {
+            corsac::do_not_optimize(std::hash<std::string_view>()(std::string_view(path)));
+        });
+        bench->run("path 64B fnv1", []
+        {
+            corsac::do_not_optimize(corsac::hash<const char*>()(path));
+        });
+        bench->run("blob 64KB/corsac", []
+        {
+            corsac::do_not_optimize(corsac::hash_bytes(blob, sizeof(blob)));
+        });
+        bench->run("blob 64KB/std", []
+        {
+            corsac::do_not_optimize(std::hash<std::string_view>()(std::string_view(blob, sizeof(blob))));
+        });
+        bench->run("blob 64KB fnv1", []
+        {
+            corsac::do_not_optimize(corsac::hash<const char*>()(blob));
+        });
+        bench->run("mixed_hash pointer x1000", []
+        {
+            size_t sum = 0;
+            for(size_t i = 0; i < 1000; ++i)
+                sum += corsac::mixed_hash<const char*>()(blob + i * 64);
+            corsac::do_not_optimize(sum);
+        });
+    });
+    return true;
+}
+
+#endif //CORSAC_HASH_BENCH_H
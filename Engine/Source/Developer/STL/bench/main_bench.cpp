@@ -0,0 +1,99 @@
+//
+// bench/main_bench.cpp
+//
+// Created by Falldot on 18.10.2026.
+// Copyright (c) 2021 Corsac. All rights reserved.
+//
+
+#include "Bench.h"
+
+#include <cstddef>
+#include <new>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Массивы выделяются через malloc с запасом под выравнивание; адрес исходного блока хранится
+// перед выданным указателем. allocator::deallocate освобождает любой блок через delete[],
+// поэтому обычные и выровненные выделения проходят через одну пару new[]/delete[].
+static void* AllocateArray(size_t size, size_t alignment, size_t alignmentOffset)
+{
+    if (alignment < alignof(std::max_align_t))
+        alignment = alignof(std::max_align_t);
+    alignmentOffset &= alignment - 1;
+
+    void* raw = malloc(size + alignment + alignmentOffset + sizeof(void*));
+    if (!raw)
+        throw std::bad_alloc();
+
+    // Как в allocate_memory: выровнен адрес result - alignmentOffset.
+    const uintptr_t base = ((uintptr_t)raw + sizeof(void*) + alignment - 1) & ~(uintptr_t)(alignment - 1);
+    uint8_t* result = (uint8_t*)(base + alignmentOffset);
+    memcpy(result - sizeof(void*), &raw, sizeof(void*));
+    return result;
+}
+
+void* operator new[](size_t size)
+{
+    return AllocateArray(size, 0, 0);
+}
+
+void operator delete[](void* p) noexcept
+{
+    if (p)
+    {
+        void* raw;
+        memcpy(&raw, (uint8_t*)p - sizeof(void*), sizeof(void*));
+        free(raw);
+    }
+}
+
+void operator delete[](void* p, size_t) noexcept
+{
+    operator delete[](p);
+}
+
+void* operator new[](size_t size, const char* name, int flags, unsigned debugFlags, const char* file, int line)
+{
+    return AllocateArray(size, 0, 0);
+}
+
+void* operator new[](size_t size, size_t alignment, size_t alignmentOffset, const char* pName, int flags, unsigned debugFlags, const char* file, int line)
+{
+    return AllocateArray(size, alignment, alignmentOffset);
+}
+
+#include "vector_bench.h"
+#include "tuple_vector_bench.h"
+#include "slot_map_bench.h"
+#include "entity_bench.h"
+#include "world_bench.h"
+#include "transform_hierarchy_bench.h"
+#include "algorithm_bench.h"
+#include "allocator_bench.h"
+#include "profiler_bench.h"
+#include "random_bench.h"
+#include "hash_bench.h"
+#include "function_bench.h"
+
+int main(int argc, char** argv)
+{
+    auto bench = new corsac::Bench("STL", corsac::Bench::parse_args(argc, argv));
+
+    bench->add_group("containers", [](corsac::Bench* bench) {
+        vector_bench(bench);
+        tuple_vector_bench(bench);
+        slot_map_bench(bench);
+        entity_bench(bench);
+        world_bench(bench);
+        transform_hierarchy_bench(bench);
+    });
+    algorithm_bench(bench);
+    allocator_bench(bench);
+    profiler_bench(bench);
+    random_bench(bench);
+    hash_bench(bench);
+    function_bench(bench);
+
+    return bench->finish();
+}
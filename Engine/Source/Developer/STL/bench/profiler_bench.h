@@ -0,0 +1,53 @@
+//
+// bench/profiler_bench.h
+//
+// Created by Falldot on 18.10.2026.
+// Copyright (c) 2021 Corsac. All rights reserved.
+//
+#ifndef CORSAC_PROFILER_BENCH_H
+#define CORSAC_PROFILER_BENCH_H
+
+#include "Corsac/profiler.h"
+
+bool profiler_bench(corsac::Bench* bench)
+{
+    bench->add_group("profiler", [](corsac::Bench* bench)
+    {
+        // Калибровка TSC выполняется при первом обращении и не должна попасть в замер.
+        corsac::chrono::tsc_clock::now();
+
+        bench->run("profiler_ticks", []
+        {
+            corsac::do_not_optimize(corsac::internal::profiler_ticks());
+        });
+        bench->run("steady_clock::now", []
+        {
+            corsac::do_not_optimize(corsac::chrono::steady_clock::now());
+        });
+        bench->run("tsc_clock::now", []
+        {
+            corsac::do_not_optimize(corsac::chrono::tsc_clock::now());
+        });
+        // Буфер очищается каждые 1000 зон, чтобы замер не упирался в переполнение.
+        bench->run("zone x1000", []
+        {
+            for(int i = 0; i < 1000; ++i)
+            {
+                CORSAC_PROFILE_SCOPE("zone");
+            }
+            corsac::profiler::get().clear();
+        });
+        bench->run("zone x1000 disabled", []
+        {
+            corsac::profiler::get().set_enabled(false);
+            for(int i = 0; i < 1000; ++i)
+            {
+                CORSAC_PROFILE_SCOPE("zone");
+            }
+            corsac::profiler::get().set_enabled(true);
+        });
+    });
+    return true;
+}
+
+#endif //CORSAC_PROFILER_BENCH_H
@@ -0,0 +1,185 @@
+//
+// bench/random_bench.h
+//
+// Created by Falldot on 18.10.2026.
+// Copyright (c) 2021 Corsac. All rights reserved.
+//
+#ifndef CORSAC_RANDOM_BENCH_H
+#define CORSAC_RANDOM_BENCH_H
+
+#include "Corsac/random.h"
+
+#include <random>
+
+bool random_bench(corsac::Bench* bench)
+{
+    static const int kCount = 1000;
+
+    bench->add_group("random", [](corsac::Bench* bench)
+    {
+        bench->run("uint64 x1000/corsac", []
+        {
+            static corsac::xoshiro256starstar rng;
+            uint64_t sum = 0;
+            for(int i = 0; i < kCount; ++i)
+                sum += rng();
+            corsac::do_not_optimize(sum);
+        });
+        bench->run("uint64 x1000/std", []
+        {
+            static std::mt19937_64 rng;
+            uint64_t sum = 0;
+            for(int i = 0; i < kCount; ++i)
+                sum += rng();
+            corsac::do_not_optimize(sum);
+        });
+        bench->run("uint32 x1000/corsac", []
+        {
+            static corsac::pcg32 rng;
+            uint32_t sum = 0;
+            for(int i = 0; i < kCount; ++i)
+                sum += rng();
+            corsac::do_not_optimize(sum);
+        });
+        bench->run("uint32 x1000/std", []
+        {
+            static std::mt19937 rng;
+            uint32_t sum = 0;
+            for(int i = 0; i < kCount; ++i)
+                sum += rng();
+            corsac::do_not_optimize(sum);
+        });
+        bench->run("splitmix64 x1000", []
+        {
+            static corsac::splitmix64 rng;
+            uint64_t sum = 0;
+            for(int i = 0; i < kCount; ++i)
+                sum += rng();
+            corsac::do_not_optimize(sum);
+        });
+        bench->run("uniform_int [0, 99] x1000/corsac", []
+        {
+            static corsac::xoshiro256starstar rng;
+            corsac::uniform_int_distribution<uint32_t> dist(0, 99);
+            uint32_t sum = 0;
+            for(int i = 0; i < kCount; ++i)
+                sum += dist(rng);
+            corsac::do_not_optimize(sum);
+        });
+        bench->run("uniform_int [0, 99] x1000/std", []
+        {
+            static std::mt19937 rng;
+            std::uniform_int_distribution<uint32_t> dist(0, 99);
+            uint32_t sum = 0;
+            for(int i = 0; i < kCount; ++i)
+                sum += dist(rng);
+            corsac::do_not_optimize(sum);
+        });
+        bench->run("uniform float x4096/corsac", []
+        {
+            static corsac::xoshiro256starstar_x4 rng;
+            static float values[4096];
+            rng.generate_canonical(values, values + 4096);
+            corsac::do_not_optimize(values);
+        });
+        bench->run("uniform float x4096/std", []
+        {
+            static std::mt19937 rng;
+            static float values[4096];
+            std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+            for(float& v : values)
+                v = dist(rng);
+            corsac::do_not_optimize(values);
+        });
+        bench->run("uniform float x4096 scalar", []
+        {
+            static corsac::xoshiro256starstar rng;
+            static float values[4096];
+            for(float& v : values)
+                v = corsac::generate_canonical<float>(rng);
+            corsac::do_not_optimize(values);
+        });
+        bench->run("uint64 x4096 bulk/corsac", []
+        {
+            static corsac::xoshiro256starstar_x4 rng;
+            static uint64_t values[4096];
+            rng.generate(values, values + 4096);
+            corsac::do_not_optimize(values);
+        });
+        bench->run("uint64 x4096 bulk/std", []
+        {
+            static std::mt19937_64 rng;
+            static uint64_t values[4096];
+            for(uint64_t& v : values)
+                v = rng();
+            corsac::do_not_optimize(values);
+        });
+        bench->run("uniform_int [0, 99] x4096 bulk/corsac", []
+        {
+            static corsac::xoshiro256starstar rng;
+            static uint32_t values[4096];
+            corsac::uniform_int_distribution<uint32_t> dist(0, 99);
+            corsac::generate(values, values + 4096, rng, dist);
+            corsac::do_not_optimize(values);
+        });
+        bench->run("uniform_int [0, 99] x4096 bulk/std", []
+        {
+            static std::mt19937 rng;
+            static uint32_t values[4096];
+            std::uniform_int_distribution<uint32_t> dist(0, 99);
+            for(uint32_t& v : values)
+                v = dist(rng);
+            corsac::do_not_optimize(values);
+        });
+        bench->run("normal x4096/corsac", []
+        {
+            static corsac::xoshiro256starstar rng;
+            static double values[4096];
+            corsac::normal_distribution<double> dist;
+            corsac::generate(values, values + 4096, rng, dist);
+            corsac::do_not_optimize(values);
+        });
+        bench->run("normal x4096/std", []
+        {
+            static std::mt19937_64 rng;
+            static double values[4096];
+            std::normal_distribution<double> dist;
+            for(double& v : values)
+                v = dist(rng);
+            corsac::do_not_optimize(values);
+        });
+        bench->run("discrete 1000 weights x4096/corsac", []
+        {
+            static corsac::xoshiro256starstar rng;
+            static uint32_t values[4096];
+            static const corsac::discrete_distribution<uint32_t> table = []
+            {
+                double weights[1000];
+                for(int i = 0; i < 1000; ++i)
+                    weights[i] = 1.0 + (i % 17);
+                return corsac::discrete_distribution<uint32_t>(weights, weights + 1000);
+            }();
+            corsac::discrete_distribution<uint32_t> dist = table;
+            corsac::generate(values, values + 4096, rng, dist);
+            corsac::do_not_optimize(values);
+        });
+        bench->run("discrete 1000 weights x4096/std", []
+        {
+            static std::mt19937_64 rng;
+            static uint32_t values[4096];
+            static std::discrete_distribution<uint32_t> dist = []
+            {
+                double weights[1000];
+                for(int i = 0; i < 1000; ++i)
+                    weights[i] = 1.0 + (i % 17);
+                return std::discrete_distribution<uint32_t>(weights, weights + 1000);
+            }();
+            for(uint32_t& v : values)
+                v = dist(rng);
+            corsac::do_not_optimize(values);
+        });
+    });
+    return true;
+}
+
+#endif //CORSAC_RANDOM_BENCH_H
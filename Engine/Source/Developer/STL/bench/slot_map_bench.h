@@ -0,0 +1,98 @@
+//
+// bench/slot_map_bench.h
+//
+// Created by Falldot on 18.10.2026.
+// Copyright (c) 2021 Corsac. All rights reserved.
+//
+#ifndef CORSAC_SLOT_MAP_BENCH_H
+#define CORSAC_SLOT_MAP_BENCH_H
+
+#include "Corsac/slot_map.h"
+
+#include <unordered_map>
+#include <vector>
+
+bool slot_map_bench(corsac::Bench* bench)
+{
+    static const int kCount = 10000;
+
+    struct Body { float position[3]; float velocity[3]; };
+
+    // Эквивалент в стандартной библиотеке - unordered_map от монотонного идентификатора.
+    bench->add_group("slot_map", [](corsac::Bench* bench)
+    {
+        static corsac::slot_map<Body>                   corsacBodies;
+        static std::vector<corsac::slot_map_key>        corsacKeys;
+        static std::unordered_map<uint64_t, Body>       stdBodies;
+        static std::vector<uint64_t>                    stdKeys;
+        if(corsacBodies.empty())
+        {
+            for(int i = 0; i < kCount; ++i)
+            {
+                corsacKeys.push_back(corsacBodies.insert(Body{ { 0.0f, 0.0f, 0.0f }, { 1.0f, 2.0f, 3.0f } }));
+                stdBodies.emplace((uint64_t)i, Body{ { 0.0f, 0.0f, 0.0f }, { 1.0f, 2.0f, 3.0f } });
+                stdKeys.push_back((uint64_t)i);
+            }
+            // Перемешивание через удаление и вставку, как после нескольких кадров игры.
+            for(int i = 0; i < kCount; i += 3)
+            {
+                corsacBodies.erase(corsacKeys[i]);
+                corsacKeys[i] = corsacBodies.insert(Body{ { 0.0f, 0.0f, 0.0f }, { 1.0f, 2.0f, 3.0f } });
+                stdBodies.erase(stdKeys[i]);
+                stdKeys[i] = (uint64_t)(kCount + i);
+                stdBodies.emplace(stdKeys[i], Body{ { 0.0f, 0.0f, 0.0f }, { 1.0f, 2.0f, 3.0f } });
+            }
+        }
+
+        bench->run("lookup/corsac", []
+        {
+            float sum = 0.0f;
+            for(const corsac::slot_map_key& key : corsacKeys)
+                sum += corsacBodies[key].velocity[0];
+            corsac::do_not_optimize(sum);
+        });
+        bench->run("lookup/std", []
+        {
+            float sum = 0.0f;
+            for(uint64_t key : stdKeys)
+                sum += stdBodies.find(key)->second.velocity[0];
+            corsac::do_not_optimize(sum);
+        });
+
+        bench->run("iterate/corsac", []
+        {
+            for(Body& body : corsacBodies)
+                body.position[0] += body.velocity[0] * 0.016f;
+            corsac::clobber_memory();
+        });
+        bench->run("iterate/std", []
+        {
+            for(auto& entry : stdBodies)
+                entry.second.position[0] += entry.second.velocity[0] * 0.016f;
+            corsac::clobber_memory();
+        });
+
+        bench->run("insert erase/corsac", []
+        {
+            corsac::slot_map<Body> bodies;
+            static corsac::slot_map_key keys[kCount];
+            for(int i = 0; i < kCount; ++i)
+                keys[i] = bodies.insert(Body{});
+            for(int i = 0; i < kCount; ++i)
+                bodies.erase(keys[i]);
+            corsac::do_not_optimize(bodies.size());
+        });
+        bench->run("insert erase/std", []
+        {
+            std::unordered_map<uint64_t, Body> bodies;
+            for(int i = 0; i < kCount; ++i)
+                bodies.emplace((uint64_t)i, Body{});
+            for(int i = 0; i < kCount; ++i)
+                bodies.erase((uint64_t)i);
+            corsac::do_not_optimize(bodies.size());
+        });
+    });
+    return true;
+}
+
+#endif //CORSAC_SLOT_MAP_BENCH_H
@@ -0,0 +1,115 @@
+//
+// bench/transform_hierarchy_bench.h
+//
+// Created by Falldot on 18.10.2026.
+// Copyright (c) 2021 Corsac. All rights reserved.
+//
+#ifndef CORSAC_TRANSFORM_HIERARCHY_BENCH_H
+#define CORSAC_TRANSFORM_HIERARCHY_BENCH_H
+
+#include "Corsac/transform_hierarchy.h"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+// Эквивалент в стандартной библиотеке - граф сцены на указателях с рекурсивным обходом.
+struct transform_hierarchy_bench_node
+{
+    corsac::transform_matrix                     local;
+    corsac::transform_matrix                     world;
+    bool                                         dirty;
+    std::vector<transform_hierarchy_bench_node*> children;
+};
+
+inline void transform_hierarchy_bench_update(transform_hierarchy_bench_node* n, const corsac::transform_matrix& parent, bool dirty)
+{
+    dirty = dirty || n->dirty;
+    if(dirty)
+        n->world = parent * n->local;
+    n->dirty = false;
+    for(transform_hierarchy_bench_node* child : n->children)
+        transform_hierarchy_bench_update(child, n->world, dirty);
+}
+
+bool transform_hierarchy_bench(corsac::Bench* bench)
+{
+    static const uint32_t kCount = 65536;
+
+    bench->add_group("transform_hierarchy", [](corsac::Bench* bench)
+    {
+        // Одно и то же случайное дерево: 64 корня, у каждого следующего узла родитель - один из ранее созданных.
+        static corsac::transform_hierarchy                                  corsacTree;
+        static std::vector<corsac::slot_map_key>                            corsacNodes;
+        static std::vector<std::unique_ptr<transform_hierarchy_bench_node>> stdStorage;
+        static std::vector<transform_hierarchy_bench_node*>                 stdNodes;
+        static std::vector<transform_hierarchy_bench_node*>                 stdRoots;
+        if(corsacNodes.empty())
+        {
+            std::vector<uint32_t> parents(kCount);
+            uint32_t state = 4242;
+            for(uint32_t i = 0; i < kCount; ++i)
+            {
+                state = state * 1664525u + 1013904223u;
+                parents[i] = (i < 64) ? corsac::transform_hierarchy::npos : (state >> 8) % i;
+            }
+
+            const corsac::transform_matrix local = corsac::transform_matrix::translation(0.1f, 0.2f, 0.3f);
+            for(uint32_t i = 0; i < kCount; ++i)
+                corsacNodes.push_back(corsacTree.create(local, (parents[i] == corsac::transform_hierarchy::npos) ? corsac::slot_map_key() : corsacNodes[parents[i]]));
+            corsacTree.update();
+
+            // Узлы выделяются вперемешку, как после долгой жизни сцены.
+            std::vector<uint32_t> order(kCount);
+            for(uint32_t i = 0; i < kCount; ++i)
+                order[i] = i;
+            std::shuffle(order.begin(), order.end(), std::minstd_rand(7));
+            stdNodes.resize(kCount);
+            for(uint32_t i : order)
+            {
+                stdStorage.emplace_back(new transform_hierarchy_bench_node{ local, local, true, {} });
+                stdNodes[i] = stdStorage.back().get();
+            }
+            for(uint32_t i = 0; i < kCount; ++i)
+            {
+                if(parents[i] == corsac::transform_hierarchy::npos)
+                    stdRoots.push_back(stdNodes[i]);
+                else
+                    stdNodes[parents[i]]->children.push_back(stdNodes[i]);
+            }
+        }
+
+        // За кадр двигается 1% узлов, пересчитываются они и их потомки.
+        bench->run("update 1% moved/corsac", []
+        {
+            static uint32_t state = 1;
+            for(uint32_t i = 0; i < kCount / 100; ++i)
+            {
+                state = state * 1664525u + 1013904223u;
+                corsacTree.set_local(corsacNodes[(state >> 8) % kCount], corsac::transform_matrix::translation((float)i, 0.0f, 0.0f));
+            }
+            corsacTree.update();
+            corsac::do_not_optimize(corsacTree.world_data());
+            corsac::clobber_memory();
+        });
+        bench->run("update 1% moved/std", []
+        {
+            static uint32_t state = 1;
+            for(uint32_t i = 0; i < kCount / 100; ++i)
+            {
+                state = state * 1664525u + 1013904223u;
+                transform_hierarchy_bench_node* n = stdNodes[(state >> 8) % kCount];
+                n->local = corsac::transform_matrix::translation((float)i, 0.0f, 0.0f);
+                n->dirty = true;
+            }
+            for(transform_hierarchy_bench_node* root : stdRoots)
+                transform_hierarchy_bench_update(root, corsac::transform_matrix::identity(), false);
+            corsac::do_not_optimize(stdRoots.data());
+            corsac::clobber_memory();
+        });
+    });
+    return true;
+}
+
+#endif //CORSAC_TRANSFORM_HIERARCHY_BENCH_H
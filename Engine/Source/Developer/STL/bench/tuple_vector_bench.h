@@ -0,0 +1,204 @@
+//
+// bench/tuple_vector_bench.h
+//
+// Created by Falldot on 18.10.2026.
+// Copyright (c) 2021 Corsac. All rights reserved.
+//
+#ifndef CORSAC_TUPLE_VECTOR_BENCH_H
+#define CORSAC_TUPLE_VECTOR_BENCH_H
+
+#include "Corsac/tuple_vector.h"
+#include "Corsac/tiled_tuple_vector.h"
+
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+bool tuple_vector_bench(corsac::Bench* bench)
+{
+    static const int kCount = 10000;
+
+    // Эквивалент tuple_vector в стандартной библиотеке - вектор кортежей (AoS).
+    struct Particle { float position; float velocity; int id; double payload; };
+
+    bench->add_group("tuple_vector", [](corsac::Bench* bench)
+    {
+        bench->run("push_back/corsac", []
+        {
+            corsac::tuple_vector<float, float, int, double> v;
+            for(int i = 0; i < kCount; ++i)
+                v.push_back(0.0f, 1.0f, i, 0.0);
+            corsac::do_not_optimize(v.get<0>());
+        });
+        bench->run("push_back/std", []
+        {
+            std::vector<std::tuple<float, float, int, double>> v;
+            for(int i = 0; i < kCount; ++i)
+                v.emplace_back(0.0f, 1.0f, i, 0.0);
+            corsac::do_not_optimize(v.data());
+        });
+
+        static corsac::tuple_vector<float, float, int, double> corsacParticles;
+        static std::vector<Particle>                             stdParticles;
+        if(corsacParticles.empty())
+        {
+            for(int i = 0; i < kCount; ++i)
+            {
+                corsacParticles.push_back(0.0f, 1.0f, i, 0.0);
+                stdParticles.push_back({ 0.0f, 1.0f, i, 0.0 });
+            }
+        }
+
+        // Интегрирование трогает две колонки из четырех: здесь SoA должен выигрывать у AoS.
+        bench->run("integrate/corsac", []
+        {
+            float*       position = corsacParticles.get<0>();
+            const float* velocity = corsacParticles.get<1>();
+            for(size_t i = 0, n = corsacParticles.size(); i < n; ++i)
+                position[i] += velocity[i] * 0.016f;
+            corsac::clobber_memory();
+        });
+        bench->run("integrate/std", []
+        {
+            for(Particle& p : stdParticles)
+                p.position += p.velocity * 0.016f;
+            corsac::clobber_memory();
+        });
+
+        bench->run("erase_unsorted/corsac", []
+        {
+            corsac::tuple_vector<float, float, int, double> v(corsacParticles);
+            while(!v.empty())
+                v.erase_unsorted(v.begin());
+            corsac::do_not_optimize(v.size());
+        });
+        bench->run("erase_unsorted/std", []
+        {
+            std::vector<Particle> v(stdParticles);
+            while(!v.empty())
+            {
+                v.front() = v.back();
+                v.pop_back();
+            }
+            corsac::do_not_optimize(v.size());
+        });
+    });
+
+    // Сортировка элементов отрисовки по ключу материала. Без sort_by приходилось копировать
+    // строки в кортежи, сортировать и копировать обратно - это и есть вариант std.
+    bench->add_group("tuple_vector sort_by", [](corsac::Bench* bench)
+    {
+        struct draw_transform { float m[16]; };
+        using draw_items = corsac::tuple_vector<uint64_t, uint32_t, float, draw_transform>; // Материал, меш, глубина, матрица.
+
+        static draw_items unsorted;
+        if(unsorted.empty())
+        {
+            uint64_t state = 1;
+            for(int i = 0; i < kCount; ++i)
+            {
+                state = state * 6364136223846793005ull + 1442695040888963407ull;
+                unsorted.push_back((state >> 40) % 64, (uint32_t)i, (float)(state >> 56), draw_transform{ { (float)i } });
+            }
+        }
+
+        bench->run("sort by material/corsac", []
+        {
+            draw_items items(unsorted);
+            items.sort_by<0>();
+            corsac::do_not_optimize(items.get<1>());
+        });
+        bench->run("sort by material/std", []
+        {
+            draw_items items(unsorted);
+            std::vector<std::tuple<uint64_t, uint32_t, float, draw_transform>> rows;
+            rows.reserve(items.size());
+            for(size_t i = 0, n = items.size(); i < n; ++i)
+                rows.emplace_back(items.get<0>()[i], items.get<1>()[i], items.get<2>()[i], items.get<3>()[i]);
+            std::stable_sort(rows.begin(), rows.end(), [](const auto& a, const auto& b) { return std::get<0>(a) < std::get<0>(b); });
+            for(size_t i = 0, n = rows.size(); i < n; ++i)
+            {
+                items.get<0>()[i] = std::get<0>(rows[i]);
+                items.get<1>()[i] = std::get<1>(rows[i]);
+                items.get<2>()[i] = std::get<2>(rows[i]);
+                items.get<3>()[i] = std::get<3>(rows[i]);
+            }
+            corsac::do_not_optimize(items.get<1>());
+        });
+    });
+
+    // Ядро трогает шесть колонок сразу: в SoA это шесть удаленных потоков, в AoSoA - одна плитка.
+    bench->add_group("tiled_tuple_vector", [](corsac::Bench* bench)
+    {
+        using soa   = corsac::tuple_vector<float, float, float, float, float, float, int>;
+        using aosoa = corsac::tiled_tuple_vector<8, float, float, float, float, float, float, int>;
+
+        static soa   soaBodies;
+        static aosoa aosoaBodies;
+        if(soaBodies.empty())
+        {
+            for(int i = 0; i < kCount; ++i)
+            {
+                soaBodies.push_back(0.0f, 0.0f, 0.0f, 1.0f, 2.0f, 3.0f, i);
+                aosoaBodies.push_back(0.0f, 0.0f, 0.0f, 1.0f, 2.0f, 3.0f, i);
+            }
+        }
+
+        bench->run("integrate_xyz/tuple_vector", []
+        {
+            float* x = soaBodies.get<0>();
+            float* y = soaBodies.get<1>();
+            float* z = soaBodies.get<2>();
+            const float* vx = soaBodies.get<3>();
+            const float* vy = soaBodies.get<4>();
+            const float* vz = soaBodies.get<5>();
+            for(size_t i = 0, n = soaBodies.size(); i < n; ++i)
+            {
+                x[i] += vx[i] * 0.016f;
+                y[i] += vy[i] * 0.016f;
+                z[i] += vz[i] * 0.016f;
+            }
+            corsac::clobber_memory();
+        });
+        bench->run("integrate_xyz/tuple_vector span", []
+        {
+            float* x = soaBodies.get_span<0>().aligned_data();
+            float* y = soaBodies.get_span<1>().aligned_data();
+            float* z = soaBodies.get_span<2>().aligned_data();
+            const float* vx = soaBodies.get_span<3>().aligned_data();
+            const float* vy = soaBodies.get_span<4>().aligned_data();
+            const float* vz = soaBodies.get_span<5>().aligned_data();
+            for(size_t i = 0, n = soaBodies.size(); i < n; ++i)
+            {
+                x[i] += vx[i] * 0.016f;
+                y[i] += vy[i] * 0.016f;
+                z[i] += vz[i] * 0.016f;
+            }
+            corsac::clobber_memory();
+        });
+        bench->run("integrate_xyz/tiled", []
+        {
+            aosoaBodies.each_tile([](size_t count, float* x, float* y, float* z, float* vx, float* vy, float* vz, int*)
+            {
+                for(size_t i = 0; i < count; ++i)
+                {
+                    x[i] += vx[i] * 0.016f;
+                    y[i] += vy[i] * 0.016f;
+                    z[i] += vz[i] * 0.016f;
+                }
+            });
+            corsac::clobber_memory();
+        });
+
+        bench->run("push_back/tiled", []
+        {
+            aosoa v;
+            for(int i = 0; i < kCount; ++i)
+                v.push_back(0.0f, 0.0f, 0.0f, 1.0f, 2.0f, 3.0f, i);
+            corsac::do_not_optimize(v.tile<0>(0));
+        });
+    });
+    return true;
+}
+
+#endif //CORSAC_TUPLE_VECTOR_BENCH_H
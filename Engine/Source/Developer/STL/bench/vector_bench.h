@@ -0,0 +1,130 @@
+//
+// bench/vector_bench.h
+//
+// Created by Falldot on 18.10.2026.
+// Copyright (c) 2021 Corsac. All rights reserved.
+//
+#ifndef CORSAC_VECTOR_BENCH_H
+#define CORSAC_VECTOR_BENCH_H
+
+#include "Corsac/vector.h"
+#include "Corsac/fixed_vector.h"
+
+#include <vector>
+
+bool vector_bench(corsac::Bench* bench)
+{
+    static const int kCount = 10000;
+
+    bench->add_group("vector", [](corsac::Bench* bench)
+    {
+        bench->run("push_back/corsac", []
+        {
+            corsac::vector<int> v;
+            for(int i = 0; i < kCount; ++i)
+                v.push_back(i);
+            corsac::do_not_optimize(v.data());
+        });
+        bench->run("push_back/std", []
+        {
+            std::vector<int> v;
+            for(int i = 0; i < kCount; ++i)
+                v.push_back(i);
+            corsac::do_not_optimize(v.data());
+        });
+
+        bench->run("reserve push_back/corsac", []
+        {
+            corsac::vector<int> v;
+            v.reserve(kCount);
+            for(int i = 0; i < kCount; ++i)
+                v.push_back(i);
+            corsac::do_not_optimize(v.data());
+        });
+        bench->run("reserve push_back/std", []
+        {
+            std::vector<int> v;
+            v.reserve(kCount);
+            for(int i = 0; i < kCount; ++i)
+                v.push_back(i);
+            corsac::do_not_optimize(v.data());
+        });
+
+        static corsac::vector<int> corsacSource((size_t)kCount, 1);
+        static std::vector<int>    stdSource((size_t)kCount, 1);
+
+        bench->run("copy construct/corsac", []
+        {
+            corsac::vector<int> v(corsacSource);
+            corsac::do_not_optimize(v.data());
+        });
+        bench->run("copy construct/std", []
+        {
+            std::vector<int> v(stdSource);
+            corsac::do_not_optimize(v.data());
+        });
+
+        bench->run("fill construct/corsac", []
+        {
+            corsac::vector<float> v((size_t)kCount, 1.5f);
+            corsac::do_not_optimize(v.data());
+        });
+        bench->run("fill construct/std", []
+        {
+            std::vector<float> v((size_t)kCount, 1.5f);
+            corsac::do_not_optimize(v.data());
+        });
+
+        bench->run("iterate sum/corsac", []
+        {
+            int sum = 0;
+            for(int x : corsacSource)
+                sum += x;
+            corsac::do_not_optimize(sum);
+        });
+        bench->run("iterate sum/std", []
+        {
+            int sum = 0;
+            for(int x : stdSource)
+                sum += x;
+            corsac::do_not_optimize(sum);
+        });
+
+        bench->run("insert front/corsac", []
+        {
+            corsac::vector<int> v;
+            for(int i = 0; i < 1000; ++i)
+                v.insert(v.begin(), i);
+            corsac::do_not_optimize(v.data());
+        });
+        bench->run("insert front/std", []
+        {
+            std::vector<int> v;
+            for(int i = 0; i < 1000; ++i)
+                v.insert(v.begin(), i);
+            corsac::do_not_optimize(v.data());
+        });
+    });
+
+    bench->add_group("fixed_vector", [](corsac::Bench* bench)
+    {
+        bench->run("push_back 256/corsac", []
+        {
+            corsac::fixed_vector<int, 256, false> v;
+            for(int i = 0; i < 256; ++i)
+                v.push_back(i);
+            corsac::do_not_optimize(v.data());
+        });
+        bench->run("push_back 256/std", []
+        {
+            std::vector<int> v;
+            v.reserve(256);
+            for(int i = 0; i < 256; ++i)
+                v.push_back(i);
+            corsac::do_not_optimize(v.data());
+        });
+    });
+    return true;
+}
+
+#endif //CORSAC_VECTOR_BENCH_H
@@ -0,0 +1,242 @@
+//
+// bench/world_bench.h
+//
+// Created by Falldot on 18.10.2026.
+// Copyright (c) 2021 Corsac. All rights reserved.
+//
+#ifndef CORSAC_WORLD_BENCH_H
+#define CORSAC_WORLD_BENCH_H
+
+#include "Corsac/world.h"
+#include "Corsac/query.h"
+
+#include <utility>
+#include <vector>
+
+struct world_bench_position { float x, y, z; };
+struct world_bench_rotation { float q[4]; };
+struct world_bench_scale { float s[3]; };
+struct world_bench_transform { float m[16]; };
+struct world_bench_render { uint32_t mesh, material; };
+struct world_bench_velocity { float x, y, z; };
+struct world_bench_health { float value; };
+
+template <int N> struct world_bench_tag { uint8_t value; };
+
+template <int... N>
+inline void world_bench_add_tags(corsac::world& w, corsac::entity e, uint32_t bits, std::integer_sequence<int, N...>)
+{
+    ((bits & (1u << N) ? (void)w.add<world_bench_tag<N>>(e) : (void)0), ...);
+}
+
+bool world_bench(corsac::Bench* bench)
+{
+    static const int kCount = 4096;
+
+    // Сущности сцены с пятью компонентами, каждой добавляются и снимаются два компонента.
+    // Сразу - четыре переезда всех колонок на сущность, через command_buffer - два пакетных
+    // применения по колонкам.
+    bench->add_group("world command_buffer", [](corsac::Bench* bench)
+    {
+        static corsac::world          w;
+        static corsac::entity         entities[kCount];
+        static corsac::command_buffer commands;
+        if(w.size() == 0)
+        {
+            for(int i = 0; i < kCount; ++i)
+                entities[i] = w.spawn(world_bench_position{ (float)i, 0.0f, 0.0f }, world_bench_rotation{}, world_bench_scale{},
+                                      world_bench_transform{}, world_bench_render{});
+        }
+
+        bench->run("add remove two components/immediate", []
+        {
+            for(const corsac::entity& e : entities)
+            {
+                w.add<world_bench_velocity>(e, world_bench_velocity{ 1.0f, 0.0f, 0.0f });
+                w.add<world_bench_health>(e, world_bench_health{ 100.0f });
+            }
+            for(const corsac::entity& e : entities)
+            {
+                w.remove<world_bench_velocity>(e);
+                w.remove<world_bench_health>(e);
+            }
+            corsac::clobber_memory();
+        });
+        bench->run("add remove two components/command_buffer", []
+        {
+            for(const corsac::entity& e : entities)
+            {
+                commands.add<world_bench_velocity>(e, world_bench_velocity{ 1.0f, 0.0f, 0.0f });
+                commands.add<world_bench_health>(e, world_bench_health{ 100.0f });
+            }
+            w.apply(commands);
+            for(const corsac::entity& e : entities)
+            {
+                commands.remove<world_bench_velocity>(e);
+                commands.remove<world_bench_health>(e);
+            }
+            w.apply(commands);
+            corsac::clobber_memory();
+        });
+    });
+
+    // 256 архетипов: Position и Velocity плюс любое подмножество из 8 меток, по 16 сущностей в каждом.
+    // Запрос без кэша сверяет сигнатуры и ищет колонки всех архетипов на каждом обходе.
+    bench->add_group("world query", [](corsac::Bench* bench)
+    {
+        static corsac::world w;
+        if(w.size() == 0)
+        {
+            for(uint32_t bits = 0; bits < 256; ++bits)
+            {
+                for(int i = 0; i < 16; ++i)
+                {
+                    const corsac::entity e = w.spawn(world_bench_position{ (float)i, 0.0f, 0.0f }, world_bench_velocity{ 1.0f, 0.0f, 0.0f });
+                    world_bench_add_tags(w, e, bits, std::make_integer_sequence<int, 8>());
+                }
+            }
+        }
+
+        bench->run("integrate sparse/cached query", []
+        {
+            static corsac::query<world_bench_position, const world_bench_velocity, const world_bench_tag<7>, const world_bench_tag<6>> q(w);
+            q.each_chunk([](uint32_t count, world_bench_position* p, const world_bench_velocity* v, const world_bench_tag<7>*, const world_bench_tag<6>*)
+            {
+                for(uint32_t i = 0; i < count; ++i)
+                    p[i].x += v[i].x * 0.016f;
+            });
+            corsac::clobber_memory();
+        });
+        bench->run("integrate sparse/rematch", []
+        {
+            const corsac::component_mask required = corsac::component_mask::of<world_bench_position, world_bench_velocity,
+                                                                               world_bench_tag<7>, world_bench_tag<6>>();
+            for(uint32_t a = 0; a < w.archetype_count(); ++a)
+            {
+                corsac::archetype& arch = w.archetype_at(a);
+                if(!arch.mask().contains(required))
+                    continue;
+                world_bench_position* p = arch.column_data_mut<world_bench_position>(w.change_tick());
+                const world_bench_velocity* v = arch.column_data<world_bench_velocity>();
+                for(uint32_t i = 0, count = arch.size(); i < count; ++i)
+                    p[i].x += v[i].x * 0.016f;
+            }
+            corsac::clobber_memory();
+        });
+    });
+
+    bench->add_group("world snapshot", [](corsac::Bench* bench)
+    {
+        // 64K сущностей сцены с пятью компонентами (~124 байта); за кадр меняется 1%.
+        static corsac::world          w;
+        static corsac::entity         entities[65536];
+        static corsac::world_snapshot base;
+        static corsac::world_snapshot frame;
+        if(w.size() == 0)
+        {
+            for(int i = 0; i < 65536; ++i)
+                entities[i] = w.spawn(world_bench_position{ (float)i, 0.0f, 0.0f }, world_bench_rotation{}, world_bench_scale{},
+                                      world_bench_transform{}, world_bench_render{});
+        }
+        auto touch = []
+        {
+            static uint32_t state = 777;
+            for(uint32_t i = 0; i < 655; ++i)
+            {
+                state = state * 1664525u + 1013904223u;
+                w.get<world_bench_position>(entities[state >> 16])->x += 1.0f;
+            }
+        };
+
+        bench->run("snapshot 64K entities/full", [touch]
+        {
+            touch();
+            w.snapshot(frame);
+            corsac::do_not_optimize(frame.size_bytes());
+        });
+        bench->run("snapshot 64K entities/delta", [touch]
+        {
+            // Полный снимок - раз в окно отката из 8 кадров.
+            static uint32_t n = 0;
+            touch();
+            if(n++ % 8 == 0)
+                w.snapshot(base);
+            else
+                w.snapshot(frame, &base);
+            corsac::do_not_optimize(frame.size_bytes());
+        });
+        bench->run("snapshot 64K entities/per entity copy", [touch]
+        {
+            struct saved { corsac::entity e; world_bench_position p; world_bench_rotation r; world_bench_scale s; world_bench_transform t; world_bench_render m; };
+            static std::vector<saved> out;
+            touch();
+            out.clear();
+            for(const corsac::entity& e : entities)
+            {
+                const corsac::world& cw = w;
+                out.push_back(saved{ e, *cw.get<world_bench_position>(e), *cw.get<world_bench_rotation>(e), *cw.get<world_bench_scale>(e),
+                                     *cw.get<world_bench_transform>(e), *cw.get<world_bench_render>(e) });
+            }
+            corsac::do_not_optimize(out.data());
+        });
+        bench->run("restore 64K entities/full", []
+        {
+            if(base.empty())
+                w.snapshot(base);
+            w.restore(base);
+            corsac::clobber_memory();
+        });
+    });
+
+    bench->add_group("world change ticks", [](corsac::Bench* bench)
+    {
+        // 64K матриц, за кадр меняется 1% в разных местах: загрузка в буфер видеокарты только измененных.
+        static corsac::world w;
+        static corsac::vector<corsac::entity> entities;
+        static world_bench_transform staging[65536];
+        if(w.size() == 0)
+        {
+            for(uint32_t i = 0; i < 65536; ++i)
+                entities.push_back(w.spawn(world_bench_transform{ { (float)i } }));
+        }
+        auto touch = []
+        {
+            static uint32_t state = 12345;
+            for(uint32_t i = 0; i < 655; ++i)
+            {
+                state = state * 1664525u + 1013904223u;
+                w.get<world_bench_transform>(entities[state >> 16])->m[12] += 1.0f;
+            }
+        };
+
+        bench->run("upload 1% changed/changed filter", [touch]
+        {
+            static corsac::query<corsac::changed<const world_bench_transform>> q(w);
+            touch();
+            uint32_t n = 0;
+            q.each_chunk([&n](uint32_t count, const world_bench_transform* t)
+            {
+                memcpy(staging + n, t, count * sizeof(world_bench_transform));
+                n += count;
+            });
+            corsac::do_not_optimize(n);
+            corsac::clobber_memory();
+        });
+        bench->run("upload 1% changed/all rows", [touch]
+        {
+            static corsac::query<const world_bench_transform> q(w);
+            touch();
+            uint32_t n = 0;
+            q.each_chunk([&n](uint32_t count, const world_bench_transform* t)
+            {
+                memcpy(staging + n, t, count * sizeof(world_bench_transform));
+                n += count;
+            });
+            corsac::do_not_optimize(n);
+            corsac::clobber_memory();
+        });
+    });
+    return true;
+}
+
+#endif //CORSAC_WORLD_BENCH_H
@@ -219,6 +219,25 @@
     #define CORSAC_PACKED __packed
 #endif
 
+/**
+* CORSAC_TARGET
+*
+* Разрешает компилятору использовать для отдельной функции набор инструкций, который не включен
+* для всей единицы трансляции (например AVX без флага -mavx). Вызывать такую функцию можно только
+* после проверки поддержки инструкций процессором во время выполнения (см. Corsac/STL/cpu_info.h).
+* MSVC позволяет использовать интринсики без дополнительных флагов, поэтому там макрос пуст.
+*
+* Пример использования:
+*    CORSAC_TARGET("avx2") void transform_avx2(float* p, size_t n);
+*/
+#ifndef CORSAC_TARGET
+    #if defined(__GNUC__) || defined(__clang__)
+        #define CORSAC_TARGET(x) __attribute__((target(x)))
+    #else
+        #define CORSAC_TARGET(x)
+    #endif
+#endif
+
 /**
  * Unused
  *
@@ -0,0 +1,190 @@
+/**
+ * corsac::STL
+ *
+ * internal/cpu_info.h
+ *
+ * Created by Falldot on 18.10.2026.
+ * Copyright (c) 2021 Corsac. All rights reserved.
+ */
+#ifndef CORSAC_STL_CPU_INFO_H
+#define CORSAC_STL_CPU_INFO_H
+
+#pragma once
+
+#include "Corsac/STL/config.h"
+
+/**
+ * Описание (Falldot 18.10.2026)
+ *
+ * Определение возможностей процессора во время выполнения через CPUID.
+ * Используется внутренними помощниками (help_memcpy.h и др.) для однократного выбора
+ * реализации под конкретную машину. Результат вычисляется при первом обращении
+ * к get_cpu_info() и далее не меняется.
+ *
+ * CORSAC_SIMD_X86
+ *      Определяется как 1 на x86 / x86-64, где доступны интринсики SSE/AVX, иначе 0.
+ */
+#ifndef CORSAC_SIMD_X86
+    #if defined(CORSAC_PROCESSOR_X86) || defined(CORSAC_PROCESSOR_X86_64)
+        #define CORSAC_SIMD_X86 1
+    #else
+        #define CORSAC_SIMD_X86 0
+    #endif
+#endif
+
+/**
+* CORSAC_CPU_DEFAULT_LLC_SIZE
+*
+* Размер кеша последнего уровня в байтах, который используется, когда его не удалось узнать через CPUID.
+*/
+#ifndef CORSAC_CPU_DEFAULT_LLC_SIZE
+    #define CORSAC_CPU_DEFAULT_LLC_SIZE (8 * 1024 * 1024)
+#endif
+
+#if CORSAC_SIMD_X86
+    #if defined(CORSAC_COMPILER_MSVC)
+        #include <intrin.h>
+    #else
+        #include <cpuid.h>
+    #endif
+    #include <immintrin.h>
+#endif
+
+namespace corsac
+{
+    namespace internal
+    {
+        struct cpu_info
+        {
+            bool   sse2          = false;
+            bool   avx           = false; // AVX поддерживается процессором и сохранение YMM регистров включено ОС.
+            bool   avx2          = false;
+            bool   rdtscp        = false;
+            bool   invariant_tsc = false; // Частота TSC не зависит от P/C-состояний, TSC пригоден как часы.
+            size_t llc_size      = CORSAC_CPU_DEFAULT_LLC_SIZE; // Размер кеша последнего уровня в байтах.
+        };
+
+        #if CORSAC_SIMD_X86
+            inline void cpuid(uint32_t leaf, uint32_t subleaf, uint32_t regs[4]) noexcept
+            {
+                #if defined(CORSAC_COMPILER_MSVC)
+                    int r[4];
+                    __cpuidex(r, (int)leaf, (int)subleaf);
+                    for(int i = 0; i < 4; ++i)
+                        regs[i] = (uint32_t)r[i];
+                #else
+                    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+                #endif
+            }
+
+            inline uint64_t xgetbv0() noexcept
+            {
+                #if defined(CORSAC_COMPILER_MSVC)
+                    return _xgetbv(0);
+                #else
+                    uint32_t eax, edx;
+                    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+                    return ((uint64_t)edx << 32) | eax;
+                #endif
+            }
+
+            // Перебирает описатели кешей (leaf 4 у Intel, 0x8000001D у AMD) и возвращает размер самого старшего уровня.
+            inline size_t detect_llc_size(uint32_t leaf) noexcept
+            {
+                size_t   result    = 0;
+                uint32_t bestLevel = 0;
+                uint32_t r[4];
+
+                for(uint32_t i = 0; i < 16; ++i)
+                {
+                    cpuid(leaf, i, r);
+                    const uint32_t type = r[0] & 0x1F;
+                    if(type == 0)
+                        break;
+                    if(type == 2) // Кеш инструкций.
+                        continue;
+
+                    const uint32_t level      = (r[0] >> 5) & 0x7;
+                    const size_t   ways       = ((r[1] >> 22) & 0x3FF) + 1;
+                    const size_t   partitions = ((r[1] >> 12) & 0x3FF) + 1;
+                    const size_t   lineSize   = (r[1] & 0xFFF) + 1;
+                    const size_t   sets       = (size_t)r[2] + 1;
+
+                    if(level >= bestLevel)
+                    {
+                        bestLevel = level;
+                        result    = ways * partitions * lineSize * sets;
+                    }
+                }
+                return result;
+            }
+        #endif
+
+        inline cpu_info detect_cpu_info() noexcept
+        {
+            cpu_info info;
+
+            #if CORSAC_SIMD_X86
+                uint32_t r[4];
+                cpuid(0, 0, r);
+                const uint32_t maxLeaf = r[0];
+                const bool     isAMD   = (r[1] == 0x68747541); // "Auth" из "AuthenticAMD"
+
+                cpuid(0x80000000, 0, r);
+                const uint32_t maxExtLeaf = r[0];
+
+                if(maxLeaf >= 1)
+                {
+                    cpuid(1, 0, r);
+                    info.sse2 = (r[3] & (1u << 26)) != 0;
+
+                    const bool osxsave = (r[2] & (1u << 27)) != 0;
+                    const bool avxCpu  = (r[2] & (1u << 28)) != 0;
+                    // ОС должна сохранять XMM и YMM состояния (биты 1 и 2 XCR0), иначе AVX использовать нельзя.
+                    info.avx = osxsave && avxCpu && ((xgetbv0() & 0x6) == 0x6);
+                }
+
+                if(maxLeaf >= 7)
+                {
+                    cpuid(7, 0, r);
+                    info.avx2 = info.avx && ((r[1] & (1u << 5)) != 0);
+                }
+
+                if(maxExtLeaf >= 0x80000001)
+                {
+                    cpuid(0x80000001, 0, r);
+                    info.rdtscp = (r[3] & (1u << 27)) != 0;
+                }
+
+                if(maxExtLeaf >= 0x80000007)
+                {
+                    cpuid(0x80000007, 0, r);
+                    info.invariant_tsc = (r[3] & (1u << 8)) != 0;
+                }
+
+                size_t llc = 0;
+                if(isAMD && maxExtLeaf >= 0x8000001D)
+                    llc = detect_llc_size(0x8000001D);
+                else if(!isAMD && maxLeaf >= 4)
+                    llc = detect_llc_size(4);
+                if(llc != 0)
+                    info.llc_size = llc;
+            #endif
+
+            return info;
+        }
+
+        /**
+         * get_cpu_info
+         *
+         * Возвращает возможности текущего процессора. Определение выполняется один раз.
+         */
+        inline const cpu_info& get_cpu_info() noexcept
+        {
+            static const cpu_info info = detect_cpu_info();
+            return info;
+        }
+    } // namespace internal
+} // namespace corsac
+
+#endif //CORSAC_STL_CPU_INFO_H
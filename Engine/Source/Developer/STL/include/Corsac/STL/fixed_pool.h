@@ -174,6 +174,33 @@ namespace corsac
 
         }; // fixed_pool_base
 
+        inline void fixed_pool_base::init(void* pMemory, size_t memorySize, size_t nodeSize,
+                                          size_t alignment, size_t /*alignmentOffset*/)
+        {
+            #if CORSAC_FIXED_SIZE_TRACKING_ENABLED
+                mnCurrentSize = 0;
+                mnPeakSize    = 0;
+            #endif
+
+            if(pMemory)
+            {
+                // Выравнивание должно быть степенью двойки (1, 2, 4, 8, 16 и т.д.).
+                CORSAC_ASSERT((alignment & (alignment - 1)) == 0);
+                if(alignment < 1)
+                    alignment = 1;
+
+                mnNodeSize = (nodeSize > sizeof(Link)) ? nodeSize : sizeof(Link);
+                mnNodeSize = (mnNodeSize + alignment - 1) & ~(alignment - 1);
+
+                mpHead      = (Link*)(((uintptr_t)pMemory + alignment - 1) & ~(uintptr_t)(alignment - 1));
+                memorySize -= (uintptr_t)mpHead - (uintptr_t)pMemory;
+                memorySize  = (memorySize / mnNodeSize) * mnNodeSize; // allocate останавливается только на mpNext == mpCapacity.
+                mpNext      = mpHead;
+                mpCapacity  = (Link*)((uintptr_t)mpHead + memorySize);
+                mpHead      = NULL; // Свободных узлов в списке пока нет, все берутся из [mpNext, mpCapacity).
+            }
+        }
+
         /**
         * fixed_pool
         *
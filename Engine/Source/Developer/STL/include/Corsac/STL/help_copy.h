@@ -12,6 +12,7 @@
 #pragma once
 
 #include "Corsac/STL/config.h"
+#include "Corsac/STL/help_memcpy.h"
 
 #include "Corsac/type_traits.h"
 #include "Corsac/iterator.h"
@@ -178,8 +179,8 @@ namespace corsac
         {
             if (CORSAC_UNLIKELY(first == last))
                 return result;
-            // Мы могли бы использовать memcpy здесь, если нет перекрытия диапазонов, но memcpy редко бывает намного быстрее, чем memmove.
-            return (T*)memmove(result, first, (size_t)((uintptr_t)last - (uintptr_t)first)) + (last - first);
+            // fast_memmove сам выбирает копирование по размеру и переходит к memmove только при перекрытии диапазонов.
+            return (T*)corsac::internal::fast_memmove(result, first, (size_t)((uintptr_t)last - (uintptr_t)first)) + (last - first);
         }
     };
 
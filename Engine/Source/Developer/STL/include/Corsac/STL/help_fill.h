@@ -12,10 +12,9 @@
 #pragma once
 
 #include "Corsac/STL/config.h"
-
-#if defined(CORSAC_COMPILER_MICROSOFT) && (defined(CORSAC_PROCESSOR_X86) || defined(CORSAC_PROCESSOR_X86_64))
-    #include <intrin.h>
-#endif
+#include "Corsac/STL/help_memset.h"
+#include "Corsac/type_traits.h"
+#include "Corsac/iterator.h"
 
 namespace corsac
 {
@@ -55,6 +54,29 @@ namespace corsac
         }
     };
 
+    /**
+    * can_fill_pattern
+    *
+    * Определяет, можно ли заполнить диапазон через internal::fast_fill_pattern (help_memset.h):
+    * итератор является указателем на неконстантный тривиально копируемый тип размера 2, 4, 8 или 16 байт,
+    * а присваивание значения сводится к копированию байтов одного элемента. Однобайтовые типы
+    * обрабатываются перегрузками с memset ниже.
+    */
+    template <typename Iterator, typename T, typename = void>
+    struct can_fill_pattern : public corsac::false_type {};
+
+    template <typename Iterator, typename T>
+    struct can_fill_pattern<Iterator, T, corsac::enable_if_t<corsac::is_pointer_v<Iterator>>>
+    {
+        using value_type = corsac::remove_pointer_t<Iterator>;
+
+        static constexpr bool value = !corsac::is_const_v<value_type> && !corsac::is_volatile_v<value_type> &&
+                                      (sizeof(value_type) > 1) && internal::is_fill_pattern_size<sizeof(value_type)>::value &&
+                                      corsac::is_trivially_copyable<value_type>::value &&
+                                      (corsac::is_same_v<value_type, corsac::remove_cv_t<T>> ||
+                                       (corsac::is_arithmetic<value_type>::value && corsac::is_arithmetic<T>::value));
+    };
+
     /**
     * fill
     *
@@ -74,134 +96,19 @@ namespace corsac
     template <typename ForwardIterator, typename T>
     inline void fill(ForwardIterator first, ForwardIterator last, const T& value)
     {
-        corsac::fill_imp<corsac::is_scalar_v<T>>::do_fill(first, last, value);
-    }
-
-    #if (defined(CORSAC_COMPILER_GCC) || defined(CORSAC_COMPILER_CLANG)) && (defined(CORSAC_PROCESSOR_X86) || defined(CORSAC_PROCESSOR_X86_64))
-        #if defined(CORSAC_PROCESSOR_X86_64)
-			template <typename Value>
-			inline void fill(uint64_t* first, uint64_t* last, Value c)
-			{
-                uintptr_t count = static_cast<uintptr_t>(last - first);
-				uint64_t  value = static_cast<uint64_t>(c);
-
-				__asm__ __volatile__ ("cld\n\t"
-									  "rep stosq\n\t"
-									   : "+c" (count), "+D" (first), "=m" (first)
-									   : "a" (value)
-									   : "cc" );
-			}
-
-
-			template <typename Value>
-			inline void fill(int64_t* first, int64_t* last, Value c)
-			{
-                uintptr_t count = static_cast<uintptr_t>(last - first);
-				int64_t   value = static_cast<int64_t>(c);
+        using unwrapped_type = decltype(corsac::unwrap_generic_iterator(first));
 
-				__asm__ __volatile__ ("cld\n\t"
-									  "rep stosq\n\t"
-									   : "+c" (count), "+D" (first), "=m" (first)
-									   : "a" (value)
-									   : "cc" );
-			}
-		#endif
-
-        template <typename Value>
-        inline void fill(uint32_t* first, uint32_t* last, Value c)
+        if constexpr(corsac::can_fill_pattern<unwrapped_type, T>::value)
         {
-            uintptr_t count = static_cast<uintptr_t>(last - first);
-            uint32_t  value = static_cast<uint32_t>(c);
+            using value_type = typename corsac::iterator_traits<unwrapped_type>::value_type;
+            const value_type temp = static_cast<value_type>(value);
+            unwrapped_type   dest = corsac::unwrap_generic_iterator(first);
 
-            __asm__ __volatile__ ("cld\n\t"
-                                  "rep stosl\n\t"
-                                   : "+c" (count), "+D" (first), "=m" (first)
-                                   : "a" (value)
-                                   : "cc" );
+            corsac::internal::fast_fill_pattern<sizeof(value_type)>(dest, &temp, static_cast<size_t>(corsac::unwrap_generic_iterator(last) - dest));
         }
-
-
-		template <typename Value>
-		inline void fill(int32_t* first, int32_t* last, Value c)
-		{
-			uintptr_t count = static_cast<uintptr_t>(last - first);
-			int32_t   value = static_cast<int32_t>(c);
-
-			__asm__ __volatile__ ("cld\n\t"
-								  "rep stosl\n\t"
-								   : "+c" (count), "+D" (first), "=m" (first)
-								   : "a" (value)
-								   : "cc" );
-		}
-
-
-		template <typename Value>
-		inline void fill(uint16_t* first, uint16_t* last, Value c)
-		{
-			uintptr_t count = static_cast<uintptr_t>(last - first);
-			uint16_t  value = static_cast<uint16_t>(c);
-
-			__asm__ __volatile__ ("cld\n\t"
-								  "rep stosw\n\t"
-								   : "+c" (count), "+D" (first), "=m" (first)
-								   : "a" (value)
-								   : "cc" );
-		}
-
-
-		template <typename Value>
-		inline void fill(int16_t* first, int16_t* last, Value c)
-		{
-			uintptr_t count = static_cast<uintptr_t>(last - first);
-			int16_t   value = static_cast<int16_t>(c);
-
-			__asm__ __volatile__ ("cld\n\t"
-								  "rep stosw\n\t"
-								   : "+c" (count), "+D" (first), "=m" (first)
-								   : "a" (value)
-								   : "cc" );
-		}
-
-    #elif defined(CORSAC_COMPILER_MICROSOFT) && (defined(CORSAC_PROCESSOR_X86) || defined(CORSAC_PROCESSOR_X86_64))
-        #if defined(CORSAC_PROCESSOR_X86_64)
-			template <typename Value>
-			inline void fill(uint64_t* first, uint64_t* last, Value c)
-			{
-				__stosq(first, static_cast<uint64_t>(c), static_cast<size_t>(last - first));
-			}
-
-			template <typename Value>
-			inline void fill(int64_t* first, int64_t* last, Value c)
-			{
-				__stosq(static_cast<uint64_t*>(first),  static_cast<uint64_t>(c),  static_cast<size_t>(last - first));
-			}
-		#endif
-
-		template <typename Value>
-		inline void fill(uint32_t* first, uint32_t* last, Value c)
-		{
-			__stosd(static_cast<unsigned long*>(first), static_cast<unsigned long>(c), static_cast<size_t>(last - first));
-		}
-
-		template <typename Value>
-		inline void fill(int32_t* first, int32_t* last, Value c)
-		{
-			__stosd(static_cast<unsigned long*>(first), static_cast<unsigned long>(c), static_cast<size_t>(last - first));
-		}
-
-		template <typename Value>
-		inline void fill(uint16_t* first, uint16_t* last, Value c)
-		{
-			__stosw(first, static_cast<uint16_t>(c), static_cast<size_t>(last - first));
-		}
-
-		template <typename Value>
-		inline void fill(int16_t* first, int16_t* last, Value c)
-		{
-			__stosw(static_cast<uint16_t*>(first), static_cast<uint16_t>(c), static_cast<size_t>(last - first));
-		}
-    #endif
-
+        else
+            corsac::fill_imp<corsac::is_scalar_v<T>>::do_fill(first, last, value);
+    }
 
     inline void fill(char* first, char* last, const char& c) // Спорный вопрос, следует ли нам использовать здесь char& c или char c.
     {
@@ -287,7 +194,21 @@ namespace corsac
     template <typename OutputIterator, typename Size, typename T>
     OutputIterator fill_n(OutputIterator first, Size n, const T& value)
     {
-        return corsac::fill_n_imp<corsac::is_scalar_v<T>>::do_fill(first, n, value);
+        using unwrapped_type = decltype(corsac::unwrap_generic_iterator(first));
+
+        if constexpr(corsac::can_fill_pattern<unwrapped_type, T>::value)
+        {
+            using value_type = typename corsac::iterator_traits<unwrapped_type>::value_type;
+            const value_type temp = static_cast<value_type>(value);
+            unwrapped_type   dest = corsac::unwrap_generic_iterator(first);
+
+            if(n <= 0)
+                return first;
+            corsac::internal::fast_fill_pattern<sizeof(value_type)>(dest, &temp, static_cast<size_t>(n));
+            return OutputIterator(dest + n);
+        }
+        else
+            return corsac::fill_n_imp<corsac::is_scalar_v<T>>::do_fill(first, n, value);
     }
 
     template <typename Size>
@@ -315,143 +236,6 @@ namespace corsac
             return static_cast<bool*>(memset(first,  static_cast<char>(b), n) + static_cast<size_t>(n));
         }
     #endif
-
-    #if (defined(CORSAC_COMPILER_GCC) || defined(CORSAC_COMPILER_CLANG)) && (defined(CORSAC_PROCESSOR_X86) || defined(CORSAC_PROCESSOR_X86_64))
-        #if defined(CORSAC_PROCESSOR_X86_64)
-			template <typename Size, typename Value>
-			inline uint64_t* fill_n(uint64_t* first, Size n, Value c)
-			{
-                uintptr_t count = static_cast<uintptr_t>(n);
-				uint64_t  value = static_cast<uint64_t>(c);
-
-				__asm__ __volatile__ ("cld\n\t"
-									  "rep stosq\n\t"
-									   : "+c" (count), "+D" (first), "=m" (first)
-									   : "a" (value)
-									   : "cc" );
-				return first;
-			}
-
-
-			template <typename Size, typename Value>
-			inline int64_t* fill_n(int64_t* first, Size n, Value c)
-			{
-                uintptr_t count = static_cast<uintptr_t>(n);
-				int64_t   value = static_cast<int64_t>(c);
-
-				__asm__ __volatile__ ("cld\n\t"
-									  "rep stosq\n\t"
-									   : "+c" (count), "+D" (first), "=m" (first)
-									   : "a" (value)
-									   : "cc" );
-				return first;
-			}
-		#endif
-
-		template <typename Size, typename Value>
-		inline uint32_t* fill_n(uint32_t* first, Size n, Value c)
-		{
-            uintptr_t count = static_cast<uintptr_t>(n);
-			uint32_t  value = static_cast<uint32_t>(c);
-
-			__asm__ __volatile__ ("cld\n\t"
-								  "rep stosl\n\t"
-								   : "+c" (count), "+D" (first), "=m" (first)
-								   : "a" (value)
-								   : "cc" );
-			return first;
-		}
-
-
-		template <typename Size, typename Value>
-		inline int32_t* fill_n(int32_t* first, Size n, Value c)
-		{
-            uintptr_t count = static_cast<uintptr_t>(n);
-			int32_t   value = static_cast<int32_t>(c);
-
-			__asm__ __volatile__ ("cld\n\t"
-								  "rep stosl\n\t"
-								   : "+c" (count), "+D" (first), "=m" (first)
-								   : "a" (value)
-								   : "cc" );
-			return first;
-		}
-
-
-		template <typename Size, typename Value>
-		inline uint16_t* fill_n(uint16_t* first, Size n, Value c)
-		{
-            uintptr_t count = static_cast<uintptr_t>(n);
-			uint16_t  value = static_cast<uint16_t>(c);
-
-			__asm__ __volatile__ ("cld\n\t"
-								  "rep stosw\n\t"
-								   : "+c" (count), "+D" (first), "=m" (first)
-								   : "a" (value)
-								   : "cc" );
-			return first;
-		}
-
-
-		template <typename Size, typename Value>
-		inline int16_t* fill_n(int16_t* first, Size n, Value c)
-		{
-            uintptr_t count = static_cast<uintptr_t>(n);
-			int16_t   value = static_cast<int16_t>(c);
-
-			__asm__ __volatile__ ("cld\n\t"
-								  "rep stosw\n\t"
-								   : "+c" (count), "+D" (first), "=m" (first)
-								   : "a" (value)
-								   : "cc" );
-			return first;
-		}
-
-    #elif defined(CORSAC_COMPILER_MICROSOFT) && (defined(CORSAC_PROCESSOR_X86) || defined(CORSAC_PROCESSOR_X86_64))
-         #if defined(CORSAC_PROCESSOR_X86_64)
-            template <typename Size, typename Value>
-            inline uint64_t* fill_n(uint64_t* first, Size n, Value c)
-            {
-                __stosq(first, (uint64_t)c, static_cast<size_t>(n));
-                return first + n;
-            }
-
-            template <typename Size, typename Value>
-            inline int64_t* fill_n(int64_t* first, Size n, Value c)
-            {
-                __stosq((uint64_t*)first, (uint64_t)c, static_cast<size_t>(n));
-                return first + n;
-            }
-        #endif
-
-        template <typename Size, typename Value>
-        inline uint32_t* fill_n(uint32_t* first, Size n, Value c)
-        {
-            __stosd(static_cast<unsigned long*>(first), static_cast<unsigned long>(c), static_cast<size_t>(n));
-            return first + n;
-        }
-
-        template <typename Size, typename Value>
-        inline int32_t* fill_n(int32_t* first, Size n, Value c)
-        {
-            __stosd(static_cast<unsigned long*>(first), static_cast<unsigned long>(c), static_cast<size_t>(n));
-            return first + n;
-        }
-
-        template <typename Size, typename Value>
-        inline uint16_t* fill_n(uint16_t* first, Size n, Value c)
-        {
-            __stosw(first, static_cast<uint16_t>(c), static_cast<size_t>(n));
-            return first + n;
-        }
-
-        template <typename Size, typename Value>
-        inline int16_t* fill_n(int16_t* first, Size n, Value c)
-        {
-            __stosw(static_cast<uint16_t*>(c), static_cast<uint16_t>(c), static_cast<size_t>(n));
-            return first + n;
-        }
-    #endif
 }
 
 #endif //CORSAC_STL_HELP_FILL_H
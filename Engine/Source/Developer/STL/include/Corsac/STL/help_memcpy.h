@@ -0,0 +1,292 @@
+/**
+ * corsac::STL
+ *
+ * internal/help_memcpy.h
+ *
+ * Created by Falldot on 18.10.2026.
+ * Copyright (c) 2021 Corsac. All rights reserved.
+ */
+#ifndef CORSAC_STL_HELP_MEMCPY_H
+#define CORSAC_STL_HELP_MEMCPY_H
+
+#pragma once
+
+#include "Corsac/STL/config.h"
+#include "Corsac/STL/cpu_info.h"
+
+#include <string.h> // memcpy, memmove
+
+/**
+ * Описание (Falldot 18.10.2026)
+ *
+ * fast_memcpy / fast_memmove
+ *
+ * Копирование тривиально копируемых диапазонов с учетом размера копии:
+ *      <= 16 байт          - встроенное копирование двумя перекрывающимися загрузками/записями
+ *                            без вызова функции и без циклов;
+ *      средние размеры     - AVX (или SSE2) цикл невыровненными загрузками и записями;
+ *      больше кеша LLC     - невременные (non-temporal) записи, которые идут мимо кеша и не вытесняют
+ *                            из него рабочие данные. Это важно при росте больших векторов компонентов,
+ *                            когда старый буфер больше не нужен, а новый не будет прочитан сразу.
+ *
+ * Реализация для средних и больших копий выбирается один раз по CPUID при первом вызове.
+ * Перекрывающиеся диапазоны размером больше 16 байт передаются системному memmove.
+ *
+ * CORSAC_MEMCPY_NONTEMPORAL_THRESHOLD
+ *      Порог в байтах, начиная с которого используются невременные записи.
+ *      По умолчанию 0, что означает размер кеша последнего уровня текущего процессора.
+ */
+#ifndef CORSAC_MEMCPY_NONTEMPORAL_THRESHOLD
+    #define CORSAC_MEMCPY_NONTEMPORAL_THRESHOLD 0
+#endif
+
+namespace corsac
+{
+    namespace internal
+    {
+        using memcpy_func = void (*)(void*, const void*, size_t);
+
+        // Копирует не более 16 байт. Все загрузки выполняются до записей, поэтому диапазоны могут перекрываться.
+        inline void memcpy_small(void* dest, const void* src, size_t n) noexcept
+        {
+            unsigned char*       d = static_cast<unsigned char*>(dest);
+            const unsigned char* s = static_cast<const unsigned char*>(src);
+
+            if(n >= 8)
+            {
+                uint64_t head, tail;
+                memcpy(&head, s, 8);
+                memcpy(&tail, s + n - 8, 8);
+                memcpy(d, &head, 8);
+                memcpy(d + n - 8, &tail, 8);
+            }
+            else if(n >= 4)
+            {
+                uint32_t head, tail;
+                memcpy(&head, s, 4);
+                memcpy(&tail, s + n - 4, 4);
+                memcpy(d, &head, 4);
+                memcpy(d + n - 4, &tail, 4);
+            }
+            else if(n >= 2)
+            {
+                uint16_t head, tail;
+                memcpy(&head, s, 2);
+                memcpy(&tail, s + n - 2, 2);
+                memcpy(d, &head, 2);
+                memcpy(d + n - 2, &tail, 2);
+            }
+            else if(n == 1)
+                *d = *s;
+        }
+
+        inline void memcpy_default(void* dest, const void* src, size_t n) noexcept
+        {
+            memcpy(dest, src, n);
+        }
+
+        #if CORSAC_SIMD_X86
+            // Диапазоны не перекрываются, n > 16.
+            CORSAC_TARGET("sse2") inline void memcpy_sse2(void* dest, const void* src, size_t n) noexcept
+            {
+                unsigned char*       d = static_cast<unsigned char*>(dest);
+                const unsigned char* s = static_cast<const unsigned char*>(src);
+
+                const __m128i tail = _mm_loadu_si128((const __m128i*)(s + n - 16));
+                for(; n > 64; n -= 64, s += 64, d += 64)
+                {
+                    const __m128i a = _mm_loadu_si128((const __m128i*)(s));
+                    const __m128i b = _mm_loadu_si128((const __m128i*)(s + 16));
+                    const __m128i c = _mm_loadu_si128((const __m128i*)(s + 32));
+                    const __m128i e = _mm_loadu_si128((const __m128i*)(s + 48));
+                    _mm_storeu_si128((__m128i*)(d), a);
+                    _mm_storeu_si128((__m128i*)(d + 16), b);
+                    _mm_storeu_si128((__m128i*)(d + 32), c);
+                    _mm_storeu_si128((__m128i*)(d + 48), e);
+                }
+                for(; n > 16; n -= 16, s += 16, d += 16)
+                    _mm_storeu_si128((__m128i*)d, _mm_loadu_si128((const __m128i*)s));
+                _mm_storeu_si128((__m128i*)(d + n - 16), tail);
+            }
+
+            // Диапазоны не перекрываются, n > 16.
+            CORSAC_TARGET("avx") inline void memcpy_avx(void* dest, const void* src, size_t n) noexcept
+            {
+                unsigned char*       d = static_cast<unsigned char*>(dest);
+                const unsigned char* s = static_cast<const unsigned char*>(src);
+
+                if(n <= 32)
+                {
+                    const __m128i head = _mm_loadu_si128((const __m128i*)s);
+                    const __m128i tail = _mm_loadu_si128((const __m128i*)(s + n - 16));
+                    _mm_storeu_si128((__m128i*)d, head);
+                    _mm_storeu_si128((__m128i*)(d + n - 16), tail);
+                    return;
+                }
+
+                const __m256i tail = _mm256_loadu_si256((const __m256i*)(s + n - 32));
+                for(; n > 128; n -= 128, s += 128, d += 128)
+                {
+                    const __m256i a = _mm256_loadu_si256((const __m256i*)(s));
+                    const __m256i b = _mm256_loadu_si256((const __m256i*)(s + 32));
+                    const __m256i c = _mm256_loadu_si256((const __m256i*)(s + 64));
+                    const __m256i e = _mm256_loadu_si256((const __m256i*)(s + 96));
+                    _mm256_storeu_si256((__m256i*)(d), a);
+                    _mm256_storeu_si256((__m256i*)(d + 32), b);
+                    _mm256_storeu_si256((__m256i*)(d + 64), c);
+                    _mm256_storeu_si256((__m256i*)(d + 96), e);
+                }
+                for(; n > 32; n -= 32, s += 32, d += 32)
+                    _mm256_storeu_si256((__m256i*)d, _mm256_loadu_si256((const __m256i*)s));
+                _mm256_storeu_si256((__m256i*)(d + n - 32), tail);
+            }
+
+            /**
+             * Невременное копирование. Диапазоны не перекрываются, n >= 128.
+             * Голова копируется обычной записью до выравнивания приемника на 16 байт,
+             * далее идут потоковые записи, хвост снова обычной записью.
+             */
+            CORSAC_TARGET("sse2") inline void memcpy_stream_sse2(void* dest, const void* src, size_t n) noexcept
+            {
+                unsigned char*       d = static_cast<unsigned char*>(dest);
+                const unsigned char* s = static_cast<const unsigned char*>(src);
+
+                const size_t head = (16 - ((uintptr_t)d & 15)) & 15;
+                _mm_storeu_si128((__m128i*)d, _mm_loadu_si128((const __m128i*)s));
+                d += head; s += head; n -= head;
+
+                for(; n >= 64; n -= 64, s += 64, d += 64)
+                {
+                    const __m128i a = _mm_loadu_si128((const __m128i*)(s));
+                    const __m128i b = _mm_loadu_si128((const __m128i*)(s + 16));
+                    const __m128i c = _mm_loadu_si128((const __m128i*)(s + 32));
+                    const __m128i e = _mm_loadu_si128((const __m128i*)(s + 48));
+                    _mm_stream_si128((__m128i*)(d), a);
+                    _mm_stream_si128((__m128i*)(d + 16), b);
+                    _mm_stream_si128((__m128i*)(d + 32), c);
+                    _mm_stream_si128((__m128i*)(d + 48), e);
+                }
+                _mm_sfence(); // Потоковые записи должны стать видимыми до возврата.
+
+                if(n > 16)
+                    memcpy_sse2(d, s, n);
+                else
+                    memcpy_small(d, s, n);
+            }
+
+            // Невременное копирование. Диапазоны не перекрываются, n >= 128.
+            CORSAC_TARGET("avx") inline void memcpy_stream_avx(void* dest, const void* src, size_t n) noexcept
+            {
+                unsigned char*       d = static_cast<unsigned char*>(dest);
+                const unsigned char* s = static_cast<const unsigned char*>(src);
+
+                const size_t head = (32 - ((uintptr_t)d & 31)) & 31;
+                _mm256_storeu_si256((__m256i*)d, _mm256_loadu_si256((const __m256i*)s));
+                d += head; s += head; n -= head;
+
+                for(; n >= 128; n -= 128, s += 128, d += 128)
+                {
+                    const __m256i a = _mm256_loadu_si256((const __m256i*)(s));
+                    const __m256i b = _mm256_loadu_si256((const __m256i*)(s + 32));
+                    const __m256i c = _mm256_loadu_si256((const __m256i*)(s + 64));
+                    const __m256i e = _mm256_loadu_si256((const __m256i*)(s + 96));
+                    _mm256_stream_si256((__m256i*)(d), a);
+                    _mm256_stream_si256((__m256i*)(d + 32), b);
+                    _mm256_stream_si256((__m256i*)(d + 64), c);
+                    _mm256_stream_si256((__m256i*)(d + 96), e);
+                }
+                _mm_sfence();
+
+                if(n > 16)
+                    memcpy_avx(d, s, n);
+                else
+                    memcpy_small(d, s, n);
+            }
+        #endif
+
+        struct memcpy_dispatch
+        {
+            memcpy_func medium               = &memcpy_default;
+            memcpy_func large                = &memcpy_default;
+            size_t      nontemporalThreshold = size_t(-1);
+        };
+
+        inline memcpy_dispatch make_memcpy_dispatch() noexcept
+        {
+            memcpy_dispatch result;
+
+            #if CORSAC_SIMD_X86
+                const cpu_info& cpu = get_cpu_info();
+
+                if(cpu.avx)
+                {
+                    result.medium = &memcpy_avx;
+                    result.large  = &memcpy_stream_avx;
+                }
+                else if(cpu.sse2)
+                {
+                    result.medium = &memcpy_sse2;
+                    result.large  = &memcpy_stream_sse2;
+                }
+
+                if(result.large != &memcpy_default)
+                {
+                    // Потоковым реализациям нужно хотя бы 128 байт на голову, тело и хвост.
+                    const size_t threshold = CORSAC_MEMCPY_NONTEMPORAL_THRESHOLD ? (size_t)CORSAC_MEMCPY_NONTEMPORAL_THRESHOLD : cpu.llc_size;
+                    result.nontemporalThreshold = threshold < 128 ? 128 : threshold;
+                }
+            #endif
+
+            return result;
+        }
+
+        inline const memcpy_dispatch& get_memcpy_dispatch() noexcept
+        {
+            static const memcpy_dispatch dispatch = make_memcpy_dispatch();
+            return dispatch;
+        }
+
+        /**
+         * fast_memcpy
+         *
+         * Аналог memcpy: диапазоны не должны перекрываться. Возвращает dest.
+         */
+        inline void* fast_memcpy(void* dest, const void* src, size_t n) noexcept
+        {
+            if(CORSAC_LIKELY(n <= 16))
+                memcpy_small(dest, src, n);
+            else
+            {
+                const memcpy_dispatch& dispatch = get_memcpy_dispatch();
+                if(CORSAC_UNLIKELY(n >= dispatch.nontemporalThreshold))
+                    dispatch.large(dest, src, n);
+                else
+                    dispatch.medium(dest, src, n);
+            }
+            return dest;
+        }
+
+        /**
+         * fast_memmove
+         *
+         * Аналог memmove: диапазоны могут перекрываться. Возвращает dest.
+         */
+        inline void* fast_memmove(void* dest, const void* src, size_t n) noexcept
+        {
+            if(CORSAC_LIKELY(n <= 16))
+            {
+                memcpy_small(dest, src, n);
+                return dest;
+            }
+
+            const uintptr_t d = (uintptr_t)dest;
+            const uintptr_t s = (uintptr_t)src;
+            if(CORSAC_UNLIKELY((d - s) < n || (s - d) < n)) // Беззнаковое сравнение проверяет перекрытие в обе стороны.
+                return memmove(dest, src, n);
+
+            return fast_memcpy(dest, src, n);
+        }
+    } // namespace internal
+} // namespace corsac
+
+#endif //CORSAC_STL_HELP_MEMCPY_H
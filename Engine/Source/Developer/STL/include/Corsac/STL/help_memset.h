@@ -0,0 +1,226 @@
+/**
+ * corsac::STL
+ *
+ * internal/help_memset.h
+ *
+ * Created by Falldot on 18.10.2026.
+ * Copyright (c) 2021 Corsac. All rights reserved.
+ */
+#ifndef CORSAC_STL_HELP_MEMSET_H
+#define CORSAC_STL_HELP_MEMSET_H
+
+#pragma once
+
+#include "Corsac/STL/config.h"
+#include "Corsac/STL/cpu_info.h"
+#include "Corsac/type_traits.h"
+
+#include <string.h> // memcpy
+
+/**
+ * Описание (Falldot 18.10.2026)
+ *
+ * fast_fill_pattern
+ *
+ * Заполнение памяти повторяющимся шаблоном из 1, 2, 4, 8 или 16 байт, то есть
+ * аналог memset для тривиально копируемых элементов больше байта. Шаблон размножается
+ * в 16-байтовый вектор, после чего память пишется блоками SSE2/AVX. Хвост закрывается одной
+ * перекрывающейся записью, это корректно, потому что размер элемента делит размер вектора.
+ *
+ * Для буферов не меньше CORSAC_MEMSET_NONTEMPORAL_THRESHOLD байт используются невременные записи:
+ * очистка больших сеток за кадр не вытесняет из кеша данные, с которыми кадр еще работает.
+ * Реализация выбирается один раз по CPUID при первом вызове.
+ *
+ * CORSAC_MEMSET_NONTEMPORAL_THRESHOLD
+ *      Порог в байтах для невременных записей. По умолчанию 0 - размер кеша последнего уровня.
+ */
+#ifndef CORSAC_MEMSET_NONTEMPORAL_THRESHOLD
+    #define CORSAC_MEMSET_NONTEMPORAL_THRESHOLD 0
+#endif
+
+namespace corsac
+{
+    namespace internal
+    {
+        // Заполняет bytes >= 32 байт 16-байтовым шаблоном pattern16.
+        using fill_pattern_func = void (*)(void*, const void*, size_t);
+
+        inline void fill_pattern_default(void* dest, const void* pattern16, size_t bytes) noexcept
+        {
+            unsigned char* d = static_cast<unsigned char*>(dest);
+
+            for(size_t offset = 0; offset + 16 < bytes; offset += 16)
+                memcpy(d + offset, pattern16, 16);
+            memcpy(d + bytes - 16, pattern16, 16);
+        }
+
+        #if CORSAC_SIMD_X86
+            CORSAC_TARGET("sse2") inline void fill_pattern_sse2(void* dest, const void* pattern16, size_t bytes) noexcept
+            {
+                unsigned char* d    = static_cast<unsigned char*>(dest);
+                unsigned char* tail = d + bytes - 16;
+                const __m128i  v    = _mm_loadu_si128((const __m128i*)pattern16);
+
+                for(; bytes > 64; bytes -= 64, d += 64)
+                {
+                    _mm_storeu_si128((__m128i*)(d), v);
+                    _mm_storeu_si128((__m128i*)(d + 16), v);
+                    _mm_storeu_si128((__m128i*)(d + 32), v);
+                    _mm_storeu_si128((__m128i*)(d + 48), v);
+                }
+                for(; bytes > 16; bytes -= 16, d += 16)
+                    _mm_storeu_si128((__m128i*)d, v);
+                _mm_storeu_si128((__m128i*)tail, v);
+            }
+
+            CORSAC_TARGET("avx") inline void fill_pattern_avx(void* dest, const void* pattern16, size_t bytes) noexcept
+            {
+                unsigned char* d    = static_cast<unsigned char*>(dest);
+                unsigned char* tail = d + bytes - 32;
+                const __m128i  h    = _mm_loadu_si128((const __m128i*)pattern16);
+                const __m256i  v    = _mm256_insertf128_si256(_mm256_castsi128_si256(h), h, 1);
+
+                for(; bytes > 128; bytes -= 128, d += 128)
+                {
+                    _mm256_storeu_si256((__m256i*)(d), v);
+                    _mm256_storeu_si256((__m256i*)(d + 32), v);
+                    _mm256_storeu_si256((__m256i*)(d + 64), v);
+                    _mm256_storeu_si256((__m256i*)(d + 96), v);
+                }
+                for(; bytes > 32; bytes -= 32, d += 32)
+                    _mm256_storeu_si256((__m256i*)d, v);
+                _mm256_storeu_si256((__m256i*)tail, v);
+            }
+
+            /**
+             * Невременное заполнение, bytes >= 128. Приемник должен быть выровнен на размер элемента:
+             * тогда сдвиг до границы 16 байт кратен размеру элемента и фаза шаблона не нарушается.
+             */
+            CORSAC_TARGET("sse2") inline void fill_pattern_stream_sse2(void* dest, const void* pattern16, size_t bytes) noexcept
+            {
+                unsigned char* d = static_cast<unsigned char*>(dest);
+                const __m128i  v = _mm_loadu_si128((const __m128i*)pattern16);
+
+                const size_t head = (16 - ((uintptr_t)d & 15)) & 15;
+                _mm_storeu_si128((__m128i*)d, v);
+                d += head; bytes -= head;
+
+                for(; bytes >= 64; bytes -= 64, d += 64)
+                {
+                    _mm_stream_si128((__m128i*)(d), v);
+                    _mm_stream_si128((__m128i*)(d + 16), v);
+                    _mm_stream_si128((__m128i*)(d + 32), v);
+                    _mm_stream_si128((__m128i*)(d + 48), v);
+                }
+                for(; bytes >= 16; bytes -= 16, d += 16)
+                    _mm_stream_si128((__m128i*)d, v);
+                _mm_sfence();
+
+                if(bytes)
+                    _mm_storeu_si128((__m128i*)(d + bytes - 16), v);
+            }
+
+            CORSAC_TARGET("avx") inline void fill_pattern_stream_avx(void* dest, const void* pattern16, size_t bytes) noexcept
+            {
+                unsigned char* d = static_cast<unsigned char*>(dest);
+                const __m128i  h = _mm_loadu_si128((const __m128i*)pattern16);
+                const __m256i  v = _mm256_insertf128_si256(_mm256_castsi128_si256(h), h, 1);
+
+                const size_t head = (32 - ((uintptr_t)d & 31)) & 31;
+                _mm256_storeu_si256((__m256i*)d, v);
+                d += head; bytes -= head;
+
+                for(; bytes >= 128; bytes -= 128, d += 128)
+                {
+                    _mm256_stream_si256((__m256i*)(d), v);
+                    _mm256_stream_si256((__m256i*)(d + 32), v);
+                    _mm256_stream_si256((__m256i*)(d + 64), v);
+                    _mm256_stream_si256((__m256i*)(d + 96), v);
+                }
+                for(; bytes >= 32; bytes -= 32, d += 32)
+                    _mm256_stream_si256((__m256i*)d, v);
+                _mm_sfence();
+
+                if(bytes)
+                    _mm256_storeu_si256((__m256i*)(d + bytes - 32), v);
+            }
+        #endif
+
+        struct fill_pattern_dispatch
+        {
+            fill_pattern_func medium               = &fill_pattern_default;
+            fill_pattern_func large                = &fill_pattern_default;
+            size_t            nontemporalThreshold = size_t(-1);
+        };
+
+        inline fill_pattern_dispatch make_fill_pattern_dispatch() noexcept
+        {
+            fill_pattern_dispatch result;
+
+            #if CORSAC_SIMD_X86
+                const cpu_info& cpu = get_cpu_info();
+
+                if(cpu.avx)
+                {
+                    result.medium = &fill_pattern_avx;
+                    result.large  = &fill_pattern_stream_avx;
+                }
+                else if(cpu.sse2)
+                {
+                    result.medium = &fill_pattern_sse2;
+                    result.large  = &fill_pattern_stream_sse2;
+                }
+
+                if(result.large != &fill_pattern_default)
+                {
+                    const size_t threshold = CORSAC_MEMSET_NONTEMPORAL_THRESHOLD ? (size_t)CORSAC_MEMSET_NONTEMPORAL_THRESHOLD : cpu.llc_size;
+                    result.nontemporalThreshold = threshold < 128 ? 128 : threshold;
+                }
+            #endif
+
+            return result;
+        }
+
+        inline const fill_pattern_dispatch& get_fill_pattern_dispatch() noexcept
+        {
+            static const fill_pattern_dispatch dispatch = make_fill_pattern_dispatch();
+            return dispatch;
+        }
+
+        template <size_t N>
+        struct is_fill_pattern_size : public corsac::bool_constant<N == 1 || N == 2 || N == 4 || N == 8 || N == 16> {};
+
+        /**
+         * fast_fill_pattern
+         *
+         * Записывает count копий N-байтового значения value подряд начиная с dest.
+         */
+        template <size_t N>
+        inline void fast_fill_pattern(void* dest, const void* value, size_t count) noexcept
+        {
+            static_assert(is_fill_pattern_size<N>::value, "fill pattern size must be 1, 2, 4, 8 or 16 bytes");
+
+            unsigned char* d     = static_cast<unsigned char*>(dest);
+            const size_t   bytes = count * N;
+
+            if(bytes < 32)
+            {
+                for(size_t i = 0; i < count; ++i)
+                    memcpy(d + i * N, value, N);
+                return;
+            }
+
+            unsigned char pattern[16];
+            for(size_t i = 0; i < 16; i += N)
+                memcpy(pattern + i, value, N);
+
+            const fill_pattern_dispatch& dispatch = get_fill_pattern_dispatch();
+            if(CORSAC_UNLIKELY(bytes >= dispatch.nontemporalThreshold) && (((uintptr_t)d % N) == 0))
+                dispatch.large(d, pattern, bytes);
+            else
+                dispatch.medium(d, pattern, bytes);
+        }
+    } // namespace internal
+} // namespace corsac
+
+#endif //CORSAC_STL_HELP_MEMSET_H
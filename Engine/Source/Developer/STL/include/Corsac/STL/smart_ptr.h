@@ -11,6 +11,10 @@
 
 #pragma once
 
+#include "Corsac/STL/config.h"
+#include "Corsac/type_traits.h"
+#include "Corsac/memory.h"
+
 namespace corsac
 {
     namespace internal
@@ -556,22 +556,22 @@ namespace corsac
 
     template <size_t I0>
     struct static_min<I0>
-    { static const size_t value = I0; };
+    { static constexpr size_t value = I0; };
 
     template <size_t I0, size_t I1, size_t ...in>
     struct static_min<I0, I1, in...>
-    { static const size_t value = ((I0 <= I1) ? static_min<I0, in...>::value : static_min<I1, in...>::value); };
+    { static constexpr size_t value = ((I0 <= I1) ? static_min<I0, in...>::value : static_min<I1, in...>::value); };
 
     template <size_t I0, size_t ...in>
     struct static_max;
 
     template <size_t I0>
     struct static_max<I0>
-    { static const size_t value = I0; };
+    { static constexpr size_t value = I0; };
 
     template <size_t I0, size_t I1, size_t ...in>
     struct static_max<I0, I1, in...>
-    { static const size_t value = ((I0 >= I1) ? static_max<I0, in...>::value : static_max<I1, in...>::value); };
+    { static constexpr size_t value = ((I0 >= I1) ? static_max<I0, in...>::value : static_max<I1, in...>::value); };
 
     /**
       * Этот класс перечисления полезен для определения того, является ли система прямым или прямым порядком байтов.
@@ -0,0 +1,271 @@
+/**
+ * corsac::STL
+ *
+ * unique_function.h
+ *
+ * Created by Falldot on 18.10.2026.
+ * Copyright (c) 2021 Corsac. All rights reserved.
+ */
+#ifndef CORSAC_STL_UNIQUE_FUNCTION_H
+#define CORSAC_STL_UNIQUE_FUNCTION_H
+
+#pragma once
+/**
+ * Описание (Falldot 18.10.2026)
+ *
+ * unique_function<R(Args...), SIZE_IN_BYTES> - только перемещаемая оболочка вызываемого объекта
+ * для задач и обратных вызовов, которые захватывают unique_ptr и другие некопируемые значения.
+ *
+ * В отличие от function и fixed_function:
+ *  - функтор всегда хранится во встроенном буфере размером SIZE_IN_BYTES, память не выделяется
+ *    никогда: функтор, который не помещается, - ошибка компиляции (как у fixed_function, но
+ *    у function больший функтор уходит в кучу);
+ *  - копирование запрещено, функтор должен быть перемещаемым без исключений, поэтому можно
+ *    захватывать unique_ptr;
+ *  - указатель на вызыватель лежит в самом объекте рядом с буфером, поэтому вызов - одна загрузка
+ *    указателя и один косвенный переход. Редкие операции (перенос, уничтожение, размер функтора)
+ *    вынесены в статическую таблицу, на которую объект хранит второй указатель. Для тривиально
+ *    копируемых функторов (лямбды, захватывающие указатели и числа) перемещение - memcpy функтора
+ *    без вызова.
+ *
+ * По умолчанию буфер занимает 64 - 2 * sizeof(void*) байт, и весь объект - ровно одна кэш-линия.
+ * Размер буфера - второй параметр шаблона (у fixed_function - первый), чтобы у него было значение
+ * по умолчанию.
+ *
+ * Пример использования:
+ *      corsac::unique_function<void()> job = [data = corsac::make_unique<Payload>()] { process(*data); };
+ *      queue.push_back(corsac::move(job));
+ *
+ *      corsac::unique_function<void(), 128> bigJob = [matrices] { ... }; // Больший буфер.
+ */
+
+#include "Corsac/STL/config.h"
+#include "Corsac/STL/function_detail.h"
+
+#include <string.h>
+
+/**
+ * CORSAC_UNIQUE_FUNCTION_DEFAULT_SIZE
+ *
+ * Размер встроенного буфера unique_function по умолчанию.
+ */
+#ifndef CORSAC_UNIQUE_FUNCTION_DEFAULT_SIZE
+    #define CORSAC_UNIQUE_FUNCTION_DEFAULT_SIZE (64 - 2 * sizeof(void*))
+#endif
+
+namespace corsac
+{
+    template <typename, size_t SIZE_IN_BYTES = CORSAC_UNIQUE_FUNCTION_DEFAULT_SIZE>
+    class unique_function;
+
+    namespace internal
+    {
+        // Редкие операции над функтором в буфере, вызыватель хранится в самом unique_function.
+        // Для каждого типа функтора существует один экземпляр таблицы. relocate == nullptr и
+        // destroy == nullptr означают тривиально копируемый и уничтожаемый функтор.
+        struct unique_function_vtable
+        {
+            void (*relocate)(void* to, void* from) noexcept;   // Перемещает функтор и уничтожает исходный.
+            void (*destroy)(void* storage) noexcept;
+            size_t size;                                        // Сколько байт копирует memcpy: sizeof функтора, у пустого - 0.
+        };
+
+        template <typename Functor, typename R, typename... Args>
+        struct unique_function_ops
+        {
+            // Порядок аргументов как у function_manager::Invoker: буфер последним, чтобы аргументы не сдвигались по регистрам.
+            static R invoke(Args... args, void* storage)
+            {
+                return corsac::invoke(*static_cast<Functor*>(storage), corsac::forward<Args>(args)...);
+            }
+
+            static void relocate(void* to, void* from) noexcept
+            {
+                ::new (to) Functor(corsac::move(*static_cast<Functor*>(from)));
+                static_cast<Functor*>(from)->~Functor();
+            }
+
+            static void destroy(void* storage) noexcept
+            {
+                static_cast<Functor*>(storage)->~Functor();
+            }
+
+            static constexpr bool is_trivial = corsac::is_trivially_copyable_v<Functor> && corsac::is_trivially_destructible_v<Functor>;
+
+            static constexpr unique_function_vtable vtable =
+            {
+                is_trivial ? nullptr : &relocate,
+                is_trivial ? nullptr : &destroy,
+                corsac::is_empty_v<Functor> ? 0 : sizeof(Functor)
+            };
+        };
+    }
+
+    template <typename R, typename... Args, size_t SIZE_IN_BYTES>
+    class unique_function<R(Args...), SIZE_IN_BYTES>
+    {
+        static_assert(SIZE_IN_BYTES >= sizeof(void*), "unique_function storage must be able to hold at least a pointer!");
+
+        using vtable_type  = internal::unique_function_vtable;
+        using invoker_type = R (*)(Args..., void* storage);
+
+        template <typename Functor>
+        using valid_functor = corsac::enable_if_t<corsac::is_invocable_r_v<R, corsac::decay_t<Functor>&, Args...> &&
+                                                  !corsac::is_same_v<corsac::decay_t<Functor>, unique_function>>;
+
+    public:
+        using result_type = R;
+
+        static constexpr size_t storage_size = SIZE_IN_BYTES;
+
+        unique_function() noexcept = default;
+        unique_function(std::nullptr_t) noexcept {}
+
+        template <typename Functor, typename = valid_functor<Functor>>
+        unique_function(Functor&& functor)
+        {
+            create(corsac::forward<Functor>(functor));
+        }
+
+        unique_function(unique_function&& other) noexcept
+        {
+            move_from(other);
+        }
+
+        unique_function(const unique_function&) = delete;
+        unique_function& operator=(const unique_function&) = delete;
+
+        ~unique_function() noexcept
+        {
+            destroy();
+        }
+
+        unique_function& operator=(unique_function&& other) noexcept
+        {
+            if(this != &other)
+            {
+                destroy();
+                move_from(other);
+            }
+            return *this;
+        }
+
+        unique_function& operator=(std::nullptr_t) noexcept
+        {
+            destroy();
+            return *this;
+        }
+
+        template <typename Functor, typename = valid_functor<Functor>>
+        unique_function& operator=(Functor&& functor)
+        {
+            destroy();
+            create(corsac::forward<Functor>(functor));
+            return *this;
+        }
+
+        void swap(unique_function& other) noexcept
+        {
+            if(this != &other)
+            {
+                unique_function temp(corsac::move(other));
+                other = corsac::move(*this);
+                *this = corsac::move(temp);
+            }
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return mInvoke != nullptr;
+        }
+
+        // Вызов пустого unique_function - ошибка, в отладке срабатывает CORSAC_ASSERT.
+        R operator()(Args... args) const
+        {
+            CORSAC_ASSERT(mInvoke != nullptr);
+            return mInvoke(corsac::forward<Args>(args)..., const_cast<char*>(mStorage));
+        }
+
+    private:
+        template <typename Functor>
+        void create(Functor&& functor)
+        {
+            using DecayedFunctorType = corsac::decay_t<Functor>;
+
+            static_assert(sizeof(DecayedFunctorType) <= SIZE_IN_BYTES,
+                          "unique_function: functor does not fit into the inline storage, increase SIZE_IN_BYTES.");
+            static_assert(alignof(DecayedFunctorType) <= alignof(max_align_t),
+                          "unique_function: functor is over-aligned.");
+            static_assert(corsac::is_nothrow_move_constructible_v<DecayedFunctorType>,
+                          "unique_function: functor must be nothrow move constructible.");
+
+            if(internal::is_null(functor))
+                return;
+
+            ::new (static_cast<void*>(mStorage)) DecayedFunctorType(corsac::forward<Functor>(functor));
+            mInvoke = &internal::unique_function_ops<DecayedFunctorType, R, Args...>::invoke;
+            mVTable = &internal::unique_function_ops<DecayedFunctorType, R, Args...>::vtable;
+        }
+
+        void move_from(unique_function& other) noexcept
+        {
+            if(other.mInvoke)
+            {
+                // Копируется только сам функтор: хвост буфера не инициализирован.
+                if(other.mVTable->relocate)
+                    other.mVTable->relocate(mStorage, other.mStorage);
+                else
+                    memcpy(mStorage, other.mStorage, other.mVTable->size);
+            }
+            mInvoke       = other.mInvoke;
+            mVTable       = other.mVTable;
+            other.mInvoke = nullptr;
+            other.mVTable = nullptr;
+        }
+
+        void destroy() noexcept
+        {
+            if(mInvoke && mVTable->destroy)
+                mVTable->destroy(mStorage);
+            mInvoke = nullptr;
+            mVTable = nullptr;
+        }
+
+        // Буфер первым: при размере по умолчанию оба указателя попадают в конец той же кэш-линии.
+        alignas(max_align_t) char mStorage[SIZE_IN_BYTES];
+        invoker_type       mInvoke = nullptr;
+        const vtable_type* mVTable = nullptr;
+    };
+
+    template <typename R, typename... Args, size_t N>
+    bool operator==(const unique_function<R(Args...), N>& f, std::nullptr_t) noexcept
+    {
+        return !f;
+    }
+
+    template <typename R, typename... Args, size_t N>
+    bool operator==(std::nullptr_t, const unique_function<R(Args...), N>& f) noexcept
+    {
+        return !f;
+    }
+
+    template <typename R, typename... Args, size_t N>
+    bool operator!=(const unique_function<R(Args...), N>& f, std::nullptr_t) noexcept
+    {
+        return !!f;
+    }
+
+    template <typename R, typename... Args, size_t N>
+    bool operator!=(std::nullptr_t, const unique_function<R(Args...), N>& f) noexcept
+    {
+        return !!f;
+    }
+
+    template <typename R, typename... Args, size_t N>
+    void swap(unique_function<R(Args...), N>& lhs, unique_function<R(Args...), N>& rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+}
+
+#endif //CORSAC_STL_UNIQUE_FUNCTION_H
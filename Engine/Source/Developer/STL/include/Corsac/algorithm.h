@@ -958,8 +958,8 @@ namespace corsac
         template <typename T>
         static T* move_or_copy_backward(const T* first, const T* last, T* resultEnd)
         {
-            return (T*)memmove(resultEnd - (last - first), first, (size_t)((uintptr_t)last - (uintptr_t)first));
-            // We could use memcpy here if there's no range overlap, but memcpy is rarely much faster than memmove.
+            return (T*)corsac::internal::fast_memmove(resultEnd - (last - first), first, (size_t)((uintptr_t)last - (uintptr_t)first));
+            // fast_memmove falls back to memmove only when the ranges actually overlap.
         }
     };
 
@@ -26,9 +26,12 @@
  *
  *      common_type                     Описывает специализации шаблона класса common_type для создания экземпляров duration и time_point.
  *      duration_values                 Предоставляет конкретные значения для параметра Rep шаблона duration.
- *      high_resolution_clock           Часы с тактовым периодом в наносекунд.
+ *      high_resolution_clock           Часы с наименьшим доступным тактовым периодом, синоним steady_clock.
  *      steady_clock                    Часы. Предпочтительный для измерения временных интервалов.
  *      system_clock                    Объект clock type, основанный на часах системы в реальном времени.
+ *      tsc_clock                       Монотонные часы на счетчике тактов процессора (rdtsc), откалиброванные по
+ *                                      CLOCK_MONOTONIC_RAW (не по steady_clock, который по умолчанию читает CLOCK_MONOTONIC:
+ *                                      начало отсчета у них разное, а скорость расходится на подстройку NTP).
  *
  * === Функции:
  *
@@ -113,6 +116,30 @@
 #include "Corsac/type_traits.h"
 #include "Corsac/numeric_limits.h"
 #include "Corsac/ratio.h"
+#include "Corsac/STL/cpu_info.h"
+
+/**
+ * CORSAC_CHRONO_STEADY_CLOCK_ID (POSIX)
+ *
+ * Идентификатор часов clock_gettime для steady_clock. По умолчанию CLOCK_MONOTONIC: на Linux
+ * он читается через vDSO без системного вызова, но его скорость подстраивается NTP.
+ * CLOCK_MONOTONIC_RAW не подстраивается и тоже читается через vDSO на современных ядрах,
+ * на старых ядрах это системный вызов.
+ */
+#ifndef CORSAC_CHRONO_STEADY_CLOCK_ID
+    #define CORSAC_CHRONO_STEADY_CLOCK_ID CLOCK_MONOTONIC
+#endif
+
+/**
+ * CORSAC_CHRONO_TSC_CALIBRATION_NS
+ *
+ * Длительность калибровки tsc_clock в наносекундах. Калибровка выполняется один раз,
+ * при первом обращении к tsc_clock. Ошибка частоты примерно равна длительности одного
+ * чтения steady_clock, деленной на это значение.
+ */
+#ifndef CORSAC_CHRONO_TSC_CALIBRATION_NS
+    #define CORSAC_CHRONO_TSC_CALIBRATION_NS 5000000
+#endif
 
 // TODO:  move to platform specific cpp or header file
 #if defined(CORSAC_PLATFORM_MICROSOFT)
@@ -146,7 +173,7 @@
 		#include <pthread_time.h>
 	#endif
 	#include <time.h>
-	#if (defined(CLOCK_RCORSACLTIME) || defined(CLOCK_MONOTONIC))
+	#if (defined(CLOCK_REALTIME) || defined(CLOCK_MONOTONIC))
 		#include <errno.h>
 	#else
 		#include <sys/time.h>
@@ -154,6 +181,14 @@
 	#endif
 #endif
 
+#if CORSAC_SIMD_X86
+    #if defined(CORSAC_COMPILER_MSVC)
+        #include <intrin.h>
+    #else
+        #include <x86intrin.h>
+    #endif
+#endif
+
 namespace corsac
 {
     namespace chrono
@@ -346,7 +381,7 @@ namespace corsac
         duration<typename corsac::common_type<Rep1, Rep2>::type, Period1> inline
         operator*(const duration<Rep1, Period1>& lhs, const Rep2& rhs)
         {
-            using common_duration_t = typename duration<corsac::common_type<Rep1, Rep2>, Period1>::type;
+            using common_duration_t = duration<typename corsac::common_type<Rep1, Rep2>::type, Period1>;
             return common_duration_t(common_duration_t(lhs).count() * rhs);
         }
 
@@ -563,19 +598,34 @@ namespace corsac
         #elif defined CORSAC_PLATFORM_SONY
                     #define CORSAC_NS_PER_TICK _XTIME_NSECS_PER_TICK
                 #elif defined CORSAC_PLATFORM_POSIX
-                    #define CORSAC_NS_PER_TICK _XTIME_NSECS_PER_TICK
+                    #define CORSAC_NS_PER_TICK 1
                 #else
                     #define CORSAC_NS_PER_TICK 100
         #endif
 
             #if defined(CORSAC_PLATFORM_POSIX)
-                        using SteadyClock_Period = chrono::nanoseconds::period SystemClock_Period;
-                                typedef chrono::nanoseconds::period ;
+                        using SystemClock_Period = chrono::nanoseconds::period;
+                        using SteadyClock_Period = chrono::nanoseconds::period;
             #else
                         using SystemClock_Period = corsac::ratio_multiply<corsac::ratio<CORSAC_NS_PER_TICK, 1>, nano>::type;
                         using SteadyClock_Period = corsac::ratio_multiply<corsac::ratio<CORSAC_NS_PER_TICK, 1>, nano>::type;
             #endif
 
+            #if defined(CORSAC_PLATFORM_POSIX) && !defined(CORSAC_PLATFORM_APPLE) && (defined(CLOCK_REALTIME) || defined(CLOCK_MONOTONIC))
+                // internal::GetClockTime
+                // Наносекунды часов clockId. Если часы не поддерживаются ядром, используется CLOCK_REALTIME.
+                inline uint64_t GetClockTime(clockid_t clockId)
+                {
+                    timespec ts;
+                    int result = clock_gettime(clockId, &ts);
+
+                    if (result == -1 && errno == EINVAL)
+                        result = clock_gettime(CLOCK_REALTIME, &ts);
+
+                    return (uint64_t)ts.tv_nsec + ((uint64_t)ts.tv_sec * UINT64_C(1000000000));
+                }
+            #endif
+
             // internal::GetTicks
             inline uint64_t GetTicks()
             {
@@ -601,15 +651,8 @@ namespace corsac
             #elif defined(CORSAC_PLATFORM_APPLE)
                 return mach_absolute_time();
             #elif defined(CORSAC_PLATFORM_POSIX) // Posix means Linux, Unix, and Macintosh OSX, among others (including Linux-based mobile platforms).
-                #if (defined(CLOCK_RCORSACLTIME) || defined(CLOCK_MONOTONIC))
-                    timespec ts;
-                    int result = clock_gettime(CLOCK_MONOTONIC, &ts);
-
-                    if (result == -1 && errno == EINVAL)
-                        result = clock_gettime(CLOCK_RCORSACLTIME, &ts);
-
-                    const uint64_t nNanoseconds = (uint64_t)ts.tv_nsec + ((uint64_t)ts.tv_sec * UINT64_C(1000000000));
-                    return nNanoseconds;
+                #if (defined(CLOCK_REALTIME) || defined(CLOCK_MONOTONIC))
+                    return GetClockTime(CORSAC_CHRONO_STEADY_CLOCK_ID);
                 #else
                     struct timeval tv;
                     gettimeofday(&tv, NULL);
@@ -620,6 +663,29 @@ namespace corsac
                     #error "chrono not implemented for platform"
             #endif
             }
+
+            // internal::GetSystemTicks
+            // На POSIX системные часы отсчитываются от 1.1.1970 (CLOCK_REALTIME), на остальных платформах
+            // совпадают с GetTicks.
+            inline uint64_t GetSystemTicks()
+            {
+            #if defined(CORSAC_PLATFORM_POSIX) && !defined(CORSAC_PLATFORM_APPLE) && defined(CLOCK_REALTIME)
+                return GetClockTime(CLOCK_REALTIME);
+            #else
+                return GetTicks();
+            #endif
+            }
+
+            // internal::GetRawTicks
+            // Наносекунды часов, которые не подстраиваются NTP. По ним калибруется tsc_clock.
+            inline uint64_t GetRawTicks()
+            {
+            #if defined(CORSAC_PLATFORM_POSIX) && !defined(CORSAC_PLATFORM_APPLE) && defined(CLOCK_MONOTONIC_RAW)
+                return GetClockTime(CLOCK_MONOTONIC_RAW);
+            #else
+                return GetTicks();
+            #endif
+            }
         } // namespace internal
 
         // system_clock
@@ -637,7 +703,7 @@ namespace corsac
             // возвращает момент времени, представляющий текущий момент времени.
             static time_point now() noexcept
             {
-                return time_point(duration(internal::GetTicks()));
+                return time_point(duration(internal::GetSystemTicks()));
             }
         };
 
@@ -661,7 +727,151 @@ namespace corsac
         };
 
         // high_resolution_clock
-        using high_resolution_clock = system_clock;
+        using high_resolution_clock = steady_clock;
+
+        namespace internal
+        {
+            // Калибровка tsc_clock: наносекунды = baseNs + (такты - baseTicks) * nsPerTick.
+            struct TscCalibration
+            {
+                uint64_t baseTicks;
+                uint64_t baseNs;
+                double   nsPerTick;
+                bool     useTsc; // false, если TSC нет или он не инвариантен: тогда tsc_clock читает GetRawTicks.
+            };
+
+            inline uint64_t ReadTsc() noexcept
+            {
+            #if CORSAC_SIMD_X86
+                return __rdtsc();
+            #else
+                return GetRawTicks();
+            #endif
+            }
+
+            // Пара замеров (TSC, GetRawTicks). TSC читается до и после часов и усредняется. Если поток
+            // вытеснили между чтениями, середина отстоит от момента чтения часов на доли кванта
+            // планировщика, поэтому из нескольких попыток берется самая узкая.
+            inline void SampleTsc(uint64_t& ticks, uint64_t& ns) noexcept
+            {
+                uint64_t width = ~uint64_t(0);
+                for (int attempt = 0; attempt < 4; ++attempt)
+                {
+                    const uint64_t before = ReadTsc();
+                    const uint64_t now = GetRawTicks();
+                    const uint64_t after = ReadTsc();
+                    if (after - before < width)
+                    {
+                        width = after - before;
+                        ticks = before + width / 2;
+                        ns    = now;
+                    }
+                }
+            }
+
+            inline TscCalibration CalibrateTsc() noexcept
+            {
+                TscCalibration calibration = { 0, 0, 1.0, false };
+            #if CORSAC_SIMD_X86
+                if (corsac::internal::get_cpu_info().invariant_tsc)
+                {
+                    uint64_t ticks = 0, ns = 0, endTicks = 0, endNs = 0;
+                    SampleTsc(ticks, ns);
+                    do
+                    {
+                        SampleTsc(endTicks, endNs);
+                    } while (endNs - ns < CORSAC_CHRONO_TSC_CALIBRATION_NS);
+
+                    if (endTicks > ticks)
+                        calibration = { endTicks, endNs, double(endNs - ns) / double(endTicks - ticks), true };
+                }
+            #endif
+                return calibration;
+            }
+
+            inline const TscCalibration& GetTscCalibration() noexcept
+            {
+                static const TscCalibration calibration = CalibrateTsc();
+                return calibration;
+            }
+        } // namespace internal
+
+        /**
+         * tsc_clock
+         *
+         * Монотонные часы на счетчике тактов процессора. now() стоит одно чтение rdtsc и одно
+         * умножение, без обращения к ОС. Частота TSC измеряется один раз по монотонным часам ОС
+         * (CLOCK_MONOTONIC_RAW на Linux), время отсчитывается в той же шкале, что и эти часы.
+         * Это не шкала steady_clock (CLOCK_MONOTONIC): начало отсчета у часов разное, поэтому их
+         * time_point нельзя сравнивать, а интервалы расходятся на подстройку скорости NTP.
+         *
+         * Если процессор не поддерживает инвариантный TSC (или это не x86), tsc_clock возвращает
+         * время монотонных часов ОС, а ticks() - их наносекунды.
+         *
+         * ticks() и ticks_ordered() возвращают сырые такты для случаев, когда перевод в наносекунды
+         * можно отложить (профилировщик). ticks_ordered() использует rdtscp, которая не выполняется
+         * раньше предыдущих инструкций, и дополнительно возвращает номер ядра (IA32_TSC_AUX).
+         */
+        class tsc_clock
+        {
+        public:
+            using rep           = long long;
+            using period        = nano;
+            using duration      = chrono::duration<rep, period>;
+            using time_point    = chrono::time_point<tsc_clock>;
+
+            constexpr static bool is_steady = true;
+
+            static time_point now() noexcept
+            {
+                const internal::TscCalibration& calibration = internal::GetTscCalibration();
+                if (CORSAC_UNLIKELY(!calibration.useTsc))
+                    return time_point(duration(internal::GetRawTicks()));
+                return time_point(duration(to_ns(internal::ReadTsc())));
+            }
+
+            static uint64_t ticks() noexcept
+            {
+                return internal::GetTscCalibration().useTsc ? internal::ReadTsc() : internal::GetRawTicks();
+            }
+
+            static uint64_t ticks_ordered(uint32_t* cpu = nullptr) noexcept
+            {
+            #if CORSAC_SIMD_X86
+                if (internal::GetTscCalibration().useTsc && corsac::internal::get_cpu_info().rdtscp)
+                {
+                    unsigned int aux;
+                    const uint64_t result = __rdtscp(&aux);
+                    if (cpu)
+                        *cpu = aux;
+                    return result;
+                }
+            #endif
+                if (cpu)
+                    *cpu = 0;
+                return ticks();
+            }
+
+            // Наносекунды в шкале now() для значения ticks().
+            static long long to_ns(uint64_t ticks) noexcept
+            {
+                const internal::TscCalibration& calibration = internal::GetTscCalibration();
+                if (!calibration.useTsc)
+                    return (long long)ticks;
+                return (long long)calibration.baseNs + (long long)(double((int64_t)(ticks - calibration.baseTicks)) * calibration.nsPerTick);
+            }
+
+            // Длительность одного такта ticks() в наносекундах.
+            static double ns_per_tick() noexcept
+            {
+                return internal::GetTscCalibration().nsPerTick;
+            }
+
+            static bool is_tsc() noexcept
+            {
+                return internal::GetTscCalibration().useTsc;
+            }
+        };
 
     } // namespace chrono
 
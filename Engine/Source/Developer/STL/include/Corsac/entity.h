@@ -0,0 +1,319 @@
+/**
+ * corsac::STL
+ *
+ * entity.h
+ *
+ * Created by Falldot on 18.10.2026.
+ * Copyright (c) 2021 Corsac. All rights reserved.
+ */
+#ifndef CORSAC_STL_ENTITY_H
+#define CORSAC_STL_ENTITY_H
+
+#pragma once
+/**
+ * Описание (Falldot 18.10.2026)
+ *
+ * Идентификаторы сущностей: entity и entity_manager.
+ *
+ * entity - пара "индекс + поколение", как slot_map_key. Индекс адресует массивы менеджера
+ * (и массивы мира, который хранит по индексу положение сущности), поколение отличает
+ * сущность от предыдущих владельцев того же индекса.
+ *
+ * entity_manager выдает и освобождает индексы:
+ *  - освобожденные индексы хранятся в стеке corsac::vector и переиспользуются первыми;
+ *  - поколение индекса увеличивается при уничтожении, поэтому проверка entity - это
+ *    сравнение индекса с размером, сравнение поколений и проверка бита маски живых;
+ *  - живые сущности отмечены в битовой маске (alive_mask). Маска дополнена нулями до
+ *    кратного 256 битам числа слов, поэтому ее можно обходить векторными загрузками по
+ *    4 слова без хвоста, а for_each_alive пропускает пустые слова целиком.
+ *
+ * Пакетные create(count, out) и destroy(entities, count) делают одно выделение памяти на
+ * пакет, а новые индексы в конце диапазона отмечают живыми целыми словами маски - тысяча
+ * пуль за кадр обходится в несколько проходов по памяти, а не в тысячу отдельных вызовов.
+ *
+ * ---------------------------------------------------------------------------------------------------
+ * === Классы:
+ *
+ *      entity                          Идентификатор сущности: 32-битный индекс и 32-битное поколение.
+ *      entity_manager                  Выдача, переиспользование и маска живых сущностей.
+ *
+ * Пример использования:
+ *      corsac::entity_manager entities;
+ *      corsac::entity bullets[1000];
+ *      entities.create(1000, bullets);
+ *      ...
+ *      entities.destroy(bullets, 1000);
+ */
+
+#include "Corsac/STL/config.h"
+#include "Corsac/vector.h"
+#include "Corsac/functional.h"
+
+#if defined(CORSAC_COMPILER_MSVC)
+    #include <intrin.h>
+#endif
+
+namespace corsac
+{
+    // CORSAC_ENTITY_MANAGER_DEFAULT_NAME
+    #ifndef CORSAC_ENTITY_MANAGER_DEFAULT_NAME
+        #define CORSAC_ENTITY_MANAGER_DEFAULT_NAME CORSAC_DEFAULT_NAME_PREFIX " entity_manager"
+    #endif
+
+    // CORSAC_ENTITY_MANAGER_DEFAULT_ALLOCATOR
+    #ifndef CORSAC_ENTITY_MANAGER_DEFAULT_ALLOCATOR
+        #define CORSAC_ENTITY_MANAGER_DEFAULT_ALLOCATOR CORSAC_ALLOCATOR_TYPE(CORSAC_ENTITY_MANAGER_DEFAULT_NAME)
+    #endif
+
+    namespace internal
+    {
+        // Номер младшего установленного бита, word != 0.
+        inline uint32_t count_trailing_zeros64(uint64_t word) noexcept
+        {
+            #if defined(CORSAC_COMPILER_MSVC) && defined(_M_X64)
+                unsigned long index;
+                _BitScanForward64(&index, word);
+                return (uint32_t)index;
+            #elif defined(CORSAC_COMPILER_GCC) || defined(CORSAC_COMPILER_CLANG)
+                return (uint32_t)__builtin_ctzll(word);
+            #else
+                uint32_t index = 0;
+                while((word & 1) == 0)
+                {
+                    word >>= 1;
+                    ++index;
+                }
+                return index;
+            #endif
+        }
+    }
+
+    /**
+     * entity
+     *
+     * Сущность по умолчанию (null) недействительна в любом менеджере.
+     */
+    struct entity
+    {
+        static constexpr uint32_t npos = 0xFFFFFFFFu;
+
+        uint32_t index;
+        uint32_t generation;
+
+        constexpr entity() noexcept : index(npos), generation(0) {}
+        constexpr entity(uint32_t i, uint32_t g) noexcept : index(i), generation(g) {}
+
+        constexpr bool is_null() const noexcept { return index == npos; }
+        constexpr uint64_t value() const noexcept { return ((uint64_t)generation << 32) | index; }
+
+        constexpr bool operator==(const entity& x) const noexcept { return index == x.index && generation == x.generation; }
+        constexpr bool operator!=(const entity& x) const noexcept { return !(*this == x); }
+        constexpr bool operator<(const entity& x) const noexcept { return value() < x.value(); }
+    };
+
+    template <> struct hash<entity>
+    { size_t operator()(const entity& e) const { return static_cast<size_t>(hash_mix(static_cast<size_t>(e.value()))); } };
+
+    /**
+     * entity_manager
+     */
+    class entity_manager
+    {
+    public:
+        using size_type = uint32_t;
+
+        // Маска дополняется до кратного kMaskWordAlignment числа слов (256 бит).
+        static constexpr size_type kMaskWordAlignment = 4;
+
+        entity_manager();
+
+        entity create();
+
+        // Создает count сущностей и записывает их в out.
+        void create(size_type count, entity* out);
+
+        // Возвращает false, если сущность уже уничтожена.
+        bool destroy(entity e);
+
+        // Уничтожает живые сущности из массива, уже уничтоженные пропускаются. Возвращает число уничтоженных.
+        size_type destroy(const entity* entities, size_type count);
+
+        // Поколение свободного индекса тоже может совпасть с поколением в entity: world::restore
+        // возвращает индекс, занятый после снимка, в свободное состояние с прежним поколением.
+        // Поэтому кроме поколения проверяется бит маски.
+        bool alive(entity e) const noexcept
+        {
+            return e.index < mGenerations.size() && mGenerations[e.index] == e.generation &&
+                   (mAlive[e.index >> 6] & (uint64_t(1) << (e.index & 63))) != 0;
+        }
+
+        // Текущая сущность с индексом index; null, если индекс свободен.
+        entity at(size_type index) const noexcept;
+
+        // Число живых сущностей.
+        size_type size() const noexcept { return mAliveCount; }
+
+        // Число выданных когда-либо индексов: все индексы живых сущностей меньше этого значения.
+        size_type capacity() const noexcept { return (size_type)mGenerations.size(); }
+
+        void reserve(size_type n);
+        void clear();
+
+        // Бит i слова i / 64 установлен, если индекс i занят живой сущностью.
+        const uint64_t* alive_mask() const noexcept { return mAlive.data(); }
+        size_type alive_mask_words() const noexcept { return (size_type)mAlive.size(); }
+
+        // function(entity) для каждой живой сущности в порядке возрастания индекса.
+        template <typename Function>
+        void for_each_alive(Function function) const;
+
+        bool validate() const;
+
+    protected:
+        void DoSetAlive(size_type first, size_type last);
+        void DoGrowMask(size_type indexCount);
+
+        vector<uint32_t> mGenerations;
+        vector<uint32_t> mFree;         // Стек свободных индексов.
+        vector<uint64_t> mAlive;
+        size_type        mAliveCount = 0;
+    };
+
+    inline entity_manager::entity_manager()
+        : mGenerations(CORSAC_ENTITY_MANAGER_DEFAULT_ALLOCATOR), mFree(CORSAC_ENTITY_MANAGER_DEFAULT_ALLOCATOR), mAlive(CORSAC_ENTITY_MANAGER_DEFAULT_ALLOCATOR)
+    {}
+
+    inline entity entity_manager::create()
+    {
+        entity e;
+        create(1, &e);
+        return e;
+    }
+
+    inline void entity_manager::create(size_type count, entity* out)
+    {
+        // Сначала переиспользуются свободные индексы.
+        const size_type reused = (count < (size_type)mFree.size()) ? count : (size_type)mFree.size();
+        for(size_type i = 0; i < reused; ++i)
+        {
+            const uint32_t index = mFree[mFree.size() - 1 - i];
+            out[i] = entity(index, mGenerations[index]);
+            mAlive[index >> 6] |= uint64_t(1) << (index & 63);
+        }
+        mFree.resize(mFree.size() - reused);
+
+        // Остаток - непрерывный диапазон новых индексов.
+        const size_type fresh = count - reused;
+        if(fresh)
+        {
+            const size_type first = (size_type)mGenerations.size();
+            CORSAC_ASSERT((uint64_t)first + fresh < entity::npos);
+            mGenerations.resize(first + fresh, 0);
+            DoGrowMask(first + fresh);
+            DoSetAlive(first, first + fresh);
+            for(size_type i = 0; i < fresh; ++i)
+                out[reused + i] = entity(first + i, 0);
+        }
+        mAliveCount += count;
+    }
+
+    inline bool entity_manager::destroy(entity e)
+    {
+        return destroy(&e, 1) == 1;
+    }
+
+    inline entity_manager::size_type entity_manager::destroy(const entity* entities, size_type count)
+    {
+        mFree.reserve(mFree.size() + count);
+        size_type destroyed = 0;
+        for(size_type i = 0; i < count; ++i)
+        {
+            const entity e = entities[i];
+            if(!alive(e))
+                continue;
+            ++mGenerations[e.index];
+            mAlive[e.index >> 6] &= ~(uint64_t(1) << (e.index & 63));
+            mFree.push_back(e.index);
+            ++destroyed;
+        }
+        mAliveCount -= destroyed;
+        return destroyed;
+    }
+
+    inline entity entity_manager::at(size_type index) const noexcept
+    {
+        if(index >= mGenerations.size() || !(mAlive[index >> 6] & (uint64_t(1) << (index & 63))))
+            return entity();
+        return entity(index, mGenerations[index]);
+    }
+
+    inline void entity_manager::reserve(size_type n)
+    {
+        mGenerations.reserve(n);
+        mFree.reserve(n);
+        mAlive.reserve(((n + 63) / 64 + kMaskWordAlignment - 1) & ~(kMaskWordAlignment - 1));
+    }
+
+    inline void entity_manager::clear()
+    {
+        // Все сущности уничтожаются, поколения сохраняются, чтобы старые идентификаторы не ожили.
+        mFree.clear();
+        for(size_type index = (size_type)mGenerations.size(); index-- > 0;)
+        {
+            if(mAlive[index >> 6] & (uint64_t(1) << (index & 63)))
+                ++mGenerations[index];
+            mFree.push_back(index);
+        }
+        for(uint64_t& word : mAlive)
+            word = 0;
+        mAliveCount = 0;
+    }
+
+    template <typename Function>
+    inline void entity_manager::for_each_alive(Function function) const
+    {
+        for(size_type w = 0, words = (size_type)mAlive.size(); w < words; ++w)
+        {
+            for(uint64_t word = mAlive[w]; word; word &= word - 1)
+            {
+                const uint32_t index = (w << 6) + internal::count_trailing_zeros64(word);
+                function(entity(index, mGenerations[index]));
+            }
+        }
+    }
+
+    inline bool entity_manager::validate() const
+    {
+        size_type alive = 0;
+        for(uint64_t word : mAlive)
+        {
+            for(; word; word &= word - 1)
+                ++alive;
+        }
+        if(alive != mAliveCount || alive + mFree.size() != mGenerations.size())
+            return false;
+        return (mAlive.size() % kMaskWordAlignment) == 0;
+    }
+
+    inline void entity_manager::DoSetAlive(size_type first, size_type last)
+    {
+        // Целые слова заполняются за одну запись, частичные - маской.
+        while(first < last)
+        {
+            const size_type bit = first & 63;
+            const size_type n = ((last - first) < (64 - bit)) ? (last - first) : (64 - bit);
+            const uint64_t bits = (n == 64) ? ~uint64_t(0) : (((uint64_t(1) << n) - 1) << bit);
+            mAlive[first >> 6] |= bits;
+            first += n;
+        }
+    }
+
+    inline void entity_manager::DoGrowMask(size_type indexCount)
+    {
+        const size_type words = (((indexCount + 63) >> 6) + kMaskWordAlignment - 1) & ~(kMaskWordAlignment - 1);
+        if(words > mAlive.size())
+            mAlive.resize(words, 0);
+    }
+}
+
+#endif //CORSAC_STL_ENTITY_H
@@ -24,12 +24,20 @@
  *
  *      bad_function_call           Класс, который описывает исключение, указывающий, что вызов operator() в объекте-function завершился ошибкой, так как объект был пуст.
  *      function                    Класс, создающий оболочку для вызываемого объекта.
+ *      function_ref                Невладеющая ссылка на вызываемый объект, без выделения памяти.
  *      hash                        Класс, который вычисляет хэш-код для значения.
+ *      mixed_hash                  hash с перемешиванием битов для таблиц со степенью двойки корзин.
  *      reference_wrapper           Класс, который создает оболочку для ссылки.
+ *      unique_function             Только перемещаемая оболочка вызываемого объекта со встроенным буфером, без выделения памяти.
  *
  * === Функции:
  *
  *      cref                        Создает конструкцию reference_wrapper из аргумента.
+ *      hash_bytes                  Быстрый 64-битный хеш буфера произвольной длины (wyhash).
+ *      hash_combine                Добавляет хеш значения к хешу составного ключа.
+ *      hash_mix                    Перемешивает биты хеша (финализатор MurmurHash3).
+ *      hash_string                 constexpr-версия hash_bytes для строк.
+ *      hash_values                 Хеш набора значений.
  *      invoke                      Создает обобщенный оператор вызова функции, который работает с указателями функций, указателями функций-членов, вызываемыми объектами и указателями на элементы.
  *      mem_fn                      Создает простую оболочку вызова.
  *      not_fn                      Возвращает дополнение результата объекта функции.
@@ -76,6 +84,12 @@
 #include "Corsac/STL/functional_base.h"
 #include "Corsac/STL/mem_fn.h"
 
+#include <string.h>
+
+#if defined(CORSAC_COMPILER_MSVC) && defined(CORSAC_PROCESSOR_X86_64)
+    #include <intrin.h>
+#endif
+
 namespace corsac
 {
     // Primary C++ functions
@@ -477,6 +491,80 @@ namespace corsac
         return not_fn_ret<F>(corsac::forward<F>(f));
     }
 
+    /**
+    * function_ref
+    *
+    * Невладеющая ссылка на вызываемый объект: два указателя (объект и функция-переходник).
+    * Не выделяет память и не копирует вызываемый объект, вызов - один косвенный переход,
+    * как у указателя на функцию. Подходит для параметров функций-посетителей:
+    *
+    *      void for_each_entity(corsac::function_ref<void(Entity&)> visitor);
+    *      for_each_entity([&](Entity& e) { total += e.health; });
+    *
+    * Вызываемый объект должен жить дольше function_ref. Временный объект в аргументе функции
+    * живет до конца вызова, поэтому пример выше корректен, а сохранение function_ref в поле - нет.
+    */
+    template <typename>
+    class function_ref;
+
+    template <typename R, typename... Args>
+    class function_ref<R(Args...)>
+    {
+        template <typename Callable>
+        using valid_callable = corsac::enable_if_t<corsac::is_invocable_r_v<R, Callable&, Args...> &&
+                                                   !corsac::is_same_v<corsac::remove_cvref_t<Callable>, function_ref>>;
+
+    public:
+        using result_type = R;
+
+        template <typename Callable, typename = valid_callable<Callable>>
+        function_ref(Callable&& callable) noexcept
+        {
+            using callable_type = corsac::remove_reference_t<Callable>;
+            using decayed_type  = corsac::decay_t<Callable>;
+
+            if constexpr(corsac::is_pointer_v<decayed_type> && corsac::is_function_v<corsac::remove_pointer_t<decayed_type>>)
+            {
+                // Функция и указатель на функцию хранятся по значению: указатель на временный
+                // указатель (например, &foo) был бы недействителен.
+                const decayed_type function = callable;
+                CORSAC_ASSERT(function != nullptr);
+                mCallable.function = reinterpret_cast<void (*)()>(function);
+                mInvoke = [](Args... args, callable_storage storage) -> R
+                {
+                    return corsac::invoke(reinterpret_cast<decayed_type>(storage.function), corsac::forward<Args>(args)...);
+                };
+            }
+            else
+            {
+                mCallable.object = const_cast<void*>(static_cast<const void*>(corsac::addressof(callable)));
+                mInvoke = [](Args... args, callable_storage storage) -> R
+                {
+                    return corsac::invoke(*static_cast<callable_type*>(storage.object), corsac::forward<Args>(args)...);
+                };
+            }
+        }
+
+        function_ref(const function_ref&) noexcept = default;
+        function_ref& operator=(const function_ref&) noexcept = default;
+
+        R operator()(Args... args) const
+        {
+            return mInvoke(corsac::forward<Args>(args)..., mCallable);
+        }
+
+    private:
+        union callable_storage
+        {
+            void* object;
+            void (*function)();
+        };
+
+        // Порядок аргументов как у function_manager::Invoker: ссылка на объект последней.
+        callable_storage mCallable;
+        R (*mInvoke)(Args..., callable_storage);
+    };
+
     // hash
     namespace internal
     {
@@ -498,6 +586,7 @@ namespace corsac
     struct hash : internal::EnableHashIf<T, is_enum_v<T>> {};
 
     // Обратите внимание, что мы используем указатель как есть и не делим на sizeof(T). Это потому, что таблица имеет простой размер, и это деление не способствует распределению.
+    // Для таблиц со степенью двойки корзин используйте mixed_hash.
     template <typename T> struct hash<T*>
     { size_t operator()(T* p) const { return size_t(uintptr_t(p)); } };
 
@@ -566,6 +655,303 @@ namespace corsac
 #endif
 
 
+    /**
+    * mixed_hash
+    *
+    * Стандартные hash<T> для целых и указателей возвращают само значение. Для таблиц с простым
+    * числом корзин этого достаточно, но в таблицах со степенью двойки и открытой адресацией
+    * корзина берется из младших битов: выровненные указатели (младшие биты всегда нулевые) и
+    * последовательные идентификаторы сущностей тогда скапливаются в соседних корзинах.
+    *
+    * mixed_hash<T> - подключаемая по выбору альтернатива: значение пропускается через финализатор
+    * MurmurHash3 (fmix64), и каждый бит входа влияет на все биты результата. Для целых, перечислений
+    * и указателей перемешивается само значение, для чисел с плавающей точкой - их битовое
+    * представление (0.0 и -0.0 дают один хеш), для остальных типов - результат hash<T>.
+    *
+    * hash_mix       Финализатор MurmurHash3 (fmix64, на 32-битных платформах fmix32).
+    * hash_combine   Добавляет хеш значения к seed. Порядок важен: combine(a, b) != combine(b, a).
+    * hash_values    Хеш набора значений (составной ключ) через hash_combine.
+    *
+    * Пример использования:
+    *      corsac::hash_map<Entity*, Data, corsac::mixed_hash<Entity*>> map;
+    *
+    *      size_t seed = 0;
+    *      corsac::hash_combine(seed, key.chunk);
+    *      corsac::hash_combine(seed, key.index);
+    *      // или: size_t h = corsac::hash_values(key.chunk, key.index);
+    */
+    inline constexpr size_t hash_mix(size_t x) noexcept
+    {
+        if constexpr(sizeof(size_t) >= 8)
+        {
+            uint64_t h = static_cast<uint64_t>(x);
+            h ^= h >> 33;
+            h *= 0xff51afd7ed558ccdULL;
+            h ^= h >> 33;
+            h *= 0xc4ceb9fe1a85ec53ULL;
+            h ^= h >> 33;
+            return static_cast<size_t>(h);
+        }
+        else
+        {
+            uint32_t h = static_cast<uint32_t>(x);
+            h ^= h >> 16;
+            h *= 0x85ebca6bU;
+            h ^= h >> 13;
+            h *= 0xc2b2ae35U;
+            h ^= h >> 16;
+            return static_cast<size_t>(h);
+        }
+    }
+
+    namespace internal
+    {
+        // Значение, которое перемешивает mixed_hash: целое, перечисление, указатель, биты числа
+        // с плавающей точкой или hash<T> для прочих типов.
+        template <typename T>
+        inline size_t mixed_hash_input(const T& value) noexcept
+        {
+            if constexpr(is_integral_v<T> || is_enum_v<T>)
+                return static_cast<size_t>(static_cast<uint64_t>(value) ^ (sizeof(size_t) < 8 ? static_cast<uint64_t>(value) >> 32 : 0));
+            else if constexpr(is_pointer_v<T>)
+                return static_cast<size_t>(reinterpret_cast<uintptr_t>(value));
+            else if constexpr(is_same_v<T, float>)
+            {
+                uint32_t bits;
+                const float normalized = (value == 0.0f) ? 0.0f : value;
+                memcpy(&bits, &normalized, sizeof(bits));
+                return static_cast<size_t>(bits);
+            }
+            else if constexpr(is_same_v<T, double>)
+            {
+                uint64_t bits;
+                const double normalized = (value == 0.0) ? 0.0 : value;
+                memcpy(&bits, &normalized, sizeof(bits));
+                return static_cast<size_t>(bits ^ (sizeof(size_t) < 8 ? bits >> 32 : 0));
+            }
+            else
+                return hash<T>()(value);
+        }
+    }
+
+    template <typename T>
+    struct mixed_hash
+    {
+        size_t operator()(const T& value) const noexcept
+        {
+            return hash_mix(internal::mixed_hash_input(value));
+        }
+    };
+
+    template <typename T>
+    inline void hash_combine(size_t& seed, const T& value) noexcept
+    {
+        // Схема boost 1.81: сложение с золотым сечением и перемешивание всего seed.
+        seed = hash_mix(seed + static_cast<size_t>(0x9e3779b97f4a7c15ULL) + internal::mixed_hash_input(value));
+    }
+
+    template <typename... Ts>
+    inline size_t hash_values(const Ts&... values) noexcept
+    {
+        size_t seed = 0;
+        (hash_combine(seed, values), ...);
+        return seed;
+    }
+
+    /**
+    * hash_bytes
+    *
+    * Быстрый некриптографический 64-битный хеш произвольного буфера (wyhash, версия final4, Ван И).
+    * Длинные буферы обрабатываются по 48 байт за шаг тремя независимыми цепочками
+    * умножений 64x64->128, поэтому хеширование упирается в пропускную способность памяти,
+    * а не в задержку умножения. Буферы до 16 байт читаются двумя-четырьмя перекрывающимися
+    * загрузками без цикла.
+    *
+    * Результат одинаков на всех платформах (не зависит от размера size_t и порядка байтов)
+    * и может сохраняться в файлы. Для защиты от подобранных коллизий он не подходит.
+    *
+    * Пример использования:
+    *      uint64_t h = corsac::hash_bytes(path, strlen(path));
+    *      uint64_t h2 = corsac::hash_bytes(blob.data(), blob.size(), h); // Продолжение цепочки через seed.
+    */
+    namespace internal
+    {
+        inline constexpr uint64_t kWyhashSecret[4] = { 0x2d358dccaa6c78a5ULL, 0x8bb84b93962eacc9ULL,
+                                                       0x4b33a62ed433d4a3ULL, 0x4d5a2da51de1aa47ULL };
+
+        // 64x64->128: a получает младшую половину произведения, b - старшую.
+        inline constexpr void wyhash_mum_portable(uint64_t& a, uint64_t& b) noexcept
+        {
+            #if defined(__SIZEOF_INT128__)
+                const unsigned __int128 m = (unsigned __int128)a * b;
+                a = (uint64_t)m;
+                b = (uint64_t)(m >> 64);
+            #else
+                const uint64_t ha = a >> 32, hb = b >> 32, la = (uint32_t)a, lb = (uint32_t)b;
+                const uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+                const uint64_t t = rl + (rm0 << 32);
+                uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + (t < rl);
+                const uint64_t lo = t + (rm1 << 32);
+                hi += (lo < t);
+                a = lo;
+                b = hi;
+            #endif
+        }
+
+        // Чтение буфера в памяти: невыровненные загрузки через memcpy в порядке little-endian,
+        // чтобы результат не зависел от платформы.
+        struct wyhash_memory_reader
+        {
+            static void mum(uint64_t& a, uint64_t& b) noexcept
+            {
+                #if !defined(__SIZEOF_INT128__) && defined(CORSAC_COMPILER_MSVC) && defined(CORSAC_PROCESSOR_X86_64)
+                    a = _umul128(a, b, &b);
+                #else
+                    wyhash_mum_portable(a, b);
+                #endif
+            }
+
+            static uint64_t read8(const uint8_t* p) noexcept
+            {
+                uint64_t v;
+                memcpy(&v, p, sizeof(v));
+                #if defined(CORSAC_SYSTEM_BIG_ENDIAN)
+                    v = ((v >> 56) & 0xff) | ((v >> 40) & 0xff00) | ((v >> 24) & 0xff0000) | ((v >> 8) & 0xff000000) |
+                        ((v << 8) & 0xff00000000ULL) | ((v << 24) & 0xff0000000000ULL) | ((v << 40) & 0xff000000000000ULL) | (v << 56);
+                #endif
+                return v;
+            }
+
+            static uint64_t read4(const uint8_t* p) noexcept
+            {
+                uint32_t v;
+                memcpy(&v, p, sizeof(v));
+                #if defined(CORSAC_SYSTEM_BIG_ENDIAN)
+                    v = ((v >> 24) & 0xff) | ((v >> 8) & 0xff00) | ((v << 8) & 0xff0000) | (v << 24);
+                #endif
+                return v;
+            }
+
+            static uint64_t byte(const uint8_t* p) noexcept { return *p; }
+        };
+
+        // Чтение строки при вычислении на этапе компиляции: по байту, без memcpy.
+        struct wyhash_constexpr_reader
+        {
+            static constexpr void mum(uint64_t& a, uint64_t& b) noexcept
+            {
+                wyhash_mum_portable(a, b);
+            }
+
+            static constexpr uint64_t byte(const char* p) noexcept
+            {
+                return static_cast<uint8_t>(*p);
+            }
+
+            static constexpr uint64_t read8(const char* p) noexcept
+            {
+                uint64_t v = 0;
+                for(int i = 7; i >= 0; --i)
+                    v = (v << 8) | byte(p + i);
+                return v;
+            }
+
+            static constexpr uint64_t read4(const char* p) noexcept
+            {
+                return byte(p) | (byte(p + 1) << 8) | (byte(p + 2) << 16) | (byte(p + 3) << 24);
+            }
+        };
+
+        // wyhash
+        // Алгоритм wyhash final4. Reader определяет, как читаются байты и как умножаются 64-битные числа,
+        // поэтому hash_bytes и constexpr hash_string дают одинаковый результат.
+        template <typename Reader, typename Byte>
+        constexpr uint64_t wyhash(const Byte* p, size_t len, uint64_t seed) noexcept
+        {
+            const auto mix = [](uint64_t a, uint64_t b) constexpr
+            {
+                Reader::mum(a, b);
+                return a ^ b;
+            };
+
+            seed ^= mix(seed ^ kWyhashSecret[0], kWyhashSecret[1]);
+
+            uint64_t a = 0, b = 0;
+            if(CORSAC_LIKELY(len <= 16))
+            {
+                if(CORSAC_LIKELY(len >= 4))
+                {
+                    a = (Reader::read4(p) << 32) | Reader::read4(p + ((len >> 3) << 2));
+                    b = (Reader::read4(p + len - 4) << 32) | Reader::read4(p + len - 4 - ((len >> 3) << 2));
+                }
+                else if(CORSAC_LIKELY(len > 0))
+                {
+                    // 1..3 байта: первый, средний и последний (для len == 1 это один и тот же байт).
+                    a = (Reader::byte(p) << 16) | (Reader::byte(p + (len >> 1)) << 8) | Reader::byte(p + len - 1);
+                }
+            }
+            else
+            {
+                size_t i = len;
+                if(CORSAC_UNLIKELY(i >= 48))
+                {
+                    uint64_t see1 = seed, see2 = seed;
+                    do
+                    {
+                        seed = mix(Reader::read8(p) ^ kWyhashSecret[1], Reader::read8(p + 8) ^ seed);
+                        see1 = mix(Reader::read8(p + 16) ^ kWyhashSecret[2], Reader::read8(p + 24) ^ see1);
+                        see2 = mix(Reader::read8(p + 32) ^ kWyhashSecret[3], Reader::read8(p + 40) ^ see2);
+                        p += 48;
+                        i -= 48;
+                    } while(CORSAC_LIKELY(i >= 48));
+                    seed ^= see1 ^ see2;
+                }
+                while(CORSAC_UNLIKELY(i > 16))
+                {
+                    seed = mix(Reader::read8(p) ^ kWyhashSecret[1], Reader::read8(p + 8) ^ seed);
+                    i -= 16;
+                    p += 16;
+                }
+                // Последние 16 байт читаются с конца буфера и могут перекрываться с уже обработанными.
+                a = Reader::read8(p + i - 16);
+                b = Reader::read8(p + i - 8);
+            }
+
+            a ^= kWyhashSecret[1];
+            b ^= seed;
+            Reader::mum(a, b);
+            return mix(a ^ kWyhashSecret[0] ^ len, b ^ kWyhashSecret[1]);
+        }
+    }
+
+    inline uint64_t hash_bytes(const void* data, size_t len, uint64_t seed = 0) noexcept
+    {
+        return internal::wyhash<internal::wyhash_memory_reader>(static_cast<const uint8_t*>(data), len, seed);
+    }
+
+    /**
+    * hash_string
+    *
+    * Тот же хеш, что hash_bytes(str, len, seed), но вычисляемый на этапе компиляции.
+    * Во время выполнения для длинных строк быстрее hash_bytes.
+    *
+    * Пример использования:
+    *      static_assert(corsac::hash_string("Transform") == corsac::hash_string("Transform", 9));
+    *      CORSAC_ASSERT(corsac::hash_string("Transform") == corsac::hash_bytes("Transform", 9));
+    */
+    constexpr uint64_t hash_string(const char* str, size_t len, uint64_t seed = 0) noexcept
+    {
+        return internal::wyhash<internal::wyhash_constexpr_reader>(str, len, seed);
+    }
+
+    constexpr uint64_t hash_string(const char* str) noexcept
+    {
+        size_t len = 0;
+        while(str[len] != 0)
+            ++len;
+        return hash_string(str, len);
+    }
+
     /**
     * string hashes
     *
@@ -577,6 +963,7 @@ namespace corsac
     *      когда необходимо хешировать длинные строки. Действительно, пользователь,
     *      вероятно, может создать специальный хэш, настроенный для таких строк, который лучше,
      *     чем то, что мы предоставляем.
+    * Для длинных строк (пути ассетов, сериализованные данные) используйте hash_bytes.
     */
     template <> struct hash<char*>
     {
@@ -719,5 +1106,6 @@ namespace corsac
 }
 
 #include "Corsac/STL/function.h"
+#include "Corsac/STL/unique_function.h"
 
 #endif //CORSAC_STL_FUNCTIONAL_H
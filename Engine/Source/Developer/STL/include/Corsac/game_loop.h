@@ -0,0 +1,337 @@
+/**
+ * corsac::STL
+ *
+ * game_loop.h
+ *
+ * Created by Falldot on 18.10.2026.
+ * Copyright (c) 2021 Corsac. All rights reserved.
+ */
+#ifndef CORSAC_STL_GAME_LOOP_H
+#define CORSAC_STL_GAME_LOOP_H
+
+#pragma once
+/**
+ * Описание (Falldot 18.10.2026)
+ *
+ * Главный цикл с фиксированным шагом симуляции и ограничителем частоты кадров
+ * на основе corsac::chrono::steady_clock.
+ *
+ * Симуляция всегда продвигается на один и тот же шаг (fixed_timestep): прошедшее
+ * реальное время копится в аккумуляторе, и update вызывается столько раз, сколько
+ * целых шагов в нем набралось. Остаток шага отдается в render как alpha в [0, 1),
+ * чтобы отрисовка могла интерполировать между двумя последними состояниями.
+ *
+ * Защита от "спирали смерти" (каждый кадр требует больше шагов, чем успевает выполнить):
+ * время одного кадра ограничено maxFrameTime, а число шагов за кадр - maxSteps.
+ * Не отработанное время отбрасывается и учитывается в dropped_time().
+ *
+ * frame_pacer держит период кадра: большую часть ожидания поток спит короткими
+ * отрезками, а последние доли миллисекунды докручивает в цикле. Сколько спать можно
+ * безопасно, определяется по наблюдаемой точности сна (среднее плюс отклонение),
+ * поэтому на системах с грубым планировщиком цикл крутится дольше, а на точных почти
+ * не нагружает процессор. Дедлайны отсчитываются от предыдущего дедлайна, а не от
+ * текущего времени, поэтому частота не уплывает.
+ *
+ * ---------------------------------------------------------------------------------------------------
+ * === Классы:
+ *
+ *      fixed_timestep                  Аккумулятор фиксированного шага с ограничением спирали смерти.
+ *      frame_pacer                     Ограничитель частоты кадров: сон, затем активное ожидание.
+ *      game_loop                       Цикл: измерение кадра, шаги update, render(alpha), ожидание.
+ *
+ * Пример использования:
+ *      corsac::game_loop loop(corsac::chrono::milliseconds(10), corsac::chrono::microseconds(16667));
+ *      loop.run([&] { return !quit; },
+ *               [&](corsac::game_loop::duration step) { world.update(step); },
+ *               [&](double alpha) { renderer.draw(world, alpha); });
+ */
+
+#include "Corsac/STL/config.h"
+#include "Corsac/chrono.h"
+#include "Corsac/profiler.h"
+
+#include <math.h>
+
+#if defined(CORSAC_PLATFORM_POSIX)
+    #include <errno.h>
+    #include <time.h>
+#endif
+
+/**
+ * CORSAC_FRAME_PACER_SLEEP_NS
+ *
+ * Длительность одного отрезка сна frame_pacer в наносекундах.
+ */
+#ifndef CORSAC_FRAME_PACER_SLEEP_NS
+    #define CORSAC_FRAME_PACER_SLEEP_NS 1000000
+#endif
+
+namespace corsac
+{
+    namespace internal
+    {
+        // Засыпает примерно на ns наносекунд, фактическая длительность определяется планировщиком ОС.
+        inline void sleep_ns(int64_t ns)
+        {
+            if(ns <= 0)
+                return;
+
+            #if defined(CORSAC_PLATFORM_MICROSOFT)
+                Sleep((DWORD)((ns + 999999) / 1000000));
+            #elif defined(CORSAC_PLATFORM_POSIX)
+                timespec ts;
+                ts.tv_sec  = (time_t)(ns / 1000000000);
+                ts.tv_nsec = (long)(ns % 1000000000);
+                while(nanosleep(&ts, &ts) == -1 && errno == EINTR)
+                    ;
+            #endif
+        }
+
+        inline void cpu_relax() noexcept
+        {
+            #if CORSAC_SIMD_X86
+                _mm_pause();
+            #endif
+        }
+    }
+
+    /**
+     * fixed_timestep
+     *
+     * step         - длительность одного шага симуляции, больше нуля (иначе используется один такт часов);
+     * maxFrameTime - максимальное время кадра, которое учитывается (например, после остановки в отладчике);
+     * maxSteps     - максимальное число шагов за один кадр.
+     */
+    class fixed_timestep
+    {
+    public:
+        using clock    = chrono::steady_clock;
+        using duration = clock::duration;
+
+        explicit fixed_timestep(duration step, duration maxFrameTime = chrono::milliseconds(250), uint32_t maxSteps = 8)
+            : mStep(step.count() > 0 ? step : duration(1)), mMaxFrameTime(maxFrameTime), mMaxSteps(maxSteps)
+        {
+            // Неположительный шаг - ошибка вызывающего. В релизе он заменяется одним тактом часов,
+            // иначе advance и alpha делили бы на ноль, а отрицательный шаг выполнял бы maxSteps шагов каждый кадр.
+            CORSAC_ASSERT(step.count() > 0);
+        }
+
+        /**
+         * advance
+         *
+         * Добавляет frameTime в аккумулятор и вызывает update(step) для каждого набравшегося шага.
+         * Возвращает число выполненных шагов.
+         */
+        template <typename Update>
+        uint32_t advance(duration frameTime, Update&& update)
+        {
+            if(frameTime > mMaxFrameTime)
+            {
+                mDropped += frameTime - mMaxFrameTime;
+                frameTime = mMaxFrameTime;
+            }
+            mAccumulator += frameTime;
+
+            uint32_t steps = 0;
+            while(mAccumulator >= mStep)
+            {
+                if(steps == mMaxSteps)
+                {
+                    // Целые шаги, на которые не хватило кадра, отбрасываются, остаток сохраняется для alpha.
+                    const duration remainder = duration(mAccumulator.count() % mStep.count());
+                    mDropped    += mAccumulator - remainder;
+                    mAccumulator = remainder;
+                    break;
+                }
+
+                update(mStep);
+                mAccumulator -= mStep;
+                ++mTick;
+                ++steps;
+            }
+            return steps;
+        }
+
+        // Доля шага, прошедшая после последнего update, в [0, 1).
+        double alpha() const noexcept
+        {
+            return (double)mAccumulator.count() / (double)mStep.count();
+        }
+
+        duration step() const noexcept { return mStep; }
+        double step_seconds() const noexcept { return chrono::duration_cast<chrono::duration<double>>(mStep).count(); }
+        uint64_t tick() const noexcept { return mTick; }
+        duration dropped_time() const noexcept { return mDropped; }
+
+        void reset() noexcept
+        {
+            mAccumulator = duration::zero();
+            mDropped     = duration::zero();
+            mTick        = 0;
+        }
+
+    private:
+        duration mStep;
+        duration mMaxFrameTime;
+        uint32_t mMaxSteps;
+        duration mAccumulator = duration::zero();
+        duration mDropped     = duration::zero();
+        uint64_t mTick        = 0;
+    };
+
+    /**
+     * frame_pacer
+     *
+     * period - период кадра, нулевой период отключает ожидание.
+     */
+    class frame_pacer
+    {
+    public:
+        using clock      = chrono::steady_clock;
+        using duration   = clock::duration;
+        using time_point = clock::time_point;
+
+        explicit frame_pacer(duration period = duration::zero())
+            : mPeriod(period) {}
+
+        duration period() const noexcept { return mPeriod; }
+
+        void set_period(duration period) noexcept
+        {
+            mPeriod  = period;
+            mStarted = false;
+        }
+
+        // Оценка фактической длительности одного отрезка сна (среднее плюс стандартное отклонение).
+        duration sleep_estimate() const noexcept
+        {
+            return duration((long long)sleep_margin());
+        }
+
+        /**
+         * wait
+         *
+         * Ждет начала следующего кадра и возвращает его дедлайн. Если цикл отстал больше чем
+         * на период, дедлайн переносится на текущее время: пропущенные кадры не догоняются.
+         */
+        time_point wait()
+        {
+            const time_point now = clock::now();
+            if(mPeriod <= duration::zero())
+                return now;
+
+            if(!mStarted)
+            {
+                mStarted  = true;
+                mDeadline = now;
+                return now;
+            }
+
+            mDeadline += mPeriod;
+            if(now > mDeadline + mPeriod)
+            {
+                mDeadline = now;
+                return now;
+            }
+
+            sleep_until(mDeadline);
+            while(clock::now() < mDeadline)
+                internal::cpu_relax();
+            return mDeadline;
+        }
+
+    private:
+        // Спит отрезками, пока оставшееся время больше оценки затягивания одного отрезка.
+        void sleep_until(time_point deadline)
+        {
+            for(;;)
+            {
+                const time_point start     = clock::now();
+                const int64_t    remaining = (int64_t)(deadline - start).count();
+                if((double)remaining <= sleep_margin())
+                    return;
+
+                internal::sleep_ns(CORSAC_FRAME_PACER_SLEEP_NS);
+                update_estimate((double)(clock::now() - start).count());
+            }
+        }
+
+        // Экспоненциально сглаженные среднее и дисперсия: оценка подстраивается под изменения нагрузки.
+        void update_estimate(double observed) noexcept
+        {
+            const double weight = 1.0 / 16.0;
+            const double delta  = observed - mSleepMean;
+            mSleepMean     += weight * delta;
+            mSleepVariance  = (1.0 - weight) * (mSleepVariance + weight * delta * delta);
+        }
+
+        double sleep_margin() const noexcept
+        {
+            return mSleepMean + sqrt(mSleepVariance);
+        }
+
+        duration   mPeriod;
+        time_point mDeadline;
+        bool       mStarted       = false;
+        double     mSleepMean     = (double)CORSAC_FRAME_PACER_SLEEP_NS * 2.0; // Осторожная начальная оценка.
+        double     mSleepVariance = 0.0;
+    };
+
+    /**
+     * game_loop
+     *
+     * Связывает fixed_timestep и frame_pacer. Каждый кадр размечен зонами профилировщика.
+     */
+    class game_loop
+    {
+    public:
+        using clock      = chrono::steady_clock;
+        using duration   = clock::duration;
+        using time_point = clock::time_point;
+
+        explicit game_loop(duration step, duration framePeriod = duration::zero(),
+                           duration maxFrameTime = chrono::milliseconds(250), uint32_t maxSteps = 8)
+            : mTimestep(step, maxFrameTime, maxSteps), mPacer(framePeriod) {}
+
+        fixed_timestep& timestep() noexcept { return mTimestep; }
+        frame_pacer& pacer() noexcept { return mPacer; }
+
+        /**
+         * run
+         *
+         * Пока running() возвращает true: update(step) для каждого накопленного шага, затем
+         * render(alpha), затем ожидание следующего кадра. Для сервера без отрисовки render
+         * может ничего не делать, а период кадра - совпадать с шагом.
+         */
+        template <typename Running, typename Update, typename Render>
+        void run(Running&& running, Update&& update, Render&& render)
+        {
+            time_point previous = clock::now();
+            while(running())
+            {
+                CORSAC_PROFILE_FRAME("frame");
+
+                const time_point now = clock::now();
+                {
+                    CORSAC_PROFILE_SCOPE("update");
+                    mTimestep.advance(now - previous, update);
+                }
+                previous = now;
+                {
+                    CORSAC_PROFILE_SCOPE("render");
+                    render(mTimestep.alpha());
+                }
+                {
+                    CORSAC_PROFILE_SCOPE("wait");
+                    mPacer.wait();
+                }
+            }
+        }
+
+    private:
+        fixed_timestep mTimestep;
+        frame_pacer    mPacer;
+    };
+}
+
+#endif //CORSAC_STL_GAME_LOOP_H
@@ -367,7 +367,7 @@ namespace corsac
             template <typename T>
             static T* do_move_start(T* first, T* last, T* dest)
             {
-                return (T*)memcpy(dest, first, (size_t)((uintptr_t)last - (uintptr_t)first)) + (last - first);
+                return (T*)corsac::internal::fast_memcpy(dest, first, (size_t)((uintptr_t)last - (uintptr_t)first)) + (last - first);
             }
 
             template <typename T>
@@ -0,0 +1,491 @@
+/**
+ * corsac::STL
+ *
+ * profiler.h
+ *
+ * Created by Falldot on 18.10.2026.
+ * Copyright (c) 2021 Corsac. All rights reserved.
+ */
+#ifndef CORSAC_STL_PROFILER_H
+#define CORSAC_STL_PROFILER_H
+
+#pragma once
+/**
+ * Описание (Falldot 18.10.2026)
+ *
+ * Профилировщик кадра на основе зон (scoped zones) поверх corsac::chrono.
+ *
+ * Зона - это именованный интервал времени, который открывается конструктором profile_zone
+ * и закрывается его деструктором. Каждый поток пишет события в собственный буфер, поэтому
+ * запись зоны не берет блокировок и не выделяет память: два чтения счетчика тактов и
+ * одна запись в массив. Буфер потока создается при первой зоне в этом потоке и живет до
+ * конца работы профилировщика, так что события завершившихся потоков тоже попадают в отчет.
+ *
+ * Время измеряется в тактах chrono::tsc_clock::ticks() (rdtsc, если TSC инвариантен, иначе монотонные часы ОС).
+ * Перевод тактов в наносекунды калибруется по chrono::steady_clock: профилировщик запоминает
+ * пару (такты, steady_clock) при создании и вторую пару при калибровке, отношение разностей
+ * и есть длительность такта. Чем позже вызвана калибровка, тем она точнее.
+ *
+ * Результат выгружается в формате Chrome trace JSON (chrome://tracing, Perfetto, Speedscope):
+ * зоны - события "X", отметки кадра - глобальные мгновенные события "i", имена потоков - "M".
+ *
+ * ---------------------------------------------------------------------------------------------------
+ * === Классы:
+ *
+ *      profile_event                   Одно записанное событие: имя, начало и конец в тактах.
+ *      profile_thread_buffer           Буфер событий одного потока, один писатель и любое число читателей.
+ *      profiler                        Реестр буферов потоков, калибровка и выгрузка.
+ *      profile_zone                    RAII маркер зоны.
+ *
+ * === Макросы:
+ *
+ *      CORSAC_PROFILE_SCOPE(name)      Зона до конца текущей области видимости. name должен жить
+ *                                      до выгрузки (строковый литерал).
+ *      CORSAC_PROFILE_FUNCTION()       Зона с именем текущей функции.
+ *      CORSAC_PROFILE_FRAME(name)      Отметка границы кадра.
+ *      CORSAC_PROFILE_THREAD(name)     Имя текущего потока в отчете.
+ *
+ * Пример использования:
+ *      while(running)
+ *      {
+ *          CORSAC_PROFILE_FRAME("frame");
+ *          {
+ *              CORSAC_PROFILE_SCOPE("update");
+ *              update();
+ *          }
+ *          render();
+ *      }
+ *      corsac::profiler::get().write_chrome_trace("trace.json");
+ */
+
+#include "Corsac/STL/config.h"
+#include "Corsac/chrono.h"
+
+#include <stdio.h>
+#include <atomic>
+
+/**
+ * CORSAC_PROFILER_ENABLED
+ *
+ * При 0 макросы CORSAC_PROFILE_* не генерируют кода. Классы остаются доступны.
+ */
+#ifndef CORSAC_PROFILER_ENABLED
+    #define CORSAC_PROFILER_ENABLED 1
+#endif
+
+/**
+ * CORSAC_PROFILER_BUFFER_CAPACITY
+ *
+ * Число событий в буфере одного потока. Переполнившийся буфер отбрасывает новые события
+ * и считает их, число отброшенных событий попадает в отчет.
+ */
+#ifndef CORSAC_PROFILER_BUFFER_CAPACITY
+    #define CORSAC_PROFILER_BUFFER_CAPACITY (1 << 16)
+#endif
+
+/**
+ * CORSAC_PROFILER_MIN_CALIBRATION_NS
+ *
+ * Минимальный интервал между парами замеров для калибровки тактов. Если с момента создания
+ * профилировщика прошло меньше, calibrate() дожидается этого интервала.
+ */
+#ifndef CORSAC_PROFILER_MIN_CALIBRATION_NS
+    #define CORSAC_PROFILER_MIN_CALIBRATION_NS 10000000
+#endif
+
+namespace corsac
+{
+    namespace internal
+    {
+        inline uint64_t profiler_ticks() noexcept
+        {
+            return chrono::tsc_clock::ticks();
+        }
+
+        // Пара одновременных замеров тактов и steady_clock. Такты читаются до и после
+        // steady_clock и усредняются, чтобы уменьшить ошибку от длительности самого вызова.
+        struct profiler_time_pair
+        {
+            uint64_t ticks;
+            int64_t  ns;
+
+            static profiler_time_pair now() noexcept
+            {
+                const uint64_t before = profiler_ticks();
+                const int64_t  ns     = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+                const uint64_t after  = profiler_ticks();
+                return { before + (after - before) / 2, ns };
+            }
+        };
+    }
+
+    enum class profile_event_type : uint32_t
+    {
+        zone,
+        frame
+    };
+
+    struct profile_event
+    {
+        const char*        name;
+        uint64_t           begin;
+        uint64_t           end;
+        profile_event_type type;
+    };
+
+    /**
+     * profile_thread_buffer
+     *
+     * Писать может только поток-владелец. Опубликованные события (индексы меньше size())
+     * больше не изменяются до clear(), поэтому читать их можно из любого потока без блокировок.
+     *
+     * Поколение и размер хранятся в одном атомарном слове (поколение в старших 32 битах), чтобы
+     * читатель получал их согласованными одной загрузкой. После clear() владелец сначала
+     * публикует новое поколение с нулевым размером и только потом перезаписывает события, поэтому
+     * читатель, который скопировал событие и затем увидел прежнее поколение (read_event), знает,
+     * что копия не была перезаписана.
+     */
+    class profile_thread_buffer
+    {
+    public:
+        profile_thread_buffer(uint32_t threadId, size_t capacity, uint32_t generation)
+            : mEvents(new event_slot[capacity]), mCapacity(capacity), mState((uint64_t)generation << 32), mThreadId(threadId)
+        {
+            CORSAC_ASSERT(capacity <= UINT32_MAX);
+        }
+
+        ~profile_thread_buffer()
+        {
+            delete[] mEvents;
+        }
+
+        profile_thread_buffer(const profile_thread_buffer&) = delete;
+        profile_thread_buffer& operator=(const profile_thread_buffer&) = delete;
+
+        // generation - текущее поколение профилировщика. Если оно сменилось (был вызван clear()),
+        // владелец сам обнуляет свой буфер перед записью.
+        void push(profile_event_type type, const char* name, uint64_t begin, uint64_t end, uint32_t generation) noexcept
+        {
+            uint64_t state = mState.load(std::memory_order_relaxed);
+            if(CORSAC_UNLIKELY((uint32_t)(state >> 32) != generation))
+            {
+                // Новое поколение с нулевым размером видно раньше, чем перезаписанные события:
+                // барьер не дает записям событий подняться выше этой публикации.
+                state = (uint64_t)generation << 32;
+                mState.store(state, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+                mDropped.store(0, std::memory_order_relaxed);
+            }
+
+            const size_t size = (uint32_t)state;
+            if(CORSAC_UNLIKELY(size == mCapacity))
+            {
+                mDropped.store(mDropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                return;
+            }
+
+            event_slot& slot = mEvents[size];
+            slot.name.store(name, std::memory_order_relaxed);
+            slot.begin.store(begin, std::memory_order_relaxed);
+            slot.end.store(end, std::memory_order_relaxed);
+            slot.type.store(type, std::memory_order_relaxed);
+            mState.store(state + 1, std::memory_order_release);
+        }
+
+        // Поколение в старших 32 битах, число опубликованных событий - в младших.
+        uint64_t state() const noexcept { return mState.load(std::memory_order_acquire); }
+        size_t size() const noexcept { return (uint32_t)state(); }
+        uint32_t generation() const noexcept { return (uint32_t)(state() >> 32); }
+        size_t capacity() const noexcept { return mCapacity; }
+        size_t dropped() const noexcept { return mDropped.load(std::memory_order_relaxed); }
+
+        // Для потока-владельца или когда владелец не пишет.
+        profile_event operator[](size_t i) const noexcept { return mEvents[i].load(); }
+
+        /**
+         * read_event
+         *
+         * Копирует событие i для чтения из чужого потока. generation - поколение из state(), по
+         * которому получен размер. Возвращает false, если владелец уже начал новое поколение:
+         * копия могла быть перезаписана и должна быть отброшена вместе с остальными событиями.
+         */
+        bool read_event(size_t i, uint32_t generation, profile_event& out) const noexcept
+        {
+            out = mEvents[i].load();
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return (uint32_t)(mState.load(std::memory_order_relaxed) >> 32) == generation;
+        }
+
+        uint32_t thread_id() const noexcept { return mThreadId; }
+        const char* thread_name() const noexcept { return mThreadName.load(std::memory_order_acquire); }
+        void set_thread_name(const char* name) noexcept { mThreadName.store(name, std::memory_order_release); }
+
+        profile_thread_buffer* next = nullptr; // Следующий буфер в списке профилировщика.
+
+    private:
+        // Поля события атомарны: read_event читает слот, который владелец может перезаписывать
+        // после clear(). Расслабленные загрузки и записи не дороже обычных.
+        struct event_slot
+        {
+            std::atomic<const char*>        name;
+            std::atomic<uint64_t>           begin;
+            std::atomic<uint64_t>           end;
+            std::atomic<profile_event_type> type;
+
+            profile_event load() const noexcept
+            {
+                return { name.load(std::memory_order_relaxed), begin.load(std::memory_order_relaxed),
+                         end.load(std::memory_order_relaxed), type.load(std::memory_order_relaxed) };
+            }
+        };
+
+        event_slot*               mEvents;
+        size_t                    mCapacity;
+        std::atomic<uint64_t>     mState;
+        std::atomic<size_t>       mDropped{0};
+        uint32_t                  mThreadId;
+        std::atomic<const char*>  mThreadName{nullptr};
+    };
+
+    class profiler
+    {
+    public:
+        static profiler& get()
+        {
+            static profiler instance;
+            return instance;
+        }
+
+        profiler(const profiler&) = delete;
+        profiler& operator=(const profiler&) = delete;
+
+        ~profiler()
+        {
+            profile_thread_buffer* buffer = mBuffers.load(std::memory_order_acquire);
+            while(buffer)
+            {
+                profile_thread_buffer* next = buffer->next;
+                delete buffer;
+                buffer = next;
+            }
+        }
+
+        bool enabled() const noexcept { return mEnabled.load(std::memory_order_relaxed); }
+        void set_enabled(bool enabled) noexcept { mEnabled.store(enabled, std::memory_order_relaxed); }
+
+        uint32_t generation() const noexcept { return mGeneration.load(std::memory_order_relaxed); }
+
+        /**
+         * thread_buffer
+         *
+         * Буфер текущего потока. При первом вызове в потоке буфер создается и добавляется
+         * в список без блокировок.
+         */
+        profile_thread_buffer* thread_buffer()
+        {
+            static thread_local profile_thread_buffer* buffer = nullptr;
+            if(CORSAC_UNLIKELY(!buffer))
+            {
+                buffer = new profile_thread_buffer(mThreadCount.fetch_add(1, std::memory_order_relaxed), CORSAC_PROFILER_BUFFER_CAPACITY, generation());
+                buffer->next = mBuffers.load(std::memory_order_relaxed);
+                while(!mBuffers.compare_exchange_weak(buffer->next, buffer, std::memory_order_release, std::memory_order_relaxed))
+                    ;
+            }
+            return buffer;
+        }
+
+        const profile_thread_buffer* first_buffer() const noexcept { return mBuffers.load(std::memory_order_acquire); }
+
+        void set_thread_name(const char* name)
+        {
+            thread_buffer()->set_thread_name(name);
+        }
+
+        void frame_mark(const char* name = "frame")
+        {
+            if(enabled())
+            {
+                const uint64_t ticks = internal::profiler_ticks();
+                thread_buffer()->push(profile_event_type::frame, name, ticks, ticks, generation());
+            }
+        }
+
+        /**
+         * clear
+         *
+         * Отбрасывает записанные события. Каждый буфер очищается своим потоком при следующей
+         * записи, поэтому clear() не гонится с писателями. Выгрузка, которая выполняется
+         * одновременно с clear(), выводит только часть старых событий буфера, но не его новые
+         * события и не перезаписанные.
+         */
+        void clear() noexcept
+        {
+            mGeneration.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /**
+         * calibrate
+         *
+         * Пересчитывает длительность такта по steady_clock и возвращает ее в наносекундах.
+         */
+        double calibrate()
+        {
+            internal::profiler_time_pair now = internal::profiler_time_pair::now();
+            while(now.ns - mOrigin.ns < CORSAC_PROFILER_MIN_CALIBRATION_NS)
+                now = internal::profiler_time_pair::now();
+
+            if(now.ticks != mOrigin.ticks)
+                mNsPerTick = (double)(now.ns - mOrigin.ns) / (double)(now.ticks - mOrigin.ticks);
+            return mNsPerTick;
+        }
+
+        double ns_per_tick() const noexcept { return mNsPerTick; }
+
+        // Время в наносекундах от создания профилировщика, по последней калибровке.
+        double ticks_to_ns(uint64_t ticks) const noexcept
+        {
+            return (double)(int64_t)(ticks - mOrigin.ticks) * mNsPerTick;
+        }
+
+        /**
+         * write_chrome_trace
+         *
+         * Калибрует такты и записывает все опубликованные события в формате Chrome trace JSON.
+         * Записывающие потоки не останавливаются: события, закрытые после начала выгрузки,
+         * могут не попасть в отчет.
+         */
+        bool write_chrome_trace(FILE* file)
+        {
+            if(!file)
+                return false;
+
+            calibrate();
+
+            size_t dropped = 0;
+            bool   first   = true;
+            fprintf(file, "{\"traceEvents\":[");
+            for(const profile_thread_buffer* buffer = first_buffer(); buffer; buffer = buffer->next)
+            {
+                const uint32_t tid = buffer->thread_id();
+
+                fprintf(file, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", first ? "" : ",", tid);
+                if(const char* name = buffer->thread_name())
+                    write_escaped(file, name);
+                else
+                    fprintf(file, "\"thread %u\"", tid);
+                fprintf(file, "}}");
+                first = false;
+
+                // Буфер, который еще не очистился после clear(), считается пустым. Поколение и
+                // размер берутся одной загрузкой; если владелец очистит буфер во время выгрузки,
+                // read_event это заметит, и оставшиеся события старого поколения пропускаются.
+                const uint64_t state = buffer->state();
+                const uint32_t bufferGeneration = (uint32_t)(state >> 32);
+                if(bufferGeneration != generation())
+                    continue;
+
+                dropped += buffer->dropped();
+                const size_t size = (uint32_t)state;
+                profile_event event;
+                for(size_t i = 0; i < size && buffer->read_event(i, bufferGeneration, event); ++i)
+                {
+                    fprintf(file, ",\n{\"name\":");
+                    write_escaped(file, event.name);
+                    if(event.type == profile_event_type::frame)
+                        fprintf(file, ",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":%u,\"ts\":%.3f}", tid, ticks_to_ns(event.begin) / 1000.0);
+                    else
+                        fprintf(file, ",\"cat\":\"corsac\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                                tid, ticks_to_ns(event.begin) / 1000.0, (double)(event.end - event.begin) * mNsPerTick / 1000.0);
+                }
+            }
+            fprintf(file, "\n],\"displayTimeUnit\":\"ns\",\"otherData\":{\"ns_per_tick\":%.6f,\"dropped_events\":%zu}}\n", mNsPerTick, dropped);
+            return !ferror(file);
+        }
+
+        bool write_chrome_trace(const char* path)
+        {
+            FILE* file = fopen(path, "w");
+            if(!file)
+                return false;
+
+            const bool result = write_chrome_trace(file);
+            return (fclose(file) == 0) && result;
+        }
+
+    private:
+        profiler()
+            : mOrigin(internal::profiler_time_pair::now()) {}
+
+        static void write_escaped(FILE* file, const char* s)
+        {
+            fputc('"', file);
+            for(; *s; ++s)
+            {
+                const unsigned char c = (unsigned char)*s;
+                if(c == '"' || c == '\\')
+                    fprintf(file, "\\%c", c);
+                else if(c < 0x20)
+                    fprintf(file, "\\u%04x", c);
+                else
+                    fputc(c, file);
+            }
+            fputc('"', file);
+        }
+
+        std::atomic<profile_thread_buffer*> mBuffers{nullptr};
+        std::atomic<uint32_t>               mThreadCount{0};
+        std::atomic<uint32_t>               mGeneration{0};
+        std::atomic<bool>                   mEnabled{true};
+        internal::profiler_time_pair        mOrigin;
+        double                              mNsPerTick = 1.0;
+    };
+
+    /**
+     * profile_zone
+     *
+     * Записывает зону в буфер текущего потока при выходе из области видимости.
+     * Если профилировщик выключен в момент открытия зоны, зона ничего не пишет.
+     */
+    class profile_zone
+    {
+    public:
+        explicit profile_zone(const char* name) noexcept
+            : mName(name)
+        {
+            profiler& p = profiler::get();
+            mBuffer = p.enabled() ? p.thread_buffer() : nullptr;
+            mBegin  = mBuffer ? internal::profiler_ticks() : 0;
+        }
+
+        ~profile_zone()
+        {
+            if(mBuffer)
+                mBuffer->push(profile_event_type::zone, mName, mBegin, internal::profiler_ticks(), profiler::get().generation());
+        }
+
+        profile_zone(const profile_zone&) = delete;
+        profile_zone& operator=(const profile_zone&) = delete;
+
+    private:
+        const char*            mName;
+        profile_thread_buffer* mBuffer;
+        uint64_t               mBegin;
+    };
+}
+
+#define CORSAC_PROFILE_CONCAT_IMPL(a, b) a##b
+#define CORSAC_PROFILE_CONCAT(a, b) CORSAC_PROFILE_CONCAT_IMPL(a, b)
+
+#if CORSAC_PROFILER_ENABLED
+    #define CORSAC_PROFILE_SCOPE(name)  corsac::profile_zone CORSAC_PROFILE_CONCAT(corsacProfileZone, __LINE__)(name)
+    #define CORSAC_PROFILE_FUNCTION()   CORSAC_PROFILE_SCOPE(__func__)
+    #define CORSAC_PROFILE_FRAME(name)  corsac::profiler::get().frame_mark(name)
+    #define CORSAC_PROFILE_THREAD(name) corsac::profiler::get().set_thread_name(name)
+#else
+    #define CORSAC_PROFILE_SCOPE(name)  ((void)0)
+    #define CORSAC_PROFILE_FUNCTION()   ((void)0)
+    #define CORSAC_PROFILE_FRAME(name)  ((void)0)
+    #define CORSAC_PROFILE_THREAD(name) ((void)0)
+#endif
+
+#endif //CORSAC_STL_PROFILER_H
@@ -0,0 +1,340 @@
+/**
+ * corsac::STL
+ *
+ * query.h
+ *
+ * Created by Falldot on 18.10.2026.
+ * Copyright (c) 2021 Corsac. All rights reserved.
+ */
+#ifndef CORSAC_STL_QUERY_H
+#define CORSAC_STL_QUERY_H
+
+#pragma once
+/**
+ * Описание (Falldot 18.10.2026)
+ *
+ * query<Ts...> - кэшированный запрос к world: все сущности, у которых есть компоненты Ts...
+ * и нет исключенных компонентов.
+ *
+ * Запрос хранит список подходящих архетипов и для каждого - заранее найденные номера колонок Ts...
+ * Архетипы мира никогда не удаляются и получают номера по порядку создания, поэтому update()
+ * проверяет сигнатуры (component_mask, битовая маска фиксированной ширины) только у архетипов,
+ * созданных после прошлого обновления. Если новых архетипов нет, update() - одно сравнение.
+ *
+ * Обход идет по архетипам, внутри архетипа - по столбцам: each_chunk передает функции указатели
+ * на колонки и число строк, each и each_entity - обычный цикл по строкам поверх тех же указателей.
+ *
+ * const T в Ts... - доступ только для чтения. Неконстантные компоненты обойденных строк помечаются
+ * измененными тактом обхода (см. world::change_tick).
+ *
+ * Фильтры changed<T> и added<T> вместо T оставляют строки, в которых T изменен (добавлен) после
+ * прошлого обхода этого запроса; при нескольких фильтрах должны выполняться все. Сначала проверяется
+ * такт куска из CORSAC_WORLD_CHUNK_ROWS строк: неизмененный кусок пропускается целиком. each_chunk
+ * получает подряд идущие подходящие строки, поэтому при фильтрах вызывается по несколько раз на архетип.
+ * Первый обход видит все строки.
+ *
+ * Пример использования:
+ *      corsac::query<Position, const Velocity> moving(world);
+ *      moving.each([dt](Position& p, const Velocity& v) { p.x += v.x * dt; });
+ *
+ *      corsac::query<Position> statics(world, corsac::component_mask::of<Velocity>()); // Без Velocity.
+ *      statics.each_chunk([](uint32_t count, Position* p) { ... });
+ *
+ *      corsac::query<corsac::changed<const Transform>> upload(world);
+ *      upload.each([](const Transform& t) { ... });                          // Только измененные.
+ */
+
+#include "Corsac/STL/config.h"
+#include "Corsac/world.h"
+#include "Corsac/tuple.h"
+#include "Corsac/utility.h"
+
+namespace corsac
+{
+    // Фильтры запроса: компонент T, измененный или добавленный после прошлого обхода.
+    template <typename T> struct changed {};
+    template <typename T> struct added {};
+
+    enum class query_filter : uint32_t
+    {
+        none,
+        changed,
+        added
+    };
+
+    // Элемент Ts... запроса: тип компонента (с const) и фильтр.
+    template <typename T>
+    struct query_term
+    {
+        using type = T;
+        static constexpr query_filter filter = query_filter::none;
+    };
+
+    template <typename T>
+    struct query_term<changed<T>>
+    {
+        using type = T;
+        static constexpr query_filter filter = query_filter::changed;
+    };
+
+    template <typename T>
+    struct query_term<added<T>>
+    {
+        using type = T;
+        static constexpr query_filter filter = query_filter::added;
+    };
+
+    template <typename T>
+    using query_term_t = typename query_term<T>::type;
+
+    template <typename... Ts>
+    class query
+    {
+        static_assert(sizeof...(Ts) > 0, "query must request at least one component.");
+
+        static constexpr uint32_t     kTermCount   = sizeof...(Ts);
+        static constexpr uint32_t     kFilterCount = (0 + ... + (query_term<Ts>::filter != query_filter::none ? 1 : 0));
+        static constexpr query_filter kFilters[]   = { query_term<Ts>::filter... };
+        static constexpr bool         kWritable[]  = { !is_const_v<query_term_t<Ts>>... };
+
+    public:
+        struct match
+        {
+            archetype* target;
+            uint32_t   columns[kTermCount];
+        };
+
+        explicit query(world& w, const component_mask& excluded = component_mask());
+
+        // Дополняет кэш архетипами, созданными после прошлого вызова. each* вызывают его сами.
+        void update();
+
+        // Типы параметров - query_term_t<Ts>: changed<const T> передается как const T&.
+        // function(Ts&...) для каждой сущности.
+        template <typename Function>
+        void each(Function function);
+
+        // function(entity, Ts&...) для каждой сущности.
+        template <typename Function>
+        void each_entity(Function function);
+
+        // function(uint32_t count, Ts*...) для каждого непустого архетипа или, с фильтрами, для каждого
+        // отрезка подходящих строк.
+        template <typename Function>
+        void each_chunk(Function function);
+
+        // Число сущностей с компонентами запроса, без учета фильтров.
+        uint32_t size();
+
+        // Такт прошлого обхода: фильтры пропускают строки с тактом не больше него.
+        uint32_t last_run() const noexcept { return mLastRun; }
+
+        uint32_t archetype_count() const noexcept { return (uint32_t)mMatches.size(); }
+        const match* matches() const noexcept { return mMatches.data(); }
+
+        const component_mask& required() const noexcept { return mRequired; }
+        const component_mask& excluded() const noexcept { return mExcluded; }
+
+    protected:
+        // callback(archetype&, const match&, uint32_t first, uint32_t count) для отрезков строк,
+        // прошедших фильтры. Обход занимает такт мира.
+        template <typename Callback>
+        void DoEachRun(Callback callback);
+
+        bool DoRowPasses(const uint32_t* const* ticks, uint32_t row) const noexcept;
+        void DoMarkChanged(archetype& a, const match& m, uint32_t first, uint32_t count, uint32_t tick) const noexcept;
+
+        template <typename Function, size_t... I>
+        void DoEachChunk(Function& function, index_sequence<I...>);
+
+        template <typename Function, size_t... I>
+        void DoEachEntity(Function& function, index_sequence<I...>);
+
+        world*         mWorld;
+        component_mask mRequired;
+        component_mask mExcluded;
+        component_id   mIds[sizeof...(Ts)];
+        vector<match>  mMatches;
+        uint32_t       mArchetypesSeen = 0;
+        uint32_t       mLastRun = 0;
+    };
+
+    template <typename... Ts>
+    inline query<Ts...>::query(world& w, const component_mask& excluded)
+        : mWorld(&w), mRequired(component_mask::of<query_term_t<Ts>...>()), mExcluded(excluded), mIds{ component_type_id<query_term_t<Ts>>()... },
+          mMatches(CORSAC_WORLD_DEFAULT_ALLOCATOR)
+    {
+        CORSAC_ASSERT_MSG(mRequired.count() == kTermCount, "query: duplicate component types.");
+    }
+
+    template <typename... Ts>
+    inline void query<Ts...>::update()
+    {
+        const uint32_t count = mWorld->archetype_count();
+        for(; mArchetypesSeen < count; ++mArchetypesSeen)
+        {
+            archetype& a = mWorld->archetype_at(mArchetypesSeen);
+            if(!a.mask().contains(mRequired) || a.mask().intersects(mExcluded))
+                continue;
+
+            match m;
+            m.target = &a;
+            for(uint32_t i = 0; i < kTermCount; ++i)
+                m.columns[i] = a.column_index(mIds[i]);
+            mMatches.push_back(m);
+        }
+    }
+
+    template <typename... Ts>
+    template <typename Function>
+    inline void query<Ts...>::each(Function function)
+    {
+        each_chunk([&function](uint32_t count, query_term_t<Ts>*... columns)
+        {
+            for(uint32_t i = 0; i < count; ++i)
+                function(columns[i]...);
+        });
+    }
+
+    template <typename... Ts>
+    template <typename Function>
+    inline void query<Ts...>::each_entity(Function function)
+    {
+        DoEachEntity(function, index_sequence_for<Ts...>());
+    }
+
+    template <typename... Ts>
+    template <typename Function>
+    inline void query<Ts...>::each_chunk(Function function)
+    {
+        DoEachChunk(function, index_sequence_for<Ts...>());
+    }
+
+    template <typename... Ts>
+    inline uint32_t query<Ts...>::size()
+    {
+        update();
+        uint32_t n = 0;
+        for(const match& m : mMatches)
+            n += m.target->size();
+        return n;
+    }
+
+    template <typename... Ts>
+    template <typename Callback>
+    inline void query<Ts...>::DoEachRun(Callback callback)
+    {
+        update();
+        const uint32_t thisRun = mWorld->advance_tick();
+        for(const match& m : mMatches)
+        {
+            archetype& a = *m.target;
+            const uint32_t count = a.size();
+            if(!count)
+                continue;
+
+            if constexpr(kFilterCount == 0)
+            {
+                callback(a, m, 0, count);
+                DoMarkChanged(a, m, 0, count, thisRun);
+            }
+            else
+            {
+                const uint32_t* rowTicks[kFilterCount];
+                const uint32_t* chunkTicks[kFilterCount];
+                for(uint32_t i = 0, f = 0; i < kTermCount; ++i)
+                {
+                    if(kFilters[i] == query_filter::changed)
+                    {
+                        rowTicks[f]     = a.changed_ticks(m.columns[i]);
+                        chunkTicks[f++] = a.chunk_changed_ticks(m.columns[i]);
+                    }
+                    else if(kFilters[i] == query_filter::added)
+                    {
+                        rowTicks[f]     = a.added_ticks(m.columns[i]);
+                        chunkTicks[f++] = a.chunk_added_ticks(m.columns[i]);
+                    }
+                }
+
+                // Отрезок [runFirst, runLast) продолжается через границы кусков, пока строки идут подряд.
+                uint32_t runFirst = 0, runLast = 0;
+                for(uint32_t chunkFirst = 0; chunkFirst < count; chunkFirst += archetype::kChunkRows)
+                {
+                    if(!DoRowPasses(chunkTicks, chunkFirst / archetype::kChunkRows))
+                        continue;
+
+                    const uint32_t chunkLast = (count - chunkFirst < archetype::kChunkRows) ? count : chunkFirst + archetype::kChunkRows;
+                    for(uint32_t row = chunkFirst; row < chunkLast; ++row)
+                    {
+                        if(!DoRowPasses(rowTicks, row))
+                            continue;
+                        if(row != runLast)
+                        {
+                            if(runLast != runFirst)
+                            {
+                                callback(a, m, runFirst, runLast - runFirst);
+                                DoMarkChanged(a, m, runFirst, runLast - runFirst, thisRun);
+                            }
+                            runFirst = row;
+                        }
+                        runLast = row + 1;
+                    }
+                }
+                if(runLast != runFirst)
+                {
+                    callback(a, m, runFirst, runLast - runFirst);
+                    DoMarkChanged(a, m, runFirst, runLast - runFirst, thisRun);
+                }
+            }
+        }
+        mWorld->advance_tick();
+        mLastRun = thisRun;
+    }
+
+    template <typename... Ts>
+    inline bool query<Ts...>::DoRowPasses(const uint32_t* const* ticks, uint32_t row) const noexcept
+    {
+        for(uint32_t f = 0; f < kFilterCount; ++f)
+        {
+            if(ticks[f][row] <= mLastRun)
+                return false;
+        }
+        return true;
+    }
+
+    template <typename... Ts>
+    inline void query<Ts...>::DoMarkChanged(archetype& a, const match& m, uint32_t first, uint32_t count, uint32_t tick) const noexcept
+    {
+        for(uint32_t i = 0; i < kTermCount; ++i)
+        {
+            if(kWritable[i])
+                a.mark_changed(m.columns[i], first, count, tick);
+        }
+    }
+
+    template <typename... Ts>
+    template <typename Function, size_t... I>
+    inline void query<Ts...>::DoEachChunk(Function& function, index_sequence<I...>)
+    {
+        // Указатели на колонки берутся заново для каждого отрезка: архетип мог вырасти.
+        DoEachRun([&function](archetype& a, const match& m, uint32_t first, uint32_t count)
+        {
+            function(count, (static_cast<query_term_t<Ts>*>(a.DoColumnData(m.columns[I])) + first)...);
+        });
+    }
+
+    template <typename... Ts>
+    template <typename Function, size_t... I>
+    inline void query<Ts...>::DoEachEntity(Function& function, index_sequence<I...>)
+    {
+        DoEachRun([&function](archetype& a, const match& m, uint32_t first, uint32_t count)
+        {
+            const entity* entities = a.entities();
+            const auto columns = make_tuple(static_cast<query_term_t<Ts>*>(a.DoColumnData(m.columns[I]))...);
+            for(uint32_t i = first, last = first + count; i < last; ++i)
+                function(entities[i], get<I>(columns)[i]...);
+        });
+    }
+}
+
+#endif //CORSAC_STL_QUERY_H
@@ -12,10 +12,675 @@
 #pragma once
 
 #include "Corsac/STL/config.h"
+#include "Corsac/STL/cpu_info.h"
+#include "Corsac/type_traits.h"
 #include "Corsac/numeric_limits.h"
+#include "Corsac/initializer_list.h"
+
+#include <math.h>
+#include <string.h>
+
+#if defined(CORSAC_COMPILER_MSVC) && defined(CORSAC_PROCESSOR_X86_64)
+    #include <intrin.h>
+#endif
+
+/**
+ * Описание (Falldot 18.10.2026)
+ *
+ * Генераторы псевдослучайных чисел и распределения.
+ *
+ * Генераторы удовлетворяют требованиям UniformRandomBitGenerator: result_type, min(), max(), operator().
+ * Все они малы (8-32 байта состояния), не выделяют память и работают в несколько раз быстрее
+ * std::mt19937. Они не криптостойкие.
+ *
+ * Для независимых потоков (например, по одному на рабочий поток) генератор копируется,
+ * и копия сдвигается: jump() у xoshiro256starstar пропускает 2^128 значений, long_jump() - 2^192.
+ * У pcg32 потоки задаются вторым аргументом конструктора, а advance(n) пропускает n значений за O(log n).
+ *
+ * ---------------------------------------------------------------------------------------------------
+ * === Генераторы:
+ *
+ *      splitmix64                      64 бита состояния. Используется для заполнения состояния других генераторов из одного числа.
+ *      xoshiro256starstar              256 бит состояния, период 2^256 - 1, jump() / long_jump(). Генератор по умолчанию.
+ *      pcg32                           32-битный выход, 64 бита состояния и номер потока (2^63 потоков).
+ *      default_random_engine           xoshiro256starstar.
+ *      xoshiro256starstar_x4           Четыре потока xoshiro256** в одном объекте, пакетная генерация на AVX2.
+ *
+ * === Распределения:
+ *
+ *      uniform_int_distribution        Равномерное распределение целых чисел в [a, b].
+ *      uniform_real_distribution       Равномерное распределение чисел с плавающей точкой в [a, b).
+ *      normal_distribution             Нормальное распределение, метод зиккурата (128 слоев).
+ *      bernoulli_distribution          true с вероятностью p.
+ *      discrete_distribution           Исход i с вероятностью w[i] / sum(w), выборка за O(1) по таблице псевдонимов.
+ *
+ * === Функции:
+ *
+ *      generate_canonical              Равномерное число с плавающей точкой в [0, 1) из битов генератора.
+ *      generate                        Заполняет диапазон значениями распределения. Распределения с методом
+ *                                      generate(first, last, g) заполняют его пакетно.
+ *
+ * Целые числа в диапазоне строятся методом Лемира (умножение вместо деления, деление только
+ * в редком случае отбраковки), числа с плавающей точкой - записью случайных битов в мантиссу.
+ * Генератор должен выдавать равномерные биты во всем диапазоне result_type (min() == 0,
+ * max() - все единицы), как все генераторы этого файла.
+ *
+ * Пример использования:
+ *      corsac::xoshiro256starstar rng(seed);
+ *      corsac::xoshiro256starstar workerRng = rng;
+ *      workerRng.jump(); // Последовательность workerRng не пересекается с rng.
+ *
+ *      corsac::uniform_int_distribution<uint32_t> dice(1, 6);
+ *      uint32_t roll = dice(rng);
+ *
+ *      corsac::discrete_distribution<int> loot({ 70.0, 25.0, 4.5, 0.5 }); // Обычный, редкий, эпический, легендарный.
+ *      int rarity = loot(rng);
+ */
 
 namespace corsac
 {
+    namespace internal
+    {
+        inline constexpr uint64_t rotl64(uint64_t x, int k) noexcept
+        {
+            return (x << k) | (x >> (64 - k));
+        }
+
+        // Возвращает младшие 64 бита произведения, старшие пишет в hi.
+        inline uint64_t mul128(uint64_t a, uint64_t b, uint64_t& hi) noexcept
+        {
+            #if defined(__SIZEOF_INT128__)
+                const unsigned __int128 m = (unsigned __int128)a * b;
+                hi = (uint64_t)(m >> 64);
+                return (uint64_t)m;
+            #elif defined(CORSAC_COMPILER_MSVC) && defined(CORSAC_PROCESSOR_X86_64)
+                return _umul128(a, b, &hi);
+            #else
+                const uint64_t aLo = a & 0xFFFFFFFF, aHi = a >> 32;
+                const uint64_t bLo = b & 0xFFFFFFFF, bHi = b >> 32;
+                const uint64_t ll = aLo * bLo, lh = aLo * bHi, hl = aHi * bLo, hh = aHi * bHi;
+                const uint64_t mid = (ll >> 32) + (lh & 0xFFFFFFFF) + (hl & 0xFFFFFFFF);
+                hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+                return (mid << 32) | (ll & 0xFFFFFFFF);
+            #endif
+        }
+
+        // generate_bits
+        // Равномерное значение UInt из генератора. Если генератор шире, берутся старшие биты,
+        // если уже - значения склеиваются.
+        template <typename UInt, typename Generator>
+        inline UInt generate_bits(Generator& g)
+        {
+            using result_type = typename corsac::remove_reference_t<Generator>::result_type;
+            static_assert(corsac::is_unsigned<result_type>::value, "generate_bits: Generator::result_type must be unsigned.");
+
+            if constexpr(sizeof(result_type) >= sizeof(UInt))
+                return static_cast<UInt>(static_cast<result_type>(g()) >> ((sizeof(result_type) - sizeof(UInt)) * 8));
+            else
+            {
+                UInt result = 0;
+                for(size_t i = 0; i < sizeof(UInt) / sizeof(result_type); ++i)
+                    result = static_cast<UInt>((result << (sizeof(result_type) * 8)) | static_cast<result_type>(g()));
+                return result;
+            }
+        }
+
+        // bounded_rand
+        // Равномерное значение в [0, range), range > 0. Метод Лемира ("Fast Random Integer Generation
+        // in an Interval", 2019): старшая половина произведения bits * range - результат, младшая
+        // решает, нужна ли отбраковка. Деление выполняется только когда младшая половина меньше range.
+        template <typename Generator>
+        inline uint32_t bounded_rand(Generator& g, uint32_t range)
+        {
+            uint64_t m = uint64_t(generate_bits<uint32_t>(g)) * range;
+            uint32_t low = static_cast<uint32_t>(m);
+            if(CORSAC_UNLIKELY(low < range))
+            {
+                const uint32_t threshold = (0u - range) % range;
+                while(low < threshold)
+                {
+                    m   = uint64_t(generate_bits<uint32_t>(g)) * range;
+                    low = static_cast<uint32_t>(m);
+                }
+            }
+            return static_cast<uint32_t>(m >> 32);
+        }
+
+        template <typename Generator>
+        inline uint64_t bounded_rand(Generator& g, uint64_t range)
+        {
+            uint64_t high;
+            uint64_t low = mul128(generate_bits<uint64_t>(g), range, high);
+            if(CORSAC_UNLIKELY(low < range))
+            {
+                const uint64_t threshold = (0 - range) % range;
+                while(low < threshold)
+                    low = mul128(generate_bits<uint64_t>(g), range, high);
+            }
+            return high;
+        }
+
+        // Число в [0, 1) из случайных битов: биты записываются в мантиссу числа из [1, 2), затем вычитается 1.
+        // Используются старшие 23 (float) или 52 (double) бита.
+        inline float bits_to_unit_float(uint32_t bits) noexcept
+        {
+            const uint32_t u = (bits >> 9) | 0x3F800000u;
+            float f;
+            memcpy(&f, &u, sizeof(f));
+            return f - 1.0f;
+        }
+
+        inline double bits_to_unit_double(uint64_t bits) noexcept
+        {
+            const uint64_t u = (bits >> 12) | 0x3FF0000000000000ULL;
+            double d;
+            memcpy(&d, &u, sizeof(d));
+            return d - 1.0;
+        }
+
+        // Есть ли у распределения пакетный метод generate(first, last, g).
+        template <typename Distribution, typename ForwardIterator, typename Generator, typename = void>
+        struct has_bulk_generate : corsac::false_type {};
+
+        template <typename Distribution, typename ForwardIterator, typename Generator>
+        struct has_bulk_generate<Distribution, ForwardIterator, Generator,
+                corsac::void_t<decltype(corsac::declval<Distribution&>().generate(corsac::declval<ForwardIterator>(),
+                                                                                  corsac::declval<ForwardIterator>(),
+                                                                                  corsac::declval<Generator&>()))>> : corsac::true_type {};
+    }
+
+    // splitmix64
+    // Генератор Стила, Ли и Флада (SplittableRandom). Каждое значение - хеш счетчика, поэтому
+    // даже соседние seed дают несвязанные последовательности.
+    class splitmix64
+    {
+    public:
+        using result_type = uint64_t;
+
+        static constexpr result_type default_seed = 0x853c49e6748fea9bULL;
+
+        explicit splitmix64(result_type seed = default_seed);
+
+        void seed(result_type seed = default_seed);
+
+        result_type operator()();
+        void discard(uint64_t n);
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return corsac::numeric_limits<result_type>::max(); }
+
+        bool operator==(const splitmix64& x) const { return mState == x.mState; }
+        bool operator!=(const splitmix64& x) const { return mState != x.mState; }
+
+    protected:
+        uint64_t mState;
+    };
+
+    // xoshiro256starstar
+    // Генератор Блэкмана и Винья (xoshiro256**). Все 64 бита результата проходят статистические тесты.
+    class xoshiro256starstar
+    {
+    public:
+        using result_type = uint64_t;
+
+        static constexpr result_type default_seed = splitmix64::default_seed;
+
+        // Состояние заполняется splitmix64(seed), как рекомендуют авторы.
+        explicit xoshiro256starstar(result_type seed = default_seed);
+
+        // Состояние задается напрямую. Оно не должно быть нулевым целиком.
+        xoshiro256starstar(uint64_t s0, uint64_t s1, uint64_t s2, uint64_t s3);
+
+        void seed(result_type seed = default_seed);
+
+        result_type operator()();
+        void discard(uint64_t n);
+
+        // Эквивалентно 2^128 вызовам operator(). Дает до 2^128 непересекающихся подпоследовательностей.
+        void jump();
+
+        // Эквивалентно 2^192 вызовам operator(). Дает до 2^64 стартовых точек, из которых jump() делает свои потоки.
+        void long_jump();
+
+        const uint64_t* state() const { return mState; }
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return corsac::numeric_limits<result_type>::max(); }
+
+        bool operator==(const xoshiro256starstar& x) const;
+        bool operator!=(const xoshiro256starstar& x) const { return !(*this == x); }
+
+    protected:
+        void jump(const uint64_t (&polynomial)[4]);
+
+        uint64_t mState[4];
+    };
+
+    // pcg32
+    // PCG-XSH-RR О'Нил: 64-битный LCG с перестановкой выхода. stream выбирает одну из 2^63
+    // независимых последовательностей.
+    class pcg32
+    {
+    public:
+        using result_type = uint32_t;
+
+        static constexpr uint64_t default_seed   = 0x853c49e6748fea9bULL;
+        static constexpr uint64_t default_stream = 0xda3e39cb94b95bdbULL;
+
+        explicit pcg32(uint64_t seed = default_seed, uint64_t stream = default_stream);
+
+        void seed(uint64_t seed = default_seed, uint64_t stream = default_stream);
+
+        result_type operator()();
+        void discard(uint64_t n) { advance(n); }
+
+        // Сдвигает генератор на delta значений за O(log delta).
+        void advance(uint64_t delta);
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return corsac::numeric_limits<result_type>::max(); }
+
+        bool operator==(const pcg32& x) const { return (mState == x.mState) && (mInc == x.mInc); }
+        bool operator!=(const pcg32& x) const { return !(*this == x); }
+
+    protected:
+        static constexpr uint64_t kMultiplier = 6364136223846793005ULL;
+
+        uint64_t mState;
+        uint64_t mInc; // Всегда нечетный.
+    };
+
+    using default_random_engine = xoshiro256starstar;
+
+    // xoshiro256starstar_x4
+    // Четыре генератора xoshiro256** (дорожки), второй - копия первого после jump(), третий - после
+    // двух jump() и т.д. Выход чередует дорожки: значение 4k + j - это k-е значение дорожки j.
+    // Пакетные методы шагают все четыре дорожки одной инструкцией AVX2 (если процессор ее
+    // поддерживает) и дают те же значения, что и operator().
+    class xoshiro256starstar_x4
+    {
+    public:
+        using result_type = uint64_t;
+
+        static constexpr size_t lanes = 4;
+        static constexpr result_type default_seed = xoshiro256starstar::default_seed;
+
+        explicit xoshiro256starstar_x4(result_type seed = default_seed);
+
+        void seed(result_type seed = default_seed);
+
+        result_type operator()();
+
+        // Заполняет [first, last) следующими значениями, продолжая последовательность operator().
+        void generate(uint64_t* first, uint64_t* last);
+
+        // Заполняет [first, last) равномерными числами в [0, 1). Каждое 64-битное значение дает
+        // два float или один double. Не использует буфер operator(): значения берутся с границы
+        // блока из четырех, неиспользованный остаток последнего блока отбрасывается.
+        void generate_canonical(float* first, float* last);
+        void generate_canonical(double* first, double* last);
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return corsac::numeric_limits<result_type>::max(); }
+
+    protected:
+        void next_blocks(uint64_t* out, size_t blocks);
+
+        uint64_t mState[4][lanes];   // mState[слово состояния][дорожка].
+        uint64_t mBuffer[lanes];     // Последний блок, выданный operator() не полностью.
+        size_t   mBufferIndex;
+        bool     mUseAVX2;
+    };
+
+    // splitmix64
+    inline splitmix64::splitmix64(result_type seedValue)
+            : mState(seedValue)
+    {}
+
+    inline void splitmix64::seed(result_type seedValue)
+    {
+        mState = seedValue;
+    }
+
+    inline splitmix64::result_type splitmix64::operator()()
+    {
+        uint64_t z = (mState += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    inline void splitmix64::discard(uint64_t n)
+    {
+        mState += n * 0x9e3779b97f4a7c15ULL;
+    }
+
+    // xoshiro256starstar
+    inline xoshiro256starstar::xoshiro256starstar(result_type seedValue)
+    {
+        seed(seedValue);
+    }
+
+    inline xoshiro256starstar::xoshiro256starstar(uint64_t s0, uint64_t s1, uint64_t s2, uint64_t s3)
+            : mState{ s0, s1, s2, s3 }
+    {
+        CORSAC_ASSERT((s0 | s1 | s2 | s3) != 0);
+    }
+
+    inline void xoshiro256starstar::seed(result_type seedValue)
+    {
+        splitmix64 seeder(seedValue);
+        for(uint64_t& s : mState)
+            s = seeder();
+    }
+
+    inline xoshiro256starstar::result_type xoshiro256starstar::operator()()
+    {
+        const uint64_t result = internal::rotl64(mState[1] * 5, 7) * 9;
+        const uint64_t t = mState[1] << 17;
+
+        mState[2] ^= mState[0];
+        mState[3] ^= mState[1];
+        mState[1] ^= mState[2];
+        mState[0] ^= mState[3];
+
+        mState[2] ^= t;
+        mState[3] = internal::rotl64(mState[3], 45);
+
+        return result;
+    }
+
+    inline void xoshiro256starstar::discard(uint64_t n)
+    {
+        for(; n; --n)
+            operator()();
+    }
+
+    inline void xoshiro256starstar::jump(const uint64_t (&polynomial)[4])
+    {
+        uint64_t s[4] = { 0, 0, 0, 0 };
+        for(uint64_t word : polynomial)
+            for(int b = 0; b < 64; ++b)
+            {
+                if(word & (uint64_t(1) << b))
+                {
+                    s[0] ^= mState[0];
+                    s[1] ^= mState[1];
+                    s[2] ^= mState[2];
+                    s[3] ^= mState[3];
+                }
+                operator()();
+            }
+
+        mState[0] = s[0];
+        mState[1] = s[1];
+        mState[2] = s[2];
+        mState[3] = s[3];
+    }
+
+    inline void xoshiro256starstar::jump()
+    {
+        static constexpr uint64_t polynomial[4] = { 0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL };
+        jump(polynomial);
+    }
+
+    inline void xoshiro256starstar::long_jump()
+    {
+        static constexpr uint64_t polynomial[4] = { 0x76e15d3efefdcbbfULL, 0xc5004e441c522fb3ULL, 0x77710069854ee241ULL, 0x39109bb02acbe635ULL };
+        jump(polynomial);
+    }
+
+    inline bool xoshiro256starstar::operator==(const xoshiro256starstar& x) const
+    {
+        return (mState[0] == x.mState[0]) && (mState[1] == x.mState[1]) &&
+               (mState[2] == x.mState[2]) && (mState[3] == x.mState[3]);
+    }
+
+    // pcg32
+    inline pcg32::pcg32(uint64_t seedValue, uint64_t stream)
+    {
+        seed(seedValue, stream);
+    }
+
+    inline void pcg32::seed(uint64_t seedValue, uint64_t stream)
+    {
+        mState = 0;
+        mInc   = (stream << 1) | 1;
+        operator()();
+        mState += seedValue;
+        operator()();
+    }
+
+    inline pcg32::result_type pcg32::operator()()
+    {
+        const uint64_t old = mState;
+        mState = old * kMultiplier + mInc;
+
+        const uint32_t xorshifted = static_cast<uint32_t>(((old >> 18) ^ old) >> 27);
+        const uint32_t rot        = static_cast<uint32_t>(old >> 59);
+        return (xorshifted >> rot) | (xorshifted << ((0u - rot) & 31));
+    }
+
+    inline void pcg32::advance(uint64_t delta)
+    {
+        // Композиция LCG возведением в степень (Brown, "Random Number Generation with Arbitrary Stride").
+        uint64_t curMult = kMultiplier, curPlus = mInc;
+        uint64_t accMult = 1, accPlus = 0;
+        while(delta > 0)
+        {
+            if(delta & 1)
+            {
+                accMult *= curMult;
+                accPlus  = accPlus * curMult + curPlus;
+            }
+            curPlus  = (curMult + 1) * curPlus;
+            curMult *= curMult;
+            delta  >>= 1;
+        }
+        mState = accMult * mState + accPlus;
+    }
+
+    // xoshiro256starstar_x4
+    namespace internal
+    {
+        inline void xoshiro_x4_step(uint64_t (&s)[4][xoshiro256starstar_x4::lanes], uint64_t* out, size_t blocks) noexcept
+        {
+            for(; blocks; --blocks, out += xoshiro256starstar_x4::lanes)
+                for(size_t j = 0; j < xoshiro256starstar_x4::lanes; ++j)
+                {
+                    out[j] = rotl64(s[1][j] * 5, 7) * 9;
+                    const uint64_t t = s[1][j] << 17;
+                    s[2][j] ^= s[0][j];
+                    s[3][j] ^= s[1][j];
+                    s[1][j] ^= s[2][j];
+                    s[0][j] ^= s[3][j];
+                    s[2][j] ^= t;
+                    s[3][j] = rotl64(s[3][j], 45);
+                }
+        }
+
+        #if CORSAC_SIMD_X86
+            // В AVX2 нет 64-битного умножения, поэтому x * 5 и x * 9 считаются сдвигом и сложением.
+            CORSAC_TARGET("avx2") inline void xoshiro_x4_step_avx2(uint64_t (&s)[4][xoshiro256starstar_x4::lanes], uint64_t* out, size_t blocks) noexcept
+            {
+                __m256i s0 = _mm256_loadu_si256((const __m256i*)s[0]);
+                __m256i s1 = _mm256_loadu_si256((const __m256i*)s[1]);
+                __m256i s2 = _mm256_loadu_si256((const __m256i*)s[2]);
+                __m256i s3 = _mm256_loadu_si256((const __m256i*)s[3]);
+
+                for(; blocks; --blocks, out += xoshiro256starstar_x4::lanes)
+                {
+                    const __m256i x5  = _mm256_add_epi64(_mm256_slli_epi64(s1, 2), s1);
+                    const __m256i rot = _mm256_or_si256(_mm256_slli_epi64(x5, 7), _mm256_srli_epi64(x5, 57));
+                    _mm256_storeu_si256((__m256i*)out, _mm256_add_epi64(_mm256_slli_epi64(rot, 3), rot));
+
+                    const __m256i t = _mm256_slli_epi64(s1, 17);
+                    s2 = _mm256_xor_si256(s2, s0);
+                    s3 = _mm256_xor_si256(s3, s1);
+                    s1 = _mm256_xor_si256(s1, s2);
+                    s0 = _mm256_xor_si256(s0, s3);
+                    s2 = _mm256_xor_si256(s2, t);
+                    s3 = _mm256_or_si256(_mm256_slli_epi64(s3, 45), _mm256_srli_epi64(s3, 19));
+                }
+
+                _mm256_storeu_si256((__m256i*)s[0], s0);
+                _mm256_storeu_si256((__m256i*)s[1], s1);
+                _mm256_storeu_si256((__m256i*)s[2], s2);
+                _mm256_storeu_si256((__m256i*)s[3], s3);
+            }
+
+            // Перевод случайных битов в float / double, см. bits_to_unit_float. Обрабатываются целые векторы,
+            // остаток (count % 8 или count % 4) переводит вызывающий.
+            CORSAC_TARGET("avx2") inline void bits_to_unit_float_avx2(const uint64_t* bits, float* out, size_t count) noexcept
+            {
+                const __m256i one  = _mm256_set1_epi32(0x3F800000);
+                const __m256  oneF = _mm256_set1_ps(1.0f);
+                for(size_t i = 0; i + 8 <= count; i += 8)
+                {
+                    const __m256i b = _mm256_loadu_si256((const __m256i*)((const uint32_t*)bits + i));
+                    const __m256  f = _mm256_castsi256_ps(_mm256_or_si256(_mm256_srli_epi32(b, 9), one));
+                    _mm256_storeu_ps(out + i, _mm256_sub_ps(f, oneF));
+                }
+            }
+
+            CORSAC_TARGET("avx2") inline void bits_to_unit_double_avx2(const uint64_t* bits, double* out, size_t count) noexcept
+            {
+                const __m256i one  = _mm256_set1_epi64x(0x3FF0000000000000LL);
+                const __m256d oneD = _mm256_set1_pd(1.0);
+                for(size_t i = 0; i + 4 <= count; i += 4)
+                {
+                    const __m256i b = _mm256_loadu_si256((const __m256i*)(bits + i));
+                    const __m256d d = _mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(b, 12), one));
+                    _mm256_storeu_pd(out + i, _mm256_sub_pd(d, oneD));
+                }
+            }
+        #endif
+    }
+
+    inline xoshiro256starstar_x4::xoshiro256starstar_x4(result_type seedValue)
+    {
+        seed(seedValue);
+    }
+
+    inline void xoshiro256starstar_x4::seed(result_type seedValue)
+    {
+        xoshiro256starstar lane(seedValue);
+        for(size_t j = 0; j < lanes; ++j)
+        {
+            for(size_t w = 0; w < 4; ++w)
+                mState[w][j] = lane.state()[w];
+            lane.jump();
+        }
+        mBufferIndex = lanes;
+        #if CORSAC_SIMD_X86
+            mUseAVX2 = corsac::internal::get_cpu_info().avx2;
+        #else
+            mUseAVX2 = false;
+        #endif
+    }
+
+    inline void xoshiro256starstar_x4::next_blocks(uint64_t* out, size_t blocks)
+    {
+        #if CORSAC_SIMD_X86
+            if(mUseAVX2)
+            {
+                internal::xoshiro_x4_step_avx2(mState, out, blocks);
+                return;
+            }
+        #endif
+        internal::xoshiro_x4_step(mState, out, blocks);
+    }
+
+    inline xoshiro256starstar_x4::result_type xoshiro256starstar_x4::operator()()
+    {
+        if(mBufferIndex == lanes)
+        {
+            internal::xoshiro_x4_step(mState, mBuffer, 1);
+            mBufferIndex = 0;
+        }
+        return mBuffer[mBufferIndex++];
+    }
+
+    inline void xoshiro256starstar_x4::generate(uint64_t* first, uint64_t* last)
+    {
+        while(first != last && mBufferIndex != lanes)
+            *first++ = mBuffer[mBufferIndex++];
+
+        const size_t blocks = size_t(last - first) / lanes;
+        next_blocks(first, blocks);
+        first += blocks * lanes;
+
+        while(first != last)
+            *first++ = operator()();
+    }
+
+    inline void xoshiro256starstar_x4::generate_canonical(float* first, float* last)
+    {
+        // Биты генерируются порциями в буфер на стеке (он остается в L1) и переводятся в float.
+        // Каждое 64-битное значение дает два float.
+        const size_t kChunkFloats = lanes * 16 * 2;
+        uint64_t chunk[lanes * 16];
+        while(first != last)
+        {
+            const size_t count  = (size_t(last - first) < kChunkFloats) ? size_t(last - first) : kChunkFloats;
+            const size_t blocks = (count + lanes * 2 - 1) / (lanes * 2);
+            next_blocks(chunk, blocks);
+
+            size_t i = 0;
+            #if CORSAC_SIMD_X86
+                if(mUseAVX2)
+                {
+                    internal::bits_to_unit_float_avx2(chunk, first, count);
+                    i = count & ~size_t(7);
+                }
+            #endif
+            for(; i < count; ++i)
+            {
+                uint32_t bits;
+                memcpy(&bits, reinterpret_cast<const uint32_t*>(chunk) + i, sizeof(bits));
+                first[i] = internal::bits_to_unit_float(bits);
+            }
+            first += count;
+        }
+    }
+
+    inline void xoshiro256starstar_x4::generate_canonical(double* first, double* last)
+    {
+        const size_t kChunkDoubles = lanes * 16;
+        uint64_t chunk[kChunkDoubles];
+        while(first != last)
+        {
+            const size_t count  = (size_t(last - first) < kChunkDoubles) ? size_t(last - first) : kChunkDoubles;
+            const size_t blocks = (count + lanes - 1) / lanes;
+            next_blocks(chunk, blocks);
+
+            size_t i = 0;
+            #if CORSAC_SIMD_X86
+                if(mUseAVX2)
+                {
+                    internal::bits_to_unit_double_avx2(chunk, first, count);
+                    i = count & ~size_t(3);
+                }
+            #endif
+            for(; i < count; ++i)
+                first[i] = internal::bits_to_unit_double(chunk[i]);
+            first += count;
+        }
+    }
+
+    // generate_canonical
+    // Равномерное число в [0, 1) с 23 (float) или 52 (double) случайными битами мантиссы.
+    template <typename RealType, typename Generator>
+    inline RealType generate_canonical(Generator& g)
+    {
+        static_assert(corsac::is_floating_point<RealType>::value, "generate_canonical: RealType must be floating point.");
+
+        if constexpr(sizeof(RealType) <= sizeof(float))
+            return static_cast<RealType>(internal::bits_to_unit_float(internal::generate_bits<uint32_t>(g)));
+        else
+            return static_cast<RealType>(internal::bits_to_unit_double(internal::generate_bits<uint64_t>(g)));
+    }
+
     // Реализует равномерное распределение значений, генерируемых генератором,
     // где генератор обычно является генератором случайных или псевдослучайных чисел.
     // Обратите внимание, что диапазон minmax для этого класса является включительным,
@@ -57,6 +722,10 @@ namespace corsac
         template<class Generator>
         result_type operator()(Generator& g, const param_type& params);
 
+        // Пакетная генерация: параметры читаются один раз на весь диапазон.
+        template<class ForwardIterator, class Generator>
+        void generate(ForwardIterator first, ForwardIterator last, Generator& g);
+
         result_type a() const;
         result_type b() const;
 
@@ -119,17 +788,24 @@ namespace corsac
     inline typename uniform_int_distribution<IntType>::result_type
     uniform_int_distribution<IntType>::operator()(Generator& g, const param_type& params)
     {
-        // Эту функцию сложно реализовать универсальным способом для всех интегральных типов.
-        // Решение будет включать обработку случаев со знаковыми типами и 64-битными типами, вероятно,
-        // таким образом, чтобы использовать метапрограммирование шаблонов для работы со знаковыми диапазонами.
+        // Диапазон считается в беззнаковом типе, поэтому работают и знаковые типы, и диапазон во весь тип.
+        using unsigned_type = corsac::make_unsigned_t<result_type>;
+        using bits_type     = corsac::conditional_t<(sizeof(result_type) <= 4), uint32_t, uint64_t>;
 
-        // Временное решение, пока мы ищем полное решение. Поддерживает только uint8_t,
-        // uint16_t, and uint32_t uniform_int_distribution types.
-        static_assert(corsac::is_unsigned<result_type>::value && (sizeof(result_type) <= 4), "uniform_int_distribution currently supports only uint8_t, uint16_t, uint32_t.");
+        const bits_type span = static_cast<bits_type>(static_cast<unsigned_type>(static_cast<unsigned_type>(params.b()) - static_cast<unsigned_type>(params.a())));
+        if(CORSAC_UNLIKELY(span == corsac::numeric_limits<bits_type>::max()))
+            return static_cast<result_type>(internal::generate_bits<bits_type>(g));
+
+        return static_cast<result_type>(static_cast<unsigned_type>(params.a()) + static_cast<unsigned_type>(internal::bounded_rand(g, static_cast<bits_type>(span + 1))));
+    }
 
-        result_type v = g();    // Создает значение в диапазоне (numeric_limits<result_type>::min(), numeric_limits<result_type>::max()).
-        result_type r = static_cast<result_type>((v * static_cast<uint64_t>((params.b() - params.a()) + 1)) >> (sizeof(result_type) * 8)); // +1 потому что диапазоны включены.
-        return params.a() + r;
+    template<class IntType>
+    template<class ForwardIterator, class Generator>
+    inline void uniform_int_distribution<IntType>::generate(ForwardIterator first, ForwardIterator last, Generator& g)
+    {
+        const param_type params = mParam;
+        for(; first != last; ++first)
+            *first = operator()(g, params);
     }
 
     template<class IntType>
@@ -187,6 +863,779 @@ namespace corsac
     {
         return (lhs.param() != rhs.param());
     }
+
+    // Реализует равномерное распределение чисел с плавающей точкой в [a, b).
+    template<class RealType = double>
+    class uniform_real_distribution
+    {
+        static_assert(corsac::is_floating_point<RealType>::value, "uniform_real_distribution: RealType must be floating point.");
+
+    public:
+        using result_type = RealType;
+
+        struct param_type
+        {
+            explicit param_type(RealType a = 0, RealType b = 1);
+
+            result_type a() const { return mA; }
+            result_type b() const { return mB; }
+
+            bool operator==(const param_type& x) const { return (x.mA == mA) && (x.mB == mB); }
+            bool operator!=(const param_type& x) const { return !(*this == x); }
+
+        protected:
+            RealType mA;
+            RealType mB;
+        };
+
+        explicit uniform_real_distribution(RealType a = 0, RealType b = 1);
+        explicit uniform_real_distribution(const param_type& params);
+
+        void reset() {}
+
+        template<class Generator>
+        result_type operator()(Generator& g);
+
+        template<class Generator>
+        result_type operator()(Generator& g, const param_type& params);
+
+        // Пакетная генерация. Для xoshiro256starstar_x4 и непрерывного массива числа в [0, 1)
+        // генерируются его пакетным generate_canonical, затем масштабируются.
+        template<class ForwardIterator, class Generator>
+        void generate(ForwardIterator first, ForwardIterator last, Generator& g);
+
+        result_type a() const { return mParam.a(); }
+        result_type b() const { return mParam.b(); }
+
+        param_type param() const { return mParam; }
+        void param(const param_type& params) { mParam = params; }
+
+        result_type min() const { return mParam.a(); }
+        result_type max() const { return mParam.b(); }
+
+    protected:
+        param_type mParam;
+    };
+
+    namespace internal
+    {
+        // ziggurat_normal_table
+        // Таблицы зиккурата Дорника (ZIGNOR, "An Improved Ziggurat Method to Generate Normal Random Samples", 2005)
+        // для 128 слоев. x[i] - правая граница слоя i, ratio[i] = x[i + 1] / x[i] - доля слоя, которая целиком
+        // лежит под кривой. Слой 0 - основание вместе с хвостом за R.
+        struct ziggurat_normal_table
+        {
+            static constexpr int    layers = 128;
+            static constexpr double R      = 3.442619855899;
+            static constexpr double V      = 9.91256303526217e-3;
+
+            double x[layers + 1];
+            double ratio[layers];
+
+            ziggurat_normal_table()
+            {
+                const double f = exp(-0.5 * R * R);
+                x[0] = V / f;
+                x[1] = R;
+                x[layers] = 0.0;
+                for(int i = 2; i < layers; ++i)
+                    x[i] = sqrt(-2.0 * log(V / x[i - 1] + exp(-0.5 * x[i - 1] * x[i - 1])));
+                for(int i = 0; i < layers; ++i)
+                    ratio[i] = x[i + 1] / x[i];
+            }
+
+            static const ziggurat_normal_table& get()
+            {
+                static const ziggurat_normal_table table;
+                return table;
+            }
+        };
+
+        // ziggurat_normal
+        // Стандартное нормальное число. Одно 64-битное значение дает и номер слоя (младшие 7 бит),
+        // и координату в слое (старшие 52 бита). Примерно в 98.8% случаев число принимается
+        // сразу, без вызова exp или log.
+        template <typename Generator>
+        inline double ziggurat_normal(Generator& g)
+        {
+            const ziggurat_normal_table& table = ziggurat_normal_table::get();
+            for(;;)
+            {
+                const uint64_t bits = generate_bits<uint64_t>(g);
+                const int      i    = static_cast<int>(bits & (ziggurat_normal_table::layers - 1));
+                const double   u    = 2.0 * bits_to_unit_double(bits) - 1.0;
+
+                if(CORSAC_LIKELY(fabs(u) < table.ratio[i]))
+                    return u * table.x[i];
+
+                if(i == 0)
+                {
+                    // Хвост за R, метод Марсальи. 1 - U лежит в (0, 1], поэтому log конечен.
+                    double x, y;
+                    do
+                    {
+                        x = log(1.0 - bits_to_unit_double(generate_bits<uint64_t>(g))) / ziggurat_normal_table::R;
+                        y = log(1.0 - bits_to_unit_double(generate_bits<uint64_t>(g)));
+                    } while(-2.0 * y < x * x);
+                    return (u < 0.0) ? (x - ziggurat_normal_table::R) : (ziggurat_normal_table::R - x);
+                }
+
+                // Клин между прямоугольником слоя и кривой.
+                const double x0 = u * table.x[i];
+                const double f0 = exp(-0.5 * (table.x[i] * table.x[i] - x0 * x0));
+                const double f1 = exp(-0.5 * (table.x[i + 1] * table.x[i + 1] - x0 * x0));
+                if(f1 + bits_to_unit_double(generate_bits<uint64_t>(g)) * (f0 - f1) < 1.0)
+                    return x0;
+            }
+        }
+    }
+
+    // Реализует нормальное распределение методом зиккурата.
+    template<class RealType = double>
+    class normal_distribution
+    {
+        static_assert(corsac::is_floating_point<RealType>::value, "normal_distribution: RealType must be floating point.");
+
+    public:
+        using result_type = RealType;
+
+        struct param_type
+        {
+            explicit param_type(RealType mean = 0, RealType stddev = 1);
+
+            result_type mean() const { return mMean; }
+            result_type stddev() const { return mStddev; }
+
+            bool operator==(const param_type& x) const { return (x.mMean == mMean) && (x.mStddev == mStddev); }
+            bool operator!=(const param_type& x) const { return !(*this == x); }
+
+        protected:
+            RealType mMean;
+            RealType mStddev;
+        };
+
+        explicit normal_distribution(RealType mean = 0, RealType stddev = 1);
+        explicit normal_distribution(const param_type& params);
+
+        // Зиккурат не хранит значений между вызовами.
+        void reset() {}
+
+        template<class Generator>
+        result_type operator()(Generator& g);
+
+        template<class Generator>
+        result_type operator()(Generator& g, const param_type& params);
+
+        template<class ForwardIterator, class Generator>
+        void generate(ForwardIterator first, ForwardIterator last, Generator& g);
+
+        result_type mean() const { return mParam.mean(); }
+        result_type stddev() const { return mParam.stddev(); }
+
+        param_type param() const { return mParam; }
+        void param(const param_type& params) { mParam = params; }
+
+        result_type min() const { return -corsac::numeric_limits<RealType>::infinity(); }
+        result_type max() const { return corsac::numeric_limits<RealType>::infinity(); }
+
+    protected:
+        param_type mParam;
+    };
+
+    // Реализует распределение Бернулли: true с вероятностью p.
+    class bernoulli_distribution
+    {
+    public:
+        using result_type = bool;
+
+        struct param_type
+        {
+            explicit param_type(double p = 0.5);
+
+            double p() const { return mP; }
+
+            bool operator==(const param_type& x) const { return x.mP == mP; }
+            bool operator!=(const param_type& x) const { return x.mP != mP; }
+
+        protected:
+            double mP;
+        };
+
+        explicit bernoulli_distribution(double p = 0.5);
+        explicit bernoulli_distribution(const param_type& params);
+
+        void reset() {}
+
+        template<class Generator>
+        result_type operator()(Generator& g);
+
+        template<class Generator>
+        result_type operator()(Generator& g, const param_type& params);
+
+        template<class ForwardIterator, class Generator>
+        void generate(ForwardIterator first, ForwardIterator last, Generator& g);
+
+        double p() const { return mParam.p(); }
+
+        param_type param() const { return mParam; }
+        void param(const param_type& params) { mParam = params; }
+
+        result_type min() const { return false; }
+        result_type max() const { return true; }
+
+    protected:
+        // Порог для 53 случайных битов: bits < threshold с вероятностью p.
+        static uint64_t threshold(double p) { return static_cast<uint64_t>(p * 9007199254740992.0); }
+
+        param_type mParam;
+    };
+
+    namespace internal
+    {
+        // alias_table
+        // Таблица псевдонимов Уолкера в построении Воуза ("A Linear Algorithm for Generating Random Numbers
+        // with a Given Distribution", 1991). Каждый из n столбцов весит 1/n и делится между собственным
+        // исходом и одним псевдонимом, поэтому выборка - это один выбор столбца и одно сравнение,
+        // независимо от n. Построение за O(n).
+        //
+        // Память выделяется через new[]: random.h включается из algorithm.h и не может включать vector.h.
+        // Таблица из одного исхода (пустой набор весов, перемещенный объект) лежит в самом объекте
+        // и памяти не выделяет, поэтому в таблице всегда есть хотя бы один столбец.
+        class alias_table
+        {
+        public:
+            alias_table();
+
+            template <typename InputIterator>
+            alias_table(InputIterator first, InputIterator last);
+
+            alias_table(const alias_table& x);
+            alias_table(alias_table&& x) noexcept;
+            ~alias_table();
+
+            alias_table& operator=(const alias_table& x);
+            alias_table& operator=(alias_table&& x) noexcept;
+
+            size_t size() const { return mSize; }
+            const double* probabilities() const { return mProbabilities; }
+
+            template <typename Generator>
+            size_t sample(Generator& g) const;
+
+            bool operator==(const alias_table& x) const;
+
+        protected:
+            struct column
+            {
+                uint64_t threshold; // Собственный исход выбирается, если 53 случайных бита меньше порога.
+                uint32_t alias;
+            };
+
+            void allocate(size_t n);
+            void release();
+            void build();
+
+            void set_unit() noexcept;
+            bool is_unit() const noexcept { return mColumns == &mUnitColumn; }
+
+            size_t  mSize;
+            double* mProbabilities; // Нормированные веса.
+            column* mColumns;
+            double  mUnitProbability = 1.0;
+            column  mUnitColumn      = { uint64_t(1) << 53, 0 };
+        };
+    }
+
+    // Реализует дискретное распределение: значение i с вероятностью weights[i] / sum(weights).
+    // Выборка за O(1) по таблице псевдонимов, независимо от числа исходов.
+    template<class IntType = int>
+    class discrete_distribution
+    {
+        static_assert(corsac::is_integral<IntType>::value, "discrete_distribution: IntType must be integral.");
+
+    public:
+        using result_type = IntType;
+
+        struct param_type
+        {
+            param_type() = default;
+
+            template <typename InputIterator>
+            param_type(InputIterator first, InputIterator last) : mTable(first, last) {}
+
+            param_type(std::initializer_list<double> weights) : mTable(weights.begin(), weights.end()) {}
+
+            size_t size() const { return mTable.size(); }
+            const double* probabilities() const { return mTable.probabilities(); }
+
+            bool operator==(const param_type& x) const { return mTable == x.mTable; }
+            bool operator!=(const param_type& x) const { return !(mTable == x.mTable); }
+
+        protected:
+            friend class discrete_distribution;
+
+            internal::alias_table mTable;
+        };
+
+        discrete_distribution() = default;
+
+        template <typename InputIterator>
+        discrete_distribution(InputIterator first, InputIterator last) : mParam(first, last) {}
+
+        discrete_distribution(std::initializer_list<double> weights) : mParam(weights) {}
+
+        explicit discrete_distribution(const param_type& params) : mParam(params) {}
+
+        void reset() {}
+
+        template<class Generator>
+        result_type operator()(Generator& g);
+
+        template<class Generator>
+        result_type operator()(Generator& g, const param_type& params);
+
+        template<class ForwardIterator, class Generator>
+        void generate(ForwardIterator first, ForwardIterator last, Generator& g);
+
+        // Вероятности исходов 0 .. size() - 1.
+        size_t size() const { return mParam.size(); }
+        const double* probabilities() const { return mParam.probabilities(); }
+
+        const param_type& param() const { return mParam; }
+        void param(const param_type& params) { mParam = params; }
+
+        result_type min() const { return 0; }
+        result_type max() const { return static_cast<result_type>(mParam.size() - 1); }
+
+    protected:
+        param_type mParam;
+    };
+
+    // uniform_real_distribution
+    template<class RealType>
+    inline uniform_real_distribution<RealType>::param_type::param_type(RealType aValue, RealType bValue)
+            : mA(aValue), mB(bValue)
+    {
+        CORSAC_ASSERT(aValue <= bValue);
+    }
+
+    template<class RealType>
+    inline uniform_real_distribution<RealType>::uniform_real_distribution(RealType aValue, RealType bValue)
+            : mParam(aValue, bValue)
+    {}
+
+    template<class RealType>
+    inline uniform_real_distribution<RealType>::uniform_real_distribution(const param_type& params)
+            : mParam(params)
+    {}
+
+    template<class RealType>
+    template<class Generator>
+    inline typename uniform_real_distribution<RealType>::result_type
+    uniform_real_distribution<RealType>::operator()(Generator& g)
+    {
+        return operator()(g, mParam);
+    }
+
+    template<class RealType>
+    template<class Generator>
+    inline typename uniform_real_distribution<RealType>::result_type
+    uniform_real_distribution<RealType>::operator()(Generator& g, const param_type& params)
+    {
+        return params.a() + (params.b() - params.a()) * corsac::generate_canonical<RealType>(g);
+    }
+
+    template<class RealType>
+    template<class ForwardIterator, class Generator>
+    inline void uniform_real_distribution<RealType>::generate(ForwardIterator first, ForwardIterator last, Generator& g)
+    {
+        const RealType a     = mParam.a();
+        const RealType scale = mParam.b() - mParam.a();
+
+        if constexpr(corsac::is_same<Generator, xoshiro256starstar_x4>::value && corsac::is_same<ForwardIterator, RealType*>::value &&
+                     (corsac::is_same<RealType, float>::value || corsac::is_same<RealType, double>::value))
+        {
+            g.generate_canonical(first, last);
+            for(; first != last; ++first)
+                *first = a + scale * *first;
+        }
+        else
+        {
+            for(; first != last; ++first)
+                *first = a + scale * corsac::generate_canonical<RealType>(g);
+        }
+    }
+
+    template<class RealType>
+    inline bool operator==(const uniform_real_distribution<RealType>& lhs, const uniform_real_distribution<RealType>& rhs)
+    {
+        return (lhs.param() == rhs.param());
+    }
+
+    template<class RealType>
+    inline bool operator!=(const uniform_real_distribution<RealType>& lhs, const uniform_real_distribution<RealType>& rhs)
+    {
+        return (lhs.param() != rhs.param());
+    }
+
+    // normal_distribution
+    template<class RealType>
+    inline normal_distribution<RealType>::param_type::param_type(RealType meanValue, RealType stddevValue)
+            : mMean(meanValue), mStddev(stddevValue)
+    {
+        CORSAC_ASSERT(stddevValue > 0);
+    }
+
+    template<class RealType>
+    inline normal_distribution<RealType>::normal_distribution(RealType meanValue, RealType stddevValue)
+            : mParam(meanValue, stddevValue)
+    {}
+
+    template<class RealType>
+    inline normal_distribution<RealType>::normal_distribution(const param_type& params)
+            : mParam(params)
+    {}
+
+    template<class RealType>
+    template<class Generator>
+    inline typename normal_distribution<RealType>::result_type
+    normal_distribution<RealType>::operator()(Generator& g)
+    {
+        return operator()(g, mParam);
+    }
+
+    template<class RealType>
+    template<class Generator>
+    inline typename normal_distribution<RealType>::result_type
+    normal_distribution<RealType>::operator()(Generator& g, const param_type& params)
+    {
+        return static_cast<result_type>(params.mean() + params.stddev() * internal::ziggurat_normal(g));
+    }
+
+    template<class RealType>
+    template<class ForwardIterator, class Generator>
+    inline void normal_distribution<RealType>::generate(ForwardIterator first, ForwardIterator last, Generator& g)
+    {
+        const double mean   = mParam.mean();
+        const double stddev = mParam.stddev();
+        for(; first != last; ++first)
+            *first = static_cast<result_type>(mean + stddev * internal::ziggurat_normal(g));
+    }
+
+    template<class RealType>
+    inline bool operator==(const normal_distribution<RealType>& lhs, const normal_distribution<RealType>& rhs)
+    {
+        return (lhs.param() == rhs.param());
+    }
+
+    template<class RealType>
+    inline bool operator!=(const normal_distribution<RealType>& lhs, const normal_distribution<RealType>& rhs)
+    {
+        return (lhs.param() != rhs.param());
+    }
+
+    // bernoulli_distribution
+    inline bernoulli_distribution::param_type::param_type(double pValue)
+            : mP(pValue)
+    {
+        CORSAC_ASSERT((pValue >= 0.0) && (pValue <= 1.0));
+    }
+
+    inline bernoulli_distribution::bernoulli_distribution(double pValue)
+            : mParam(pValue)
+    {}
+
+    inline bernoulli_distribution::bernoulli_distribution(const param_type& params)
+            : mParam(params)
+    {}
+
+    template<class Generator>
+    inline bernoulli_distribution::result_type bernoulli_distribution::operator()(Generator& g)
+    {
+        return operator()(g, mParam);
+    }
+
+    template<class Generator>
+    inline bernoulli_distribution::result_type bernoulli_distribution::operator()(Generator& g, const param_type& params)
+    {
+        return (internal::generate_bits<uint64_t>(g) >> 11) < threshold(params.p());
+    }
+
+    template<class ForwardIterator, class Generator>
+    inline void bernoulli_distribution::generate(ForwardIterator first, ForwardIterator last, Generator& g)
+    {
+        const uint64_t limit = threshold(mParam.p());
+        for(; first != last; ++first)
+            *first = (internal::generate_bits<uint64_t>(g) >> 11) < limit;
+    }
+
+    inline bool operator==(const bernoulli_distribution& lhs, const bernoulli_distribution& rhs)
+    {
+        return (lhs.param() == rhs.param());
+    }
+
+    inline bool operator!=(const bernoulli_distribution& lhs, const bernoulli_distribution& rhs)
+    {
+        return (lhs.param() != rhs.param());
+    }
+
+    // alias_table
+    namespace internal
+    {
+        // Пустой набор весов - один исход с вероятностью 1, как у std::discrete_distribution.
+        inline alias_table::alias_table()
+        {
+            set_unit();
+        }
+
+        // Веса читаются за один проход в растущий буфер: InputIterator нельзя пройти дважды.
+        template <typename InputIterator>
+        inline alias_table::alias_table(InputIterator first, InputIterator last)
+        {
+            size_t  n = 0, capacity = 0;
+            double* weights = nullptr;
+            double  sum = 0.0;
+            for(; first != last; ++first)
+            {
+                if(n == capacity)
+                {
+                    capacity = capacity ? capacity * 2 : 16;
+                    double* grown = new double[capacity];
+                    if(n)
+                        memcpy(grown, weights, n * sizeof(double));
+                    delete[] weights;
+                    weights = grown;
+                }
+                CORSAC_ASSERT(*first >= 0);
+                weights[n] = static_cast<double>(*first);
+                sum += weights[n++];
+            }
+            CORSAC_ASSERT((n == 0) || (sum > 0.0));
+            CORSAC_ASSERT(n <= corsac::numeric_limits<uint32_t>::max());
+
+            if(n <= 1)
+            {
+                delete[] weights;
+                set_unit();
+                return;
+            }
+
+            // Буфер весов становится массивом вероятностей, лишняя емкость не мешает delete[].
+            mSize          = n;
+            mProbabilities = weights;
+            mColumns       = new column[n];
+            for(size_t i = 0; i < n; ++i)
+                mProbabilities[i] /= sum;
+            build();
+        }
+
+        inline alias_table::alias_table(const alias_table& x)
+        {
+            allocate(x.mSize);
+            memcpy(mProbabilities, x.mProbabilities, mSize * sizeof(double));
+            memcpy(mColumns, x.mColumns, mSize * sizeof(column));
+        }
+
+        inline alias_table::alias_table(alias_table&& x) noexcept
+        {
+            set_unit();
+            if(!x.is_unit())
+            {
+                mSize          = x.mSize;
+                mProbabilities = x.mProbabilities;
+                mColumns       = x.mColumns;
+                x.set_unit();
+            }
+        }
+
+        inline alias_table::~alias_table()
+        {
+            release();
+        }
+
+        inline alias_table& alias_table::operator=(const alias_table& x)
+        {
+            if(this != &x)
+            {
+                if(mSize != x.mSize)
+                {
+                    release();
+                    allocate(x.mSize);
+                }
+                memcpy(mProbabilities, x.mProbabilities, mSize * sizeof(double));
+                memcpy(mColumns, x.mColumns, mSize * sizeof(column));
+            }
+            return *this;
+        }
+
+        inline alias_table& alias_table::operator=(alias_table&& x) noexcept
+        {
+            if(this != &x)
+            {
+                release();
+                if(!x.is_unit())
+                {
+                    mSize          = x.mSize;
+                    mProbabilities = x.mProbabilities;
+                    mColumns       = x.mColumns;
+                    x.set_unit();
+                }
+            }
+            return *this;
+        }
+
+        template <typename Generator>
+        inline size_t alias_table::sample(Generator& g) const
+        {
+            const column& c = mColumns[bounded_rand(g, static_cast<uint32_t>(mSize))];
+            return ((generate_bits<uint64_t>(g) >> 11) < c.threshold) ? size_t(&c - mColumns) : size_t(c.alias);
+        }
+
+        inline bool alias_table::operator==(const alias_table& x) const
+        {
+            return (mSize == x.mSize) && (memcmp(mProbabilities, x.mProbabilities, mSize * sizeof(double)) == 0);
+        }
+
+        inline void alias_table::allocate(size_t n)
+        {
+            if(n <= 1)
+            {
+                set_unit();
+                return;
+            }
+            mSize          = n;
+            mProbabilities = new double[n];
+            mColumns       = new column[n];
+        }
+
+        // Освобождает память и возвращает таблицу из одного исхода.
+        inline void alias_table::release()
+        {
+            if(!is_unit())
+            {
+                delete[] mProbabilities;
+                delete[] mColumns;
+            }
+            set_unit();
+        }
+
+        inline void alias_table::set_unit() noexcept
+        {
+            mSize          = 1;
+            mProbabilities = &mUnitProbability;
+            mColumns       = &mUnitColumn;
+        }
+
+        inline void alias_table::build()
+        {
+            const size_t n = mSize;
+            double*   scaled = new double[n];
+            uint32_t* work   = new uint32_t[n]; // Малые столбцы растут с начала, большие - с конца.
+
+            size_t smallCount = 0, largeBegin = n;
+            for(size_t i = 0; i < n; ++i)
+            {
+                scaled[i] = mProbabilities[i] * static_cast<double>(n);
+                if(scaled[i] < 1.0)
+                    work[smallCount++] = static_cast<uint32_t>(i);
+                else
+                    work[--largeBegin] = static_cast<uint32_t>(i);
+            }
+
+            // Малый столбец дополняется до 1 большим, остаток большого снова попадает в один из списков.
+            while(smallCount != 0 && largeBegin != n)
+            {
+                const uint32_t s = work[--smallCount];
+                const uint32_t l = work[largeBegin++];
+
+                mColumns[s].threshold = static_cast<uint64_t>(scaled[s] * 9007199254740992.0);
+                mColumns[s].alias     = l;
+
+                scaled[l] = (scaled[l] + scaled[s]) - 1.0;
+                if(scaled[l] < 1.0)
+                    work[smallCount++] = l;
+                else
+                    work[--largeBegin] = l;
+            }
+
+            // Оставшиеся столбцы равны 1 с точностью до округления.
+            while(smallCount != 0)
+            {
+                const uint32_t i = work[--smallCount];
+                mColumns[i].threshold = uint64_t(1) << 53;
+                mColumns[i].alias     = i;
+            }
+            for(; largeBegin != n; ++largeBegin)
+            {
+                const uint32_t i = work[largeBegin];
+                mColumns[i].threshold = uint64_t(1) << 53;
+                mColumns[i].alias     = i;
+            }
+
+            delete[] scaled;
+            delete[] work;
+        }
+    }
+
+    // discrete_distribution
+    template<class IntType>
+    template<class Generator>
+    inline typename discrete_distribution<IntType>::result_type
+    discrete_distribution<IntType>::operator()(Generator& g)
+    {
+        return operator()(g, mParam);
+    }
+
+    template<class IntType>
+    template<class Generator>
+    inline typename discrete_distribution<IntType>::result_type
+    discrete_distribution<IntType>::operator()(Generator& g, const param_type& params)
+    {
+        return static_cast<result_type>(params.mTable.sample(g));
+    }
+
+    template<class IntType>
+    template<class ForwardIterator, class Generator>
+    inline void discrete_distribution<IntType>::generate(ForwardIterator first, ForwardIterator last, Generator& g)
+    {
+        const internal::alias_table& table = mParam.mTable;
+        for(; first != last; ++first)
+            *first = static_cast<result_type>(table.sample(g));
+    }
+
+    template<class IntType>
+    inline bool operator==(const discrete_distribution<IntType>& lhs, const discrete_distribution<IntType>& rhs)
+    {
+        return (lhs.param() == rhs.param());
+    }
+
+    template<class IntType>
+    inline bool operator!=(const discrete_distribution<IntType>& lhs, const discrete_distribution<IntType>& rhs)
+    {
+        return (lhs.param() != rhs.param());
+    }
+
+    /**
+     * generate
+     *
+     * Заполняет [first, last) значениями distribution(g). Если у распределения есть пакетный метод
+     * generate(first, last, g), вызывается он.
+     *
+     * Пример использования:
+     *      corsac::uniform_int_distribution<uint32_t> dist(0, 99);
+     *      corsac::generate(values.begin(), values.end(), rng, dist);
+     */
+    template<class ForwardIterator, class Generator, class Distribution>
+    inline void generate(ForwardIterator first, ForwardIterator last, Generator& g, Distribution& distribution)
+    {
+        if constexpr(internal::has_bulk_generate<Distribution, ForwardIterator, Generator>::value)
+            distribution.generate(first, last, g);
+        else
+        {
+            for(; first != last; ++first)
+                *first = distribution(g);
+        }
+    }
 }
 
 #endif //CORSAC_STL_RANDOM_H
@@ -0,0 +1,339 @@
+/**
+ * corsac::STL
+ *
+ * slot_map.h
+ *
+ * Created by Falldot on 18.10.2026.
+ * Copyright (c) 2021 Corsac. All rights reserved.
+ */
+#ifndef CORSAC_STL_SLOT_MAP_H
+#define CORSAC_STL_SLOT_MAP_H
+
+#pragma once
+/**
+ * Описание (Falldot 18.10.2026)
+ *
+ * slot_map<T> - контейнер со стабильными ключами (generational index). Значения лежат плотно
+ * в corsac::vector и удаляются перестановкой последнего на место удаленного, как
+ * vector::erase_unsorted, но ключ, выданный при вставке, остается действительным, пока
+ * значение не удалено, а после удаления перестает находить что-либо - даже когда слот
+ * занят снова.
+ *
+ * Устройство:
+ *  - mSlots  - разреженный массив слотов, ключ хранит индекс слота и поколение;
+ *  - mValues - плотный массив значений, итерация идет по нему;
+ *  - mErase  - для каждого плотного элемента индекс его слота, чтобы при перестановке
+ *              последнего элемента исправить слот, который на него указывает.
+ *
+ * Свободные слоты связаны в список через поле index и переиспользуются первыми.
+ * Поколение занятого слота всегда нечетное, свободного - четное: проверка ключа - это
+ * сравнение индекса с размером и одно сравнение поколений. Все операции O(1).
+ *
+ * Поколение 32-битное: ключ может ошибочно стать действительным, только если его слот
+ * переиспользовали 2^31 раз.
+ *
+ * ---------------------------------------------------------------------------------------------------
+ * === Классы:
+ *
+ *      slot_map_key                    Ключ: 32-битный индекс слота и 32-битное поколение.
+ *      slot_map<T, Allocator>          Контейнер.
+ *
+ * Пример использования:
+ *      corsac::slot_map<Body> bodies;
+ *      corsac::slot_map_key key = bodies.insert(Body{});
+ *      if(Body* body = bodies.find(key)) ...
+ *      bodies.erase(key);                     // key больше ничего не находит.
+ *      for(Body& body : bodies) ...           // Плотная итерация.
+ */
+
+#include "Corsac/STL/config.h"
+#include "Corsac/vector.h"
+#include "Corsac/functional.h"
+
+namespace corsac
+{
+    // CORSAC_SLOT_MAP_DEFAULT_NAME
+    #ifndef CORSAC_SLOT_MAP_DEFAULT_NAME
+        #define CORSAC_SLOT_MAP_DEFAULT_NAME CORSAC_DEFAULT_NAME_PREFIX " slot_map"
+    #endif
+
+    // CORSAC_SLOT_MAP_DEFAULT_ALLOCATOR
+    #ifndef CORSAC_SLOT_MAP_DEFAULT_ALLOCATOR
+        #define CORSAC_SLOT_MAP_DEFAULT_ALLOCATOR allocator_type(CORSAC_SLOT_MAP_DEFAULT_NAME)
+    #endif
+
+    /**
+     * slot_map_key
+     *
+     * Ключ по умолчанию не находит ничего ни в одном контейнере.
+     */
+    struct slot_map_key
+    {
+        static constexpr uint32_t npos = 0xFFFFFFFFu;
+
+        uint32_t index;
+        uint32_t generation;
+
+        constexpr slot_map_key() noexcept : index(npos), generation(0) {}
+        constexpr slot_map_key(uint32_t i, uint32_t g) noexcept : index(i), generation(g) {}
+
+        constexpr bool is_null() const noexcept { return index == npos; }
+
+        // Ключ одним числом, например для сериализации.
+        constexpr uint64_t value() const noexcept { return ((uint64_t)generation << 32) | index; }
+
+        constexpr bool operator==(const slot_map_key& x) const noexcept { return index == x.index && generation == x.generation; }
+        constexpr bool operator!=(const slot_map_key& x) const noexcept { return !(*this == x); }
+        constexpr bool operator<(const slot_map_key& x) const noexcept { return value() < x.value(); }
+    };
+
+    template <> struct hash<slot_map_key>
+    { size_t operator()(const slot_map_key& key) const { return static_cast<size_t>(hash_mix(static_cast<size_t>(key.value()))); } };
+
+    template <typename T, typename Allocator = CORSAC_ALLOCATOR_TYPE>
+    class slot_map
+    {
+        using this_type = slot_map<T, Allocator>;
+
+    public:
+        using key_type                  = slot_map_key;
+        using value_type                = T;
+        using allocator_type            = Allocator;
+        using size_type                 = uint32_t;
+        using reference                 = T&;
+        using const_reference           = const T&;
+        using pointer                   = T*;
+        using const_pointer             = const T*;
+        using iterator                  = typename vector<T, Allocator>::iterator;
+        using const_iterator            = typename vector<T, Allocator>::const_iterator;
+
+        slot_map();
+        explicit slot_map(const allocator_type& allocator);
+
+        key_type insert(const value_type& value);
+        key_type insert(value_type&& value);
+
+        template <typename... Args>
+        key_type emplace(Args&&... args);
+
+        // Возвращает false, если ключ уже недействителен.
+        bool erase(key_type key);
+
+        void clear();
+        void reserve(size_type n);
+        void swap(this_type& x);
+
+        bool contains(key_type key) const noexcept;
+
+        // nullptr, если ключ недействителен.
+        pointer find(key_type key) noexcept;
+        const_pointer find(key_type key) const noexcept;
+
+        // Ключ должен быть действительным (проверяется CORSAC_ASSERT).
+        reference operator[](key_type key);
+        const_reference operator[](key_type key) const;
+
+        // Ключ значения с плотным индексом n, например при обходе begin()..end().
+        key_type key_at(size_type n) const;
+
+        bool empty() const noexcept { return mValues.empty(); }
+        size_type size() const noexcept { return (size_type)mValues.size(); }
+        size_type slot_count() const noexcept { return (size_type)mSlots.size(); }
+
+        pointer data() noexcept { return mValues.data(); }
+        const_pointer data() const noexcept { return mValues.data(); }
+
+        iterator begin() noexcept { return mValues.begin(); }
+        const_iterator begin() const noexcept { return mValues.begin(); }
+        const_iterator cbegin() const noexcept { return mValues.cbegin(); }
+
+        iterator end() noexcept { return mValues.end(); }
+        const_iterator end() const noexcept { return mValues.end(); }
+        const_iterator cend() const noexcept { return mValues.cend(); }
+
+        bool validate() const;
+
+    protected:
+        struct slot
+        {
+            uint32_t index;         // Занятый слот: плотный индекс значения. Свободный: следующий свободный слот.
+            uint32_t generation;    // Нечетное - занят, четное - свободен.
+        };
+
+        key_type DoAllocateSlot();
+
+        vector<slot, Allocator>     mSlots;
+        vector<T, Allocator>        mValues;
+        vector<uint32_t, Allocator> mErase;
+        uint32_t                    mFreeHead = key_type::npos;
+    };
+
+    template <typename T, typename Allocator>
+    inline slot_map<T, Allocator>::slot_map()
+        : mSlots(CORSAC_SLOT_MAP_DEFAULT_ALLOCATOR), mValues(CORSAC_SLOT_MAP_DEFAULT_ALLOCATOR), mErase(CORSAC_SLOT_MAP_DEFAULT_ALLOCATOR)
+    {}
+
+    template <typename T, typename Allocator>
+    inline slot_map<T, Allocator>::slot_map(const allocator_type& allocator)
+        : mSlots(allocator), mValues(allocator), mErase(allocator)
+    {}
+
+    template <typename T, typename Allocator>
+    inline typename slot_map<T, Allocator>::key_type slot_map<T, Allocator>::insert(const value_type& value)
+    {
+        return emplace(value);
+    }
+
+    template <typename T, typename Allocator>
+    inline typename slot_map<T, Allocator>::key_type slot_map<T, Allocator>::insert(value_type&& value)
+    {
+        return emplace(corsac::move(value));
+    }
+
+    template <typename T, typename Allocator>
+    template <typename... Args>
+    inline typename slot_map<T, Allocator>::key_type slot_map<T, Allocator>::emplace(Args&&... args)
+    {
+        mValues.emplace_back(corsac::forward<Args>(args)...);
+        const key_type key = DoAllocateSlot();
+        mErase.push_back(key.index);
+        return key;
+    }
+
+    template <typename T, typename Allocator>
+    inline bool slot_map<T, Allocator>::erase(key_type key)
+    {
+        if(!contains(key))
+            return false;
+
+        slot& s = mSlots[key.index];
+        const uint32_t dense = s.index;
+        const uint32_t last  = (uint32_t)mValues.size() - 1;
+        if(dense != last)
+        {
+            mValues[dense] = corsac::move(mValues[last]);
+            mErase[dense]  = mErase[last];
+            mSlots[mErase[dense]].index = dense;
+        }
+        mValues.pop_back();
+        mErase.pop_back();
+
+        ++s.generation;
+        s.index   = mFreeHead;
+        mFreeHead = key.index;
+        return true;
+    }
+
+    template <typename T, typename Allocator>
+    inline void slot_map<T, Allocator>::clear()
+    {
+        // Поколения сохраняются, чтобы старые ключи не стали действительными после новых вставок.
+        for(uint32_t i : mErase)
+        {
+            ++mSlots[i].generation;
+            mSlots[i].index = mFreeHead;
+            mFreeHead = i;
+        }
+        mValues.clear();
+        mErase.clear();
+    }
+
+    template <typename T, typename Allocator>
+    inline void slot_map<T, Allocator>::reserve(size_type n)
+    {
+        mSlots.reserve(n);
+        mValues.reserve(n);
+        mErase.reserve(n);
+    }
+
+    template <typename T, typename Allocator>
+    inline void slot_map<T, Allocator>::swap(this_type& x)
+    {
+        mSlots.swap(x.mSlots);
+        mValues.swap(x.mValues);
+        mErase.swap(x.mErase);
+        corsac::swap(mFreeHead, x.mFreeHead);
+    }
+
+    template <typename T, typename Allocator>
+    inline bool slot_map<T, Allocator>::contains(key_type key) const noexcept
+    {
+        // npos всегда за пределами mSlots. Занятый слот имеет нечетное поколение; ключ с четным поколением
+        // совпал бы со свободным слотом, у которого index - ссылка списка свободных, а не позиция значения.
+        return (key.generation & 1) != 0 && key.index < mSlots.size() && mSlots[key.index].generation == key.generation;
+    }
+
+    template <typename T, typename Allocator>
+    inline typename slot_map<T, Allocator>::pointer slot_map<T, Allocator>::find(key_type key) noexcept
+    {
+        return contains(key) ? &mValues[mSlots[key.index].index] : nullptr;
+    }
+
+    template <typename T, typename Allocator>
+    inline typename slot_map<T, Allocator>::const_pointer slot_map<T, Allocator>::find(key_type key) const noexcept
+    {
+        return contains(key) ? &mValues[mSlots[key.index].index] : nullptr;
+    }
+
+    template <typename T, typename Allocator>
+    inline typename slot_map<T, Allocator>::reference slot_map<T, Allocator>::operator[](key_type key)
+    {
+        CORSAC_ASSERT(contains(key));
+        return mValues[mSlots[key.index].index];
+    }
+
+    template <typename T, typename Allocator>
+    inline typename slot_map<T, Allocator>::const_reference slot_map<T, Allocator>::operator[](key_type key) const
+    {
+        CORSAC_ASSERT(contains(key));
+        return mValues[mSlots[key.index].index];
+    }
+
+    template <typename T, typename Allocator>
+    inline typename slot_map<T, Allocator>::key_type slot_map<T, Allocator>::key_at(size_type n) const
+    {
+        const uint32_t index = mErase[n];
+        return key_type(index, mSlots[index].generation);
+    }
+
+    template <typename T, typename Allocator>
+    inline bool slot_map<T, Allocator>::validate() const
+    {
+        if(mValues.size() != mErase.size())
+            return false;
+        for(uint32_t n = 0; n < (uint32_t)mErase.size(); ++n)
+        {
+            const slot& s = mSlots[mErase[n]];
+            if(s.index != n || (s.generation & 1) == 0)
+                return false;
+        }
+        return true;
+    }
+
+    template <typename T, typename Allocator>
+    inline typename slot_map<T, Allocator>::key_type slot_map<T, Allocator>::DoAllocateSlot()
+    {
+        const uint32_t dense = (uint32_t)mValues.size() - 1;
+        if(mFreeHead != key_type::npos)
+        {
+            const uint32_t index = mFreeHead;
+            slot& s = mSlots[index];
+            mFreeHead = s.index;
+            s.index = dense;
+            ++s.generation;
+            return key_type(index, s.generation);
+        }
+
+        CORSAC_ASSERT(mSlots.size() < key_type::npos);
+        mSlots.push_back(slot{ dense, 1 });
+        return key_type((uint32_t)mSlots.size() - 1, 1);
+    }
+
+    template <typename T, typename Allocator>
+    inline void swap(slot_map<T, Allocator>& a, slot_map<T, Allocator>& b)
+    {
+        a.swap(b);
+    }
+}
+
+#endif //CORSAC_STL_SLOT_MAP_H
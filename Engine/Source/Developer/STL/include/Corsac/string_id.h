@@ -0,0 +1,303 @@
+/**
+ * corsac::STL
+ *
+ * string_id.h
+ *
+ * Created by Falldot on 18.10.2026.
+ * Copyright (c) 2021 Corsac. All rights reserved.
+ */
+#ifndef CORSAC_STL_STRING_ID_H
+#define CORSAC_STL_STRING_ID_H
+
+#pragma once
+/**
+ * Описание (Falldot 18.10.2026)
+ *
+ * Идентификаторы строк: имена компонентов, типы событий, идентификаторы ассетов.
+ *
+ * string_id хранит только 64-битный хеш строки (hash_string / hash_bytes), поэтому сравнение
+ * и копирование - это операции над одним целым числом. Хеш вычисляется на этапе компиляции
+ * для литералов, так что string_id можно использовать в case:
+ *
+ *      switch(event.type.hash())
+ *      {
+ *          case "damage"_sid.hash(): ...
+ *          case "heal"_sid.hash():   ...
+ *      }
+ *
+ * Текст строки хранится в глобальной таблице интернирования (string_intern_table) - один раз
+ * на уникальную строку. string_id::intern добавляет строку в таблицу, после чего c_str()
+ * возвращает ее текст. Идентификаторы, созданные на этапе компиляции, в таблицу не попадают,
+ * пока та же строка не будет интернирована во время выполнения.
+ *
+ * Два разных текста с одинаковым 64-битным хешем неразличимы. При интернировании такая
+ * коллизия обнаруживается и вызывает CORSAC_ASSERT.
+ *
+ * ---------------------------------------------------------------------------------------------------
+ * === Классы:
+ *
+ *      string_id                       64-битный идентификатор строки.
+ *      string_intern_table             Потокобезопасная таблица строк: хеш -> единственная копия текста.
+ *
+ * === Литералы:
+ *
+ *      "text"_sid                      string_id, вычисленный на этапе компиляции (без интернирования).
+ *
+ * Пример использования:
+ *      const corsac::string_id transform = corsac::string_id::intern("Transform");
+ *      if(component.type == transform) ...
+ *      printf("%s\n", component.type.c_str());
+ */
+
+#include "Corsac/STL/config.h"
+#include "Corsac/functional.h"
+
+#include <string.h>
+#include <mutex>
+
+/**
+ * CORSAC_STRING_INTERN_PAGE_SIZE
+ *
+ * Размер страницы, из которой таблица интернирования выделяет память под текст строк.
+ */
+#ifndef CORSAC_STRING_INTERN_PAGE_SIZE
+    #define CORSAC_STRING_INTERN_PAGE_SIZE 65536
+#endif
+
+namespace corsac
+{
+    /**
+     * string_intern_table
+     *
+     * Хеш-таблица с открытой адресацией (линейное пробирование, степень двойки слотов) из
+     * 64-битного хеша в указатель на текст. Текст копируется в страницы и не перемещается,
+     * поэтому указатели, возвращенные intern и find, действительны до уничтожения таблицы.
+     */
+    class string_intern_table
+    {
+    public:
+        string_intern_table() = default;
+        ~string_intern_table();
+
+        string_intern_table(const string_intern_table&) = delete;
+        string_intern_table& operator=(const string_intern_table&) = delete;
+
+        // Глобальная таблица, которую использует string_id.
+        static string_intern_table& get();
+
+        // Возвращает единственную копию строки str длиной len с хешем hash, добавляя ее при необходимости.
+        const char* intern(const char* str, size_t len, uint64_t hash);
+
+        // Текст строки с хешем hash или nullptr, если такая строка не интернирована.
+        const char* find(uint64_t hash) const;
+
+        size_t size() const;
+
+    protected:
+        struct entry
+        {
+            uint64_t    hash;
+            const char* str;    // nullptr - пустой слот.
+        };
+
+        struct page
+        {
+            page*  next;
+            size_t used;
+            size_t capacity;
+            // Далее capacity байт текста.
+        };
+
+        const entry* find_entry(uint64_t hash) const;
+        char* allocate_text(size_t len);
+        void grow();
+
+        mutable std::mutex mMutex;
+        entry* mEntries  = nullptr;
+        size_t mCapacity = 0;           // Всегда ноль или степень двойки.
+        size_t mSize     = 0;
+        page*  mPages    = nullptr;
+    };
+
+    /**
+     * string_id
+     *
+     * Хеш строки. Конструкторы вычисляют хеш (в том числе на этапе компиляции) и не трогают
+     * таблицу интернирования, intern() - вычисляет и сохраняет текст.
+     */
+    class string_id
+    {
+    public:
+        using hash_type = uint64_t;
+
+        // Пустая строка.
+        constexpr string_id() noexcept : mHash(hash_string("", 0)) {}
+
+        constexpr explicit string_id(const char* str) noexcept : mHash(hash_string(str)) {}
+        constexpr string_id(const char* str, size_t len) noexcept : mHash(hash_string(str, len)) {}
+
+        static constexpr string_id from_hash(hash_type hash) noexcept { return string_id(hash, 0); }
+
+        static string_id intern(const char* str);
+        static string_id intern(const char* str, size_t len);
+
+        constexpr hash_type hash() const noexcept { return mHash; }
+
+        // Текст из глобальной таблицы или nullptr, если строка не интернирована.
+        const char* c_str() const;
+
+        constexpr bool operator==(const string_id& x) const noexcept { return mHash == x.mHash; }
+        constexpr bool operator!=(const string_id& x) const noexcept { return mHash != x.mHash; }
+        constexpr bool operator<(const string_id& x) const noexcept { return mHash < x.mHash; }
+
+    private:
+        constexpr string_id(hash_type hash, int) noexcept : mHash(hash) {}
+
+        hash_type mHash;
+    };
+
+    template <> struct hash<string_id>
+    { size_t operator()(const string_id& id) const { return static_cast<size_t>(id.hash()); } };
+
+    inline namespace literals
+    {
+        inline namespace string_id_literals
+        {
+            constexpr string_id operator"" _sid(const char* str, size_t len) noexcept
+            {
+                return string_id(str, len);
+            }
+        }
+    }
+
+    // string_intern_table
+    inline string_intern_table::~string_intern_table()
+    {
+        delete[] mEntries;
+        while(mPages)
+        {
+            page* next = mPages->next;
+            delete[] reinterpret_cast<char*>(mPages);
+            mPages = next;
+        }
+    }
+
+    inline string_intern_table& string_intern_table::get()
+    {
+        static string_intern_table table;
+        return table;
+    }
+
+    inline const char* string_intern_table::intern(const char* str, size_t len, uint64_t hash)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        if(const entry* e = find_entry(hash))
+        {
+            CORSAC_ASSERT((strncmp(e->str, str, len) == 0) && (e->str[len] == 0)); // Коллизия 64-битного хеша.
+            return e->str;
+        }
+
+        if((mSize + 1) * 4 > mCapacity * 3) // Заполнение не больше 3/4.
+            grow();
+
+        char* text = allocate_text(len);
+        memcpy(text, str, len);
+        text[len] = 0;
+
+        size_t i = static_cast<size_t>(hash) & (mCapacity - 1);
+        while(mEntries[i].str)
+            i = (i + 1) & (mCapacity - 1);
+        mEntries[i].hash = hash;
+        mEntries[i].str  = text;
+        ++mSize;
+        return text;
+    }
+
+    inline const char* string_intern_table::find(uint64_t hash) const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        const entry* e = find_entry(hash);
+        return e ? e->str : nullptr;
+    }
+
+    inline size_t string_intern_table::size() const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mSize;
+    }
+
+    inline const string_intern_table::entry* string_intern_table::find_entry(uint64_t hash) const
+    {
+        if(mCapacity == 0)
+            return nullptr;
+
+        // Хеш уже перемешан (wyhash), поэтому слот берется из младших битов без дополнительного mix.
+        for(size_t i = static_cast<size_t>(hash) & (mCapacity - 1); mEntries[i].str; i = (i + 1) & (mCapacity - 1))
+        {
+            if(mEntries[i].hash == hash)
+                return &mEntries[i];
+        }
+        return nullptr;
+    }
+
+    inline char* string_intern_table::allocate_text(size_t len)
+    {
+        const size_t size = len + 1;
+        if(!mPages || (mPages->capacity - mPages->used) < size)
+        {
+            // Строки длиннее страницы получают собственную страницу.
+            const size_t capacity = (size > CORSAC_STRING_INTERN_PAGE_SIZE) ? size : CORSAC_STRING_INTERN_PAGE_SIZE;
+            page* p = reinterpret_cast<page*>(new char[sizeof(page) + capacity]);
+            p->next     = mPages;
+            p->used     = 0;
+            p->capacity = capacity;
+            mPages      = p;
+        }
+
+        char* text = reinterpret_cast<char*>(mPages + 1) + mPages->used;
+        mPages->used += size;
+        return text;
+    }
+
+    inline void string_intern_table::grow()
+    {
+        const size_t capacity = mCapacity ? mCapacity * 2 : 256;
+        entry* entries = new entry[capacity]();
+
+        for(size_t i = 0; i < mCapacity; ++i)
+        {
+            if(mEntries[i].str)
+            {
+                size_t j = static_cast<size_t>(mEntries[i].hash) & (capacity - 1);
+                while(entries[j].str)
+                    j = (j + 1) & (capacity - 1);
+                entries[j] = mEntries[i];
+            }
+        }
+
+        delete[] mEntries;
+        mEntries  = entries;
+        mCapacity = capacity;
+    }
+
+    // string_id
+    inline string_id string_id::intern(const char* str)
+    {
+        return intern(str, strlen(str));
+    }
+
+    inline string_id string_id::intern(const char* str, size_t len)
+    {
+        const hash_type h = hash_bytes(str, len);
+        string_intern_table::get().intern(str, len, h);
+        return from_hash(h);
+    }
+
+    inline const char* string_id::c_str() const
+    {
+        return string_intern_table::get().find(mHash);
+    }
+}
+
+#endif //CORSAC_STL_STRING_ID_H
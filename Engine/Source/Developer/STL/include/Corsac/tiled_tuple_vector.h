@@ -0,0 +1,710 @@
+/**
+ * corsac::STL
+ *
+ * tiled_tuple_vector.h
+ *
+ * Created by Falldot on 18.10.2026.
+ * Copyright (c) 2021 Corsac. All rights reserved.
+ */
+#ifndef CORSAC_STL_TILED_TUPLE_VECTOR_H
+#define CORSAC_STL_TILED_TUPLE_VECTOR_H
+
+#pragma once
+/**
+ * Описание (Falldot 18.10.2026)
+ *
+ * tiled_tuple_vector<TileSize, Ts...> - вариант tuple_vector с гибридной раскладкой AoSoA
+ * (массив структур массивов). Элементы разбиты на плитки по TileSize штук, внутри плитки
+ * каждая колонка лежит непрерывным массивом из TileSize значений:
+ *
+ *      tuple_vector:        x0 x1 x2 ... xN | y0 y1 y2 ... yN | z0 z1 z2 ... zN
+ *      tiled_tuple_vector:  [x0..x7 y0..y7 z0..z7] [x8..x15 y8..y15 z8..z15] ...
+ *
+ * Ядро, которое трогает сразу несколько колонок, читает их из одной плитки - это несколько
+ * соседних кэш-линий вместо нескольких удаленных потоков, а начало каждой колонки в плитке
+ * выровнено на CORSAC_TILED_TUPLE_VECTOR_ALIGNMENT (по умолчанию 32 байта). Поэтому при
+ * TileSize * sizeof(T), кратном 32, ядро плитки - это ровно несколько выровненных 256-битных
+ * загрузок на колонку без пролога и эпилога.
+ *
+ * Интерфейс повторяет tuple_vector: push_back / emplace_back / erase_unsorted / resize, доступ
+ * к строке через operator[] (кортеж ссылок) и итераторы произвольного доступа. Отличия:
+ *  - get<I>() без аргументов (указатель на всю колонку) не существует, колонка не непрерывна.
+ *    Вместо него get<I>(n) - ссылка на элемент, tile<I>(t) - выровненный указатель на колонку
+ *    плитки t и each_tile(function) - обход по плиткам;
+ *  - вставка в середину не поддерживается, erase сдвигает элементы поэлементно;
+ *  - емкость всегда кратна TileSize.
+ *
+ * Элементы последней плитки после size() не сконструированы. Ядро должно обрабатывать только
+ * tile_elements(t) элементов плитки, либо контейнер нужно дополнить до кратного TileSize размера.
+ *
+ * ---------------------------------------------------------------------------------------------------
+ * === Классы:
+ *
+ *      tiled_tuple_vector<TileSize, Ts...>                 Контейнер с распределителем по умолчанию.
+ *      tiled_tuple_vector_alloc<Allocator, TileSize, Ts...> То же с пользовательским распределителем.
+ *
+ * Пример использования:
+ *      corsac::tiled_tuple_vector<8, float, float, float, float> particles; // x, y, vx, vy
+ *      particles.each_tile([dt](size_t count, float* x, float* y, float* vx, float* vy)
+ *      {
+ *          for(size_t i = 0; i < count; ++i) // count == 8 для всех плиток кроме последней.
+ *          {
+ *              x[i] += vx[i] * dt;
+ *              y[i] += vy[i] * dt;
+ *          }
+ *      });
+ */
+
+#include "Corsac/tuple_vector.h"
+
+/**
+ * CORSAC_TILED_TUPLE_VECTOR_ALIGNMENT
+ *
+ * Выравнивание начала каждой колонки в плитке. 32 байта - ширина регистра AVX.
+ */
+#ifndef CORSAC_TILED_TUPLE_VECTOR_ALIGNMENT
+    #define CORSAC_TILED_TUPLE_VECTOR_ALIGNMENT 32
+#endif
+
+namespace corsac
+{
+    // CORSAC_TILED_TUPLE_VECTOR_DEFAULT_NAME
+    #ifndef CORSAC_TILED_TUPLE_VECTOR_DEFAULT_NAME
+        #define CORSAC_TILED_TUPLE_VECTOR_DEFAULT_NAME CORSAC_DEFAULT_NAME_PREFIX " tiled-tuple-vector"
+    #endif
+
+    // CORSAC_TILED_TUPLE_VECTOR_DEFAULT_ALLOCATOR
+    #ifndef CORSAC_TILED_TUPLE_VECTOR_DEFAULT_ALLOCATOR
+        #define CORSAC_TILED_TUPLE_VECTOR_DEFAULT_ALLOCATOR allocator_type(CORSAC_TILED_TUPLE_VECTOR_DEFAULT_NAME)
+    #endif
+
+    namespace TupleVecInternal
+    {
+        // Раскладка одной плитки: смещение колонки I и размер плитки в байтах.
+        template <size_t TileSize, typename... Ts>
+        struct TiledTupleLayout
+        {
+            using size_type = size_t;
+
+            TiledTupleLayout() = delete;
+
+            static constexpr size_type GetTotalAlignment()
+            {
+                size_type alignment = CORSAC_TILED_TUPLE_VECTOR_ALIGNMENT;
+                const size_type alignments[] = { alignof(Ts)... };
+                for(size_type a : alignments)
+                    alignment = (a > alignment) ? a : alignment;
+                return alignment;
+            }
+
+            static constexpr size_type kAlignment = GetTotalAlignment();
+
+            static constexpr size_type CalculateColumnSize(size_type size)
+            {
+                return (size * TileSize + kAlignment - 1) & (~kAlignment + 1);
+            }
+
+            template <size_type I>
+            static constexpr size_type GetColumnOffset()
+            {
+                const size_type sizes[] = { CalculateColumnSize(sizeof(Ts))... };
+                size_type offset = 0;
+                for(size_type i = 0; i < I; ++i)
+                    offset += sizes[i];
+                return offset;
+            }
+
+            static constexpr size_type kTileBytes = GetColumnOffset<sizeof...(Ts)>();
+        };
+
+        // Как и TupleVecIter, итератор хранит индекс и разрешает адрес элемента при разыменовании.
+        template <size_t TileSize, typename Indices, typename... Ts>
+        struct TiledTupleVecIter;
+
+        template <size_t TileSize, size_t... Indices, typename... Ts>
+        struct TiledTupleVecIter<TileSize, index_sequence<Indices...>, Ts...>
+        : public iterator<random_access_iterator_tag, tuple<Ts...>, size_t, tuple<Ts*...>, tuple<Ts&...>>
+        {
+        private:
+            using this_type = TiledTupleVecIter<TileSize, index_sequence<Indices...>, Ts...>;
+            using size_type = size_t;
+            using layout    = TiledTupleLayout<TileSize, remove_const_t<Ts>...>;
+
+            using iter_type = iterator<random_access_iterator_tag, tuple<Ts...>, size_t, tuple<Ts*...>, tuple<Ts&...>>;
+
+            template <size_t U, typename V, typename... Us>
+            friend struct TiledTupleVecIter;
+
+        public:
+            using iterator_category = typename iter_type::iterator_category;
+            using value_type        = typename iter_type::value_type;
+            using difference_type   = typename iter_type::difference_type;
+            using pointer           = typename iter_type::pointer;
+            using reference         = typename iter_type::reference;
+
+            TiledTupleVecIter() = default;
+
+            TiledTupleVecIter(const void* pData, size_type index)
+            : mIndex(index), mpData((const char*)pData)
+            {}
+
+            template <typename... Us,
+                    typename = typename enable_if<TupleVecIterCompatible<TupleTypes<Us...>, TupleTypes<Ts...>>::value, bool>::type>
+            TiledTupleVecIter(const TiledTupleVecIter<TileSize, index_sequence<Indices...>, Us...>& other)
+            : mIndex(other.mIndex), mpData(other.mpData)
+            {}
+
+            bool operator==(const TiledTupleVecIter& other) const { return mIndex == other.mIndex && mpData == other.mpData; }
+            bool operator!=(const TiledTupleVecIter& other) const { return mIndex != other.mIndex || mpData != other.mpData; }
+            reference operator*() const { return reference(*MakePointer<Indices>()...); }
+
+            this_type& operator++() { ++mIndex; return *this; }
+            this_type operator++(int)
+            {
+                this_type temp = *this;
+                ++mIndex;
+                return temp;
+            }
+
+            this_type& operator--() { --mIndex; return *this; }
+            this_type operator--(int)
+            {
+                this_type temp = *this;
+                --mIndex;
+                return temp;
+            }
+
+            this_type& operator+=(difference_type n) { mIndex += n; return *this; }
+            this_type operator+(difference_type n) const
+            {
+                this_type temp = *this;
+                return temp += n;
+            }
+
+            friend this_type operator+(difference_type n, const this_type& rhs)
+            {
+                this_type temp = rhs;
+                return temp += n;
+            }
+
+            this_type& operator-=(difference_type n) { mIndex -= n; return *this; }
+            this_type operator-(difference_type n) const
+            {
+                this_type temp = *this;
+                return temp -= n;
+            }
+
+            difference_type operator-(const this_type& rhs) const { return mIndex - rhs.mIndex; }
+            bool operator<(const this_type& rhs) const { return mIndex < rhs.mIndex; }
+            bool operator>(const this_type& rhs) const { return mIndex > rhs.mIndex; }
+            bool operator>=(const this_type& rhs) const { return mIndex >= rhs.mIndex; }
+            bool operator<=(const this_type& rhs) const { return mIndex <= rhs.mIndex; }
+
+            reference operator[](const size_type n) const
+            {
+                return *(*this + n);
+            }
+
+            size_type index() const { return mIndex; }
+
+        private:
+            template <size_type I>
+            tuplevec_element_t<I, Ts...>* MakePointer() const
+            {
+                return (tuplevec_element_t<I, Ts...>*)(mpData + (mIndex / TileSize) * layout::kTileBytes +
+                        layout::template GetColumnOffset<I>()) + (mIndex % TileSize);
+            }
+
+            size_type mIndex = 0;
+            const char* mpData = nullptr;
+        };
+
+        // TiledTupleVecImpl
+        template <typename Allocator, size_t TileSize, typename Indices, typename... Ts>
+        class TiledTupleVecImpl;
+
+        template <typename Allocator, size_t TileSize, size_t... Indices, typename... Ts>
+        class TiledTupleVecImpl<Allocator, TileSize, index_sequence<Indices...>, Ts...>
+        {
+            static_assert(sizeof...(Ts) > 0, "tiled_tuple_vector requires at least one column");
+            static_assert(TileSize > 0 && (TileSize & (TileSize - 1)) == 0, "tiled_tuple_vector TileSize must be a power of two");
+
+            using allocator_type        = Allocator;
+            using index_sequence_type   = index_sequence<Indices...>;
+            using this_type             = TiledTupleVecImpl<Allocator, TileSize, index_sequence_type, Ts...>;
+            using layout                = TiledTupleLayout<TileSize, Ts...>;
+
+        public:
+            using iterator                  = TiledTupleVecIter<TileSize, index_sequence_type, Ts...>;
+            using const_iterator            = TiledTupleVecIter<TileSize, index_sequence_type, const Ts...>;
+            using reverse_iterator          = corsac::reverse_iterator<iterator>;
+            using const_reverse_iterator    = corsac::reverse_iterator<const_iterator>;
+            using size_type                 = size_t;
+            using value_tuple               = corsac::tuple<Ts...>;
+            using reference_tuple           = corsac::tuple<Ts&...>;
+            using const_reference_tuple     = corsac::tuple<const Ts&...>;
+            using rvalue_tuple              = corsac::tuple<Ts&&...>;
+
+            static constexpr size_type kTileSize  = TileSize;
+            static constexpr size_type kAlignment = layout::kAlignment;
+            static constexpr size_type kTileBytes = layout::kTileBytes;
+
+            TiledTupleVecImpl(): mDataSizeAndAllocator(0, CORSAC_TILED_TUPLE_VECTOR_DEFAULT_ALLOCATOR)
+            {}
+
+            explicit TiledTupleVecImpl(const allocator_type& allocator): mDataSizeAndAllocator(0, allocator)
+            {}
+
+            TiledTupleVecImpl(this_type&& x) noexcept
+            : mDataSizeAndAllocator(0, corsac::move(x.get_allocator()))
+            {
+                swap(x);
+            }
+
+            TiledTupleVecImpl(const this_type& x)
+            : mDataSizeAndAllocator(0, x.get_allocator())
+            {
+                DoReallocate(x.mNumElements);
+                mNumElements = x.mNumElements;
+                swallow((DoUninitializedCopyColumn<Indices>(x), 0)...);
+            }
+
+            explicit TiledTupleVecImpl(size_type n, const allocator_type& allocator = CORSAC_TILED_TUPLE_VECTOR_DEFAULT_ALLOCATOR)
+            : mDataSizeAndAllocator(0, allocator)
+            {
+                resize(n);
+            }
+
+            TiledTupleVecImpl(size_type n, const Ts&... args)
+            : mDataSizeAndAllocator(0, CORSAC_TILED_TUPLE_VECTOR_DEFAULT_ALLOCATOR)
+            {
+                resize(n, args...);
+            }
+
+            TiledTupleVecImpl(std::initializer_list<value_tuple> iList, const allocator_type& allocator = CORSAC_TILED_TUPLE_VECTOR_DEFAULT_ALLOCATOR)
+            : mDataSizeAndAllocator(0, allocator)
+            {
+                reserve(iList.size());
+                for(const value_tuple& tup : iList)
+                    push_back(corsac::get<Indices>(tup)...);
+            }
+
+            ~TiledTupleVecImpl()
+            {
+                clear();
+                if(mpData)
+                    CORSAC_Free(get_allocator(), mpData, internalDataSize());
+            }
+
+            this_type& operator=(const this_type& other)
+            {
+                if(this != &other)
+                {
+                    this_type temp(other);
+                    swap(temp);
+                }
+                return *this;
+            }
+
+            this_type& operator=(this_type&& other)
+            {
+                if(this != &other)
+                    swap(other);
+                return *this;
+            }
+
+            reference_tuple push_back()
+            {
+                DoGrow(mNumElements + 1);
+                const size_type n = mNumElements++;
+                swallow(::new(DoGetPointer<Indices>(n)) Ts()...);
+                return back();
+            }
+
+            void push_back(const Ts&... args)
+            {
+                DoGrow(mNumElements + 1);
+                const size_type n = mNumElements++;
+                swallow(::new(DoGetPointer<Indices>(n)) Ts(args)...);
+            }
+
+            void push_back_uninitialized()
+            {
+                DoGrow(mNumElements + 1);
+                ++mNumElements;
+            }
+
+            reference_tuple emplace_back(Ts&&... args)
+            {
+                DoGrow(mNumElements + 1);
+                const size_type n = mNumElements++;
+                swallow(::new(DoGetPointer<Indices>(n)) Ts(corsac::forward<Ts>(args))...);
+                return back();
+            }
+
+            void push_back(Ts&&... args) { emplace_back(corsac::forward<Ts>(args)...); }
+            void push_back(const_reference_tuple tup) { push_back(corsac::get<Indices>(tup)...); }
+            void push_back(rvalue_tuple tup) { emplace_back(corsac::forward<Ts>(corsac::get<Indices>(tup))...); }
+
+            void pop_back()
+            {
+                #if CORSAC_ASSERT_ENABLED
+                    if (CORSAC_UNLIKELY(mNumElements <= 0))
+                        CORSAC_FAIL_MSG("tiled_tuple_vector::pop_back -- container is empty");
+                #endif
+                const size_type n = --mNumElements;
+                swallow((corsac::destruct(DoGetPointer<Indices>(n)), 0)...);
+            }
+
+            template<typename Function>
+            void each(Function function)
+            {
+                for(size_type i = 0; i < mNumElements; ++i)
+                    function(i, *DoGetPointer<Indices>(i)...);
+            }
+
+            // function(count, Ts* columns...) для каждой плитки, count == TileSize для всех кроме последней.
+            template<typename Function>
+            void each_tile(Function function)
+            {
+                for(size_type t = 0, tiles = tile_count(); t < tiles; ++t)
+                    function(tile_elements(t), tile<Indices>(t)...);
+            }
+
+            iterator erase(const_iterator first, const_iterator last)
+            {
+                #if CORSAC_ASSERT_ENABLED
+                    if (CORSAC_UNLIKELY(first > last || last.index() > mNumElements))
+                        {CORSAC_FAIL_MSG("tiled_tuple_vector::erase -- invalid iterator pair")}
+                #endif
+                const size_type firstIdx = first.index();
+                const size_type lastIdx  = last.index();
+                if(firstIdx != lastIdx)
+                {
+                    const size_type oldNumElements = mNumElements;
+                    const size_type newNumElements = oldNumElements - (lastIdx - firstIdx);
+                    swallow((DoMoveRange<Indices>(lastIdx, oldNumElements, firstIdx), 0)...);
+                    swallow((DoDestructRange<Indices>(newNumElements, oldNumElements), 0)...);
+                    mNumElements = newNumElements;
+                }
+                return begin() + firstIdx;
+            }
+
+            iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+            iterator erase_unsorted(size_type n)
+            {
+                #if CORSAC_ASSERT_ENABLED
+                    if (CORSAC_UNLIKELY(n >= mNumElements))
+                        {CORSAC_FAIL_MSG("tiled_tuple_vector::erase_unsorted -- invalid index")}
+                #endif
+                const size_type last = --mNumElements;
+                if(n != last)
+                    swallow((*DoGetPointer<Indices>(n) = corsac::move(*DoGetPointer<Indices>(last)), 0)...);
+                swallow((corsac::destruct(DoGetPointer<Indices>(last)), 0)...);
+                return begin() + n;
+            }
+
+            iterator erase_unsorted(const_iterator pos) { return erase_unsorted(pos.index()); }
+
+            void resize(size_type n)
+            {
+                const size_type oldNumElements = mNumElements;
+                if(n > oldNumElements)
+                {
+                    DoConditionalReallocate(n);
+                    for(size_type i = oldNumElements; i < n; ++i)
+                        swallow(::new(DoGetPointer<Indices>(i)) Ts()...);
+                }
+                else
+                {
+                    swallow((DoDestructRange<Indices>(n, oldNumElements), 0)...);
+                }
+                mNumElements = n;
+            }
+
+            void resize(size_type n, const Ts&... args)
+            {
+                const size_type oldNumElements = mNumElements;
+                if(n > oldNumElements)
+                {
+                    DoConditionalReallocate(n);
+                    for(size_type i = oldNumElements; i < n; ++i)
+                        swallow(::new(DoGetPointer<Indices>(i)) Ts(args)...);
+                }
+                else
+                {
+                    swallow((DoDestructRange<Indices>(n, oldNumElements), 0)...);
+                }
+                mNumElements = n;
+            }
+
+            void reserve(size_type n)
+            {
+                DoConditionalReallocate(n);
+            }
+
+            void shrink_to_fit()
+            {
+                if(DoRoundUpCapacity(mNumElements) < mNumCapacity)
+                    DoReallocate(mNumElements);
+            }
+
+            void clear() noexcept
+            {
+                swallow((DoDestructRange<Indices>(0, mNumElements), 0)...);
+                mNumElements = 0;
+            }
+
+            void swap(this_type& x)
+            {
+                corsac::swap(mpData, x.mpData);
+                corsac::swap(mNumElements, x.mNumElements);
+                corsac::swap(mNumCapacity, x.mNumCapacity);
+                corsac::swap(get_allocator(), x.get_allocator());
+                corsac::swap(internalDataSize(), x.internalDataSize());
+            }
+
+            bool empty() const noexcept { return mNumElements == 0; }
+            size_type size() const noexcept { return mNumElements; }
+            size_type capacity() const noexcept { return mNumCapacity; }
+
+            // Число плиток, в которых есть хотя бы один элемент.
+            size_type tile_count() const noexcept { return (mNumElements + TileSize - 1) / TileSize; }
+
+            // Число сконструированных элементов в плитке t.
+            size_type tile_elements(size_type t) const noexcept
+            {
+                const size_type first = t * TileSize;
+                return (mNumElements - first < TileSize) ? (mNumElements - first) : TileSize;
+            }
+
+            // Колонка I плитки t, выровнена на kAlignment.
+            template <size_type I>
+            tuplevec_element_t<I, Ts...>* tile(size_type t) noexcept
+            {
+                return (tuplevec_element_t<I, Ts...>*)(mpData + t * kTileBytes + layout::template GetColumnOffset<I>());
+            }
+
+            template <size_type I>
+            const tuplevec_element_t<I, Ts...>* tile(size_type t) const noexcept
+            {
+                return (const tuplevec_element_t<I, Ts...>*)(mpData + t * kTileBytes + layout::template GetColumnOffset<I>());
+            }
+
+            iterator begin() noexcept { return iterator(mpData, 0); }
+            const_iterator begin() const noexcept { return const_iterator(mpData, 0); }
+            const_iterator cbegin() const noexcept { return const_iterator(mpData, 0); }
+
+            iterator end() noexcept { return iterator(mpData, mNumElements); }
+            const_iterator end() const noexcept { return const_iterator(mpData, mNumElements); }
+            const_iterator cend() const noexcept { return const_iterator(mpData, mNumElements); }
+
+            reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+            const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+            const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(end()); }
+
+            reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+            const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+            const_reverse_iterator crend() const noexcept { return const_reverse_iterator(begin()); }
+
+            reference_tuple at(size_type n)
+            {
+                #if CORSAC_EXCEPTIONS_ENABLED
+                    if (CORSAC_UNLIKELY(n >= mNumElements))
+                        throw std::out_of_range("tiled_tuple_vector::at -- out of range");
+                #elif CORSAC_ASSERT_ENABLED
+                    if (CORSAC_UNLIKELY(n >= mNumElements))
+                        {CORSAC_FAIL_MSG("tiled_tuple_vector::at -- out of range")}
+                #endif
+                return reference_tuple(*DoGetPointer<Indices>(n)...);
+            }
+
+            const_reference_tuple at(size_type n) const
+            {
+                #if CORSAC_EXCEPTIONS_ENABLED
+                    if (CORSAC_UNLIKELY(n >= mNumElements))
+                        throw std::out_of_range("tiled_tuple_vector::at -- out of range");
+                #elif CORSAC_ASSERT_ENABLED
+                    if (CORSAC_UNLIKELY(n >= mNumElements))
+                        {CORSAC_FAIL_MSG("tiled_tuple_vector::at -- out of range")}
+                #endif
+                return const_reference_tuple(*DoGetPointer<Indices>(n)...);
+            }
+
+            reference_tuple operator[](size_type n) { return at(n); }
+            const_reference_tuple operator[](size_type n) const { return at(n); }
+
+            reference_tuple front() { return at(0); }
+            const_reference_tuple front() const { return at(0); }
+
+            reference_tuple back() { return at(size() - 1); }
+            const_reference_tuple back() const { return at(size() - 1); }
+
+            // Элемент n колонки I. В отличие от tuple_vector::get<I>(), колонка целиком не непрерывна.
+            template <size_type I>
+            tuplevec_element_t<I, Ts...>& get(size_type n) { return *DoGetPointer<I>(n); }
+
+            template <size_type I>
+            const tuplevec_element_t<I, Ts...>& get(size_type n) const { return *DoGetPointer<I>(n); }
+
+            template <typename T>
+            T& get(size_type n) { return *DoGetPointer<tuplevec_index<T, TupleTypes<Ts...>>::index>(n); }
+
+            template <typename T>
+            const T& get(size_type n) const { return *DoGetPointer<tuplevec_index<T, TupleTypes<Ts...>>::index>(n); }
+
+            bool validate() const noexcept
+            {
+                if(mNumElements > mNumCapacity || (mNumCapacity % TileSize) != 0)
+                    return false;
+                if(((uintptr_t)mpData & (kAlignment - 1)) != 0)
+                    return false;
+                return true;
+            }
+
+            allocator_type& get_allocator() noexcept { return mDataSizeAndAllocator.second(); }
+            const allocator_type& get_allocator() const noexcept { return mDataSizeAndAllocator.second(); }
+
+            void set_allocator(const allocator_type& alloc) { mDataSizeAndAllocator.second() = alloc; }
+
+        protected:
+            char* mpData = nullptr;         // Начало первой плитки, выровнено на kAlignment.
+            size_type mNumElements = 0;
+            size_type mNumCapacity = 0;
+
+            compressed_pair<size_type, allocator_type> mDataSizeAndAllocator;
+
+            size_type& internalDataSize() noexcept { return mDataSizeAndAllocator.first(); }
+            size_type const& internalDataSize() const noexcept { return mDataSizeAndAllocator.first(); }
+
+            template <size_type I>
+            tuplevec_element_t<I, Ts...>* DoGetPointer(size_type n) const noexcept
+            {
+                return (tuplevec_element_t<I, Ts...>*)(mpData + (n / TileSize) * kTileBytes +
+                        layout::template GetColumnOffset<I>()) + (n % TileSize);
+            }
+
+            template <size_type I>
+            void DoDestructRange(size_type first, size_type last)
+            {
+                for(size_type i = first; i < last; ++i)
+                    corsac::destruct(DoGetPointer<I>(i));
+            }
+
+            template <size_type I>
+            void DoMoveRange(size_type first, size_type last, size_type dest)
+            {
+                for(size_type i = first; i < last; ++i, ++dest)
+                    *DoGetPointer<I>(dest) = corsac::move(*DoGetPointer<I>(i));
+            }
+
+            template <size_type I>
+            void DoUninitializedCopyColumn(const this_type& x)
+            {
+                using T = tuplevec_element_t<I, Ts...>;
+                for(size_type t = 0, tiles = x.tile_count(); t < tiles; ++t)
+                {
+                    const T* pSrc = x.template tile<I>(t);
+                    corsac::uninitialized_copy_ptr(pSrc, pSrc + x.tile_elements(t), tile<I>(t));
+                }
+            }
+
+            // Раскладка плиток не зависит от емкости, поэтому колонка переносится плитка за плиткой.
+            template <size_type I>
+            void DoUninitializedMoveAndDestructColumn(char* pNewData)
+            {
+                using T = tuplevec_element_t<I, Ts...>;
+                for(size_type t = 0, tiles = tile_count(); t < tiles; ++t)
+                {
+                    T* pBegin = tile<I>(t);
+                    T* pEnd = pBegin + tile_elements(t);
+                    corsac::uninitialized_move_ptr_if_noexcept(pBegin, pEnd,
+                            (T*)(pNewData + t * kTileBytes + layout::template GetColumnOffset<I>()));
+                    corsac::destruct(pBegin, pEnd);
+                }
+            }
+
+            static size_type DoRoundUpCapacity(size_type n)
+            {
+                return (n + TileSize - 1) & ~(TileSize - 1);
+            }
+
+            void DoGrow(size_type requiredCapacity)
+            {
+                if(requiredCapacity > mNumCapacity)
+                    DoReallocate(corsac::max<size_type>(2 * mNumCapacity, requiredCapacity));
+            }
+
+            void DoConditionalReallocate(size_type requiredCapacity)
+            {
+                if(requiredCapacity > mNumCapacity)
+                    DoReallocate(requiredCapacity);
+            }
+
+            void DoReallocate(size_type requiredCapacity)
+            {
+                const size_type newCapacity = DoRoundUpCapacity(requiredCapacity);
+                const size_type newDataSize = (newCapacity / TileSize) * kTileBytes;
+                char* pNewData = newCapacity ? (char*)allocate_memory(get_allocator(), newDataSize, kAlignment, 0) : nullptr;
+
+                swallow((DoUninitializedMoveAndDestructColumn<Indices>(pNewData), 0)...);
+
+                if(mpData)
+                    CORSAC_Free(get_allocator(), mpData, internalDataSize());
+                mpData = pNewData;
+                mNumCapacity = newCapacity;
+                internalDataSize() = newDataSize;
+            }
+        };
+    } // namespace TupleVecInternal
+
+    template <typename AllocatorA, typename AllocatorB, size_t TileSize, typename Indices, typename... Ts>
+    inline bool operator==(const TupleVecInternal::TiledTupleVecImpl<AllocatorA, TileSize, Indices, Ts...>& a,
+                           const TupleVecInternal::TiledTupleVecImpl<AllocatorB, TileSize, Indices, Ts...>& b)
+    {
+        return ((a.size() == b.size()) && corsac::equal(a.begin(), a.end(), b.begin()));
+    }
+
+    template <typename AllocatorA, typename AllocatorB, size_t TileSize, typename Indices, typename... Ts>
+    inline bool operator!=(const TupleVecInternal::TiledTupleVecImpl<AllocatorA, TileSize, Indices, Ts...>& a,
+                           const TupleVecInternal::TiledTupleVecImpl<AllocatorB, TileSize, Indices, Ts...>& b)
+    {
+        return !(a == b);
+    }
+
+    template <typename Allocator, size_t TileSize, typename Indices, typename... Ts>
+    inline void swap(TupleVecInternal::TiledTupleVecImpl<Allocator, TileSize, Indices, Ts...>& a,
+                     TupleVecInternal::TiledTupleVecImpl<Allocator, TileSize, Indices, Ts...>& b)
+    {
+        a.swap(b);
+    }
+
+    // Внешний интерфейс tiled_tuple_vector
+    template <size_t TileSize, typename... Ts>
+    class tiled_tuple_vector
+            : public TupleVecInternal::TiledTupleVecImpl<CORSAC_ALLOCATOR_TYPE, TileSize, make_index_sequence<sizeof...(Ts)>, Ts...>
+    {
+        using this_type = tiled_tuple_vector<TileSize, Ts...>;
+        using base_type = TupleVecInternal::TiledTupleVecImpl<CORSAC_ALLOCATOR_TYPE, TileSize, make_index_sequence<sizeof...(Ts)>, Ts...>;
+        using base_type::base_type;
+
+    public:
+        using value_type                = typename base_type::value_tuple;
+        using reference                 = typename base_type::reference_tuple;
+        using const_reference           = typename base_type::const_reference_tuple;
+    };
+
+    // Вариант tiled_tuple_vector с пользовательским типом распределителя
+    template <typename AllocatorType, size_t TileSize, typename... Ts>
+    class tiled_tuple_vector_alloc
+            : public TupleVecInternal::TiledTupleVecImpl<AllocatorType, TileSize, make_index_sequence<sizeof...(Ts)>, Ts...>
+    {
+        using this_type = tiled_tuple_vector_alloc<AllocatorType, TileSize, Ts...>;
+        using base_type = TupleVecInternal::TiledTupleVecImpl<AllocatorType, TileSize, make_index_sequence<sizeof...(Ts)>, Ts...>;
+        using base_type::base_type;
+    };
+
+} // corsac
+
+#endif //CORSAC_STL_TILED_TUPLE_VECTOR_H
@@ -0,0 +1,399 @@
+/**
+ * corsac::STL
+ *
+ * transform_hierarchy.h
+ *
+ * Created by Falldot on 18.10.2026.
+ * Copyright (c) 2021 Corsac. All rights reserved.
+ */
+#ifndef CORSAC_STL_TRANSFORM_HIERARCHY_H
+#define CORSAC_STL_TRANSFORM_HIERARCHY_H
+
+#pragma once
+/**
+ * Описание (Falldot 18.10.2026)
+ *
+ * transform_hierarchy - иерархия трансформаций без указателей на детей. Все узлы лежат в колонках
+ * одного corsac::tuple_vector (локальная матрица, мировая матрица, родитель, размер поддерева,
+ * ключ, флаг изменения) в прямом порядке обхода дерева: родитель всегда раньше детей, а поддерево
+ * узла - непрерывный отрезок строк [row, row + subtree_size(row)).
+ *
+ * Поэтому пересчет мировых матриц - один линейный проход по строкам: флаг изменения строки
+ * объединяется с флагом родителя (родитель уже обработан), и измененные строки умножают мировую
+ * матрицу родителя на свою локальную. Отрезки поддеревьев корней не зависят друг от друга и могут
+ * считаться разными задачами: update_range для каждого, затем clear_dirty.
+ *
+ * Узлы адресуются ключами slot_map_key: строки узлов меняются при перестройке порядка, ключи - нет.
+ * Новый узел дописывается в конец. Для корня и для ребенка, чье поддерево кончается последней
+ * строкой (дерево строится в глубину), порядок сохраняется; иначе он, как и после set_parent,
+ * восстанавливается за O(n) при следующем update (или явном sort) обходом списков детей и одной
+ * перестановкой колонок (tuple_vector::apply_permutation). Пакет структурных изменений между
+ * кадрами обходится в одну перестройку. destroy удаляет отрезок поддерева и сдвигает строки за ним.
+ *
+ * transform_matrix - аффинная матрица 3x4 по строкам (поворот и масштаб 3x3, перенос в четвертом
+ * столбце); мировая матрица узла = мировая матрица родителя * локальная.
+ *
+ * ---------------------------------------------------------------------------------------------------
+ * === Классы:
+ *
+ *      transform_matrix                Аффинная матрица 3x4.
+ *      transform_hierarchy             Иерархия в колонках tuple_vector.
+ *
+ * Пример использования:
+ *      corsac::transform_hierarchy scene;
+ *      auto body = scene.create(corsac::transform_matrix::translation(0.0f, 1.0f, 0.0f));
+ *      auto hand = scene.create(corsac::transform_matrix::translation(0.5f, 0.0f, 0.0f), body);
+ *      scene.set_local(body, ...);
+ *      scene.update();                            // Пересчитаны body и hand.
+ *      const corsac::transform_matrix& m = scene.world(hand);
+ */
+
+#include "Corsac/STL/config.h"
+#include "Corsac/tuple_vector.h"
+#include "Corsac/slot_map.h"
+#include "Corsac/vector.h"
+
+#include <string.h>
+
+namespace corsac
+{
+    // CORSAC_TRANSFORM_HIERARCHY_DEFAULT_NAME
+    #ifndef CORSAC_TRANSFORM_HIERARCHY_DEFAULT_NAME
+        #define CORSAC_TRANSFORM_HIERARCHY_DEFAULT_NAME CORSAC_DEFAULT_NAME_PREFIX " transform_hierarchy"
+    #endif
+
+    // CORSAC_TRANSFORM_HIERARCHY_DEFAULT_ALLOCATOR
+    #ifndef CORSAC_TRANSFORM_HIERARCHY_DEFAULT_ALLOCATOR
+        #define CORSAC_TRANSFORM_HIERARCHY_DEFAULT_ALLOCATOR CORSAC_ALLOCATOR_TYPE(CORSAC_TRANSFORM_HIERARCHY_DEFAULT_NAME)
+    #endif
+
+    /**
+     * transform_matrix
+     */
+    struct transform_matrix
+    {
+        float m[12];    // Строки r0 r1 r2 по 4 элемента: m[4 * i + 3] - перенос.
+
+        static constexpr transform_matrix identity() noexcept
+        {
+            return transform_matrix{ { 1.0f, 0.0f, 0.0f, 0.0f,
+                                       0.0f, 1.0f, 0.0f, 0.0f,
+                                       0.0f, 0.0f, 1.0f, 0.0f } };
+        }
+
+        static constexpr transform_matrix translation(float x, float y, float z) noexcept
+        {
+            return transform_matrix{ { 1.0f, 0.0f, 0.0f, x,
+                                       0.0f, 1.0f, 0.0f, y,
+                                       0.0f, 0.0f, 1.0f, z } };
+        }
+
+        static constexpr transform_matrix scale(float x, float y, float z) noexcept
+        {
+            return transform_matrix{ { x,    0.0f, 0.0f, 0.0f,
+                                       0.0f, y,    0.0f, 0.0f,
+                                       0.0f, 0.0f, z,    0.0f } };
+        }
+
+        bool operator==(const transform_matrix& x) const noexcept { return memcmp(m, x.m, sizeof(m)) == 0; }
+        bool operator!=(const transform_matrix& x) const noexcept { return !(*this == x); }
+    };
+
+    // a * b: сначала применяется b, затем a.
+    inline transform_matrix operator*(const transform_matrix& a, const transform_matrix& b) noexcept
+    {
+        transform_matrix r;
+        for(int i = 0; i < 3; ++i)
+        {
+            const float* row = a.m + 4 * i;
+            for(int j = 0; j < 4; ++j)
+                r.m[4 * i + j] = row[0] * b.m[j] + row[1] * b.m[4 + j] + row[2] * b.m[8 + j];
+            r.m[4 * i + 3] += row[3];
+        }
+        return r;
+    }
+
+    /**
+     * transform_hierarchy
+     */
+    class transform_hierarchy
+    {
+    public:
+        using node      = slot_map_key;
+        using size_type = uint32_t;
+
+        static constexpr size_type npos = 0xFFFFFFFFu;
+
+        transform_hierarchy();
+
+        // Новый узел - ребенок parent (null - корень). Мировая матрица действительна после update.
+        node create(const transform_matrix& local = transform_matrix::identity(), node parent = node());
+
+        // Уничтожает узел вместе с поддеревом. Возвращает число уничтоженных узлов.
+        size_type destroy(node n);
+
+        bool contains(node n) const noexcept { return mNodes.contains(n); }
+
+        // parent не может лежать в поддереве n.
+        void set_parent(node n, node parent);
+        node parent(node n) const;
+
+        void set_local(node n, const transform_matrix& local);
+        const transform_matrix& local(node n) const { return mColumns.get<kLocal>()[row(n)]; }
+        const transform_matrix& world(node n) const { return mColumns.get<kWorld>()[row(n)]; }
+
+        // Строка узла; меняется при перестройке порядка.
+        size_type row(node n) const { return mNodes[n]; }
+
+        size_type size() const noexcept { return (size_type)mColumns.size(); }
+        bool empty() const noexcept { return mColumns.empty(); }
+
+        // Восстанавливает прямой порядок, если он нарушен. update вызывает sort сам.
+        void sort();
+        bool sorted() const noexcept { return !mOrderDirty; }
+
+        // Пересчитывает мировые матрицы измененных узлов и снимает флаги.
+        void update();
+
+        // Для разбиения на задачи, после sort: строки [first, last) пересчитываются, если строки
+        // их родителей вне отрезка уже пересчитаны. Флаги снимает clear_dirty после всех отрезков.
+        void update_range(size_type first, size_type last);
+        void clear_dirty();
+
+        // Отрезки поддеревьев после sort: корни - строки 0, subtree_size(0), ... до size().
+        size_type subtree_size(size_type row) const { return mColumns.get<kSubtreeSize>()[row]; }
+        size_type parent_row(size_type row) const { return mColumns.get<kParent>()[row]; }
+        node key_at(size_type row) const { return mColumns.get<kKey>()[row]; }
+
+        const transform_matrix* local_data() const noexcept { return mColumns.get<kLocal>(); }
+        const transform_matrix* world_data() const noexcept { return mColumns.get<kWorld>(); }
+
+        bool validate() const;
+
+    protected:
+        enum column_index : size_t
+        {
+            kLocal,
+            kWorld,
+            kParent,        // Строка родителя, npos у корня. Меньше строки узла, пока порядок не нарушен.
+            kSubtreeSize,   // Действителен, пока порядок не нарушен.
+            kKey,
+            kDirty
+        };
+
+        using columns_type = tuple_vector<transform_matrix, transform_matrix, uint32_t, uint32_t, node, uint8_t>;
+
+        columns_type        mColumns;
+        slot_map<size_type> mNodes;             // Ключ -> строка.
+        bool                mOrderDirty = false;
+
+        // Рабочие массивы sort, сохраняются между вызовами.
+        vector<size_type>   mChildStart;
+        vector<size_type>   mChildren;
+        vector<size_type>   mStack;
+        vector<size_t>      mPermutation;
+    };
+
+    inline transform_hierarchy::transform_hierarchy()
+        : mChildStart(CORSAC_TRANSFORM_HIERARCHY_DEFAULT_ALLOCATOR), mChildren(CORSAC_TRANSFORM_HIERARCHY_DEFAULT_ALLOCATOR),
+          mStack(CORSAC_TRANSFORM_HIERARCHY_DEFAULT_ALLOCATOR), mPermutation(CORSAC_TRANSFORM_HIERARCHY_DEFAULT_ALLOCATOR)
+    {}
+
+    inline transform_hierarchy::node transform_hierarchy::create(const transform_matrix& local, node parent)
+    {
+        const size_type r = size();
+        size_type parentRow = npos;
+        if(!parent.is_null())
+        {
+            parentRow = row(parent);
+            // Ребенок в конце сохраняет прямой порядок, если поддерево родителя кончается последней строкой
+            // (например, дерево строится в глубину): тогда растут только размеры поддеревьев предков.
+            if(!mOrderDirty && parentRow + subtree_size(parentRow) == r)
+            {
+                uint32_t* sizes = mColumns.get<kSubtreeSize>();
+                for(size_type p = parentRow; p != npos; p = parent_row(p))
+                    ++sizes[p];
+            }
+            else
+                mOrderDirty = true;
+        }
+
+        const node n = mNodes.insert(r);
+        mColumns.push_back(local, local, parentRow, 1u, n, uint8_t(1));
+        return n;
+    }
+
+    inline transform_hierarchy::size_type transform_hierarchy::destroy(node n)
+    {
+        if(!contains(n))
+            return 0;
+        sort();
+
+        const size_type first = row(n);
+        const size_type count = subtree_size(first);
+        const size_type last  = first + count;
+        for(size_type r = first; r < last; ++r)
+            mNodes.erase(key_at(r));
+
+        // Предки теряют count строк, строки и родители за отрезком сдвигаются на count.
+        uint32_t* parents = mColumns.get<kParent>();
+        uint32_t* sizes   = mColumns.get<kSubtreeSize>();
+        for(size_type p = parents[first]; p != npos; p = parents[p])
+            sizes[p] -= count;
+        mColumns.erase(mColumns.begin() + first, mColumns.begin() + last);
+
+        parents = mColumns.get<kParent>();
+        const node* keys = mColumns.get<kKey>();
+        for(size_type r = first, end = size(); r < end; ++r)
+        {
+            mNodes[keys[r]] = r;
+            if(parents[r] != npos && parents[r] >= last)
+                parents[r] -= count;
+        }
+        return count;
+    }
+
+    inline void transform_hierarchy::set_parent(node n, node parent)
+    {
+        const size_type r = row(n);
+        size_type parentRow = npos;
+        if(!parent.is_null())
+        {
+            parentRow = row(parent);
+            for(size_type p = parentRow; p != npos; p = parent_row(p))
+                CORSAC_ASSERT_MSG(p != r, "transform_hierarchy::set_parent: parent is inside the subtree of the node.");
+        }
+        mColumns.get<kParent>()[r] = parentRow;
+        mColumns.get<kDirty>()[r]  = 1;
+        mOrderDirty = true;
+    }
+
+    inline transform_hierarchy::node transform_hierarchy::parent(node n) const
+    {
+        const size_type p = parent_row(row(n));
+        return (p == npos) ? node() : key_at(p);
+    }
+
+    inline void transform_hierarchy::set_local(node n, const transform_matrix& local)
+    {
+        const size_type r = row(n);
+        mColumns.get<kLocal>()[r] = local;
+        mColumns.get<kDirty>()[r] = 1;
+    }
+
+    inline void transform_hierarchy::sort()
+    {
+        if(!mOrderDirty)
+            return;
+
+        // Родитель может оказаться после ребенка только после set_parent, поэтому дети собираются
+        // в списки подсчетом по строке родителя (корни - список n), а порядок строится обходом в глубину.
+        const size_type n = size();
+        const uint32_t* parents = mColumns.get<kParent>();
+        mChildStart.assign(n + 2, 0);
+        mChildren.resize(n);
+        for(size_type r = 0; r < n; ++r)
+            ++mChildStart[((parents[r] == npos) ? n : parents[r]) + 1];
+        for(size_type k = 1; k <= n + 1; ++k)
+            mChildStart[k] += mChildStart[k - 1];
+        // Обратный проход с уменьшением сохраняет исходный порядок детей; после него список k
+        // начинается в mChildStart[k + 1] и кончается началом списка k + 1.
+        for(size_type r = n; r-- > 0;)
+            mChildren[--mChildStart[((parents[r] == npos) ? n : parents[r]) + 1]] = r;
+
+        // Дети кладутся в стек в обратном порядке, чтобы обход сохранил исходный.
+        mPermutation.resize(n);
+        mStack.clear();
+        for(size_type i = n; i-- > mChildStart[n + 1];)
+            mStack.push_back(mChildren[i]);
+        for(size_type out = 0; !mStack.empty(); ++out)
+        {
+            const size_type r = mStack.back();
+            mStack.pop_back();
+            mPermutation[out] = r;
+            for(size_type i = mChildStart[r + 2]; i-- > mChildStart[r + 1];)
+                mStack.push_back(mChildren[i]);
+        }
+
+        // Новые строки родителей: mChildren переиспользуется как отображение старой строки в новую.
+        for(size_type r = 0; r < n; ++r)
+            mChildren[mPermutation[r]] = r;
+        mColumns.apply_permutation(mPermutation.data());
+
+        uint32_t* newParents = mColumns.get<kParent>();
+        uint32_t* sizes      = mColumns.get<kSubtreeSize>();
+        const node* keys     = mColumns.get<kKey>();
+        for(size_type r = 0; r < n; ++r)
+        {
+            if(newParents[r] != npos)
+                newParents[r] = mChildren[newParents[r]];
+            sizes[r] = 1;
+            mNodes[keys[r]] = r;
+        }
+        for(size_type r = n; r-- > 0;)
+        {
+            if(newParents[r] != npos)
+                sizes[newParents[r]] += sizes[r];
+        }
+        mOrderDirty = false;
+    }
+
+    inline void transform_hierarchy::update()
+    {
+        sort();
+        update_range(0, size());
+        clear_dirty();
+    }
+
+    inline void transform_hierarchy::update_range(size_type first, size_type last)
+    {
+        CORSAC_ASSERT_MSG(!mOrderDirty, "transform_hierarchy::update_range: call sort() first.");
+        const transform_matrix* local = mColumns.get<kLocal>();
+        transform_matrix* world       = mColumns.get<kWorld>();
+        const uint32_t* parents       = mColumns.get<kParent>();
+        uint8_t* dirty                = mColumns.get<kDirty>();
+        for(size_type r = first; r < last; ++r)
+        {
+            const size_type p = parents[r];
+            if(p == npos)
+            {
+                if(dirty[r])
+                    world[r] = local[r];
+            }
+            else
+            {
+                dirty[r] |= dirty[p];
+                if(dirty[r])
+                    world[r] = world[p] * local[r];
+            }
+        }
+    }
+
+    inline void transform_hierarchy::clear_dirty()
+    {
+        if(!empty())
+            memset(mColumns.get<kDirty>(), 0, size());
+    }
+
+    inline bool transform_hierarchy::validate() const
+    {
+        if(mNodes.size() != size())
+            return false;
+        const uint32_t* parents = mColumns.get<kParent>();
+        const uint32_t* sizes   = mColumns.get<kSubtreeSize>();
+        for(size_type r = 0, n = size(); r < n; ++r)
+        {
+            if(row(key_at(r)) != r)
+                return false;
+            if(mOrderDirty)
+                continue;
+            if(parents[r] != npos && (parents[r] >= r || r >= parents[r] + sizes[parents[r]]))
+                return false;
+            if(r + sizes[r] > n)
+                return false;
+        }
+        return true;
+    }
+}
+
+#endif //CORSAC_STL_TRANSFORM_HIERARCHY_H
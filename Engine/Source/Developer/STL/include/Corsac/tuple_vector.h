@@ -16,6 +16,8 @@
 #include "Corsac/tuple.h"
 #include "Corsac/utility.h"
 
+#include <string.h>
+
 CORSAC_DISABLE_VC_WARNING(4244) // warning C4244: 'conversion from '___' to '___', possible loss of data
 CORSAC_DISABLE_VC_WARNING(4623) // warning C4623: default constructor was implicitly defined as deleted
 CORSAC_DISABLE_VC_WARNING(4625) // warning C4625: copy constructor was implicitly defined as deleted
@@ -34,6 +36,79 @@ namespace corsac
         #define CORSAC_TUPLE_VECTOR_DEFAULT_ALLOCATOR allocator_type(CORSAC_TUPLE_VECTOR_DEFAULT_NAME)
     #endif
 
+    // CORSAC_TUPLE_VECTOR_COLUMN_ALIGNMENT
+    // Минимальное выравнивание начала каждой колонки. 32 байта - ширина регистра AVX.
+    #ifndef CORSAC_TUPLE_VECTOR_COLUMN_ALIGNMENT
+        #define CORSAC_TUPLE_VECTOR_COLUMN_ALIGNMENT 32
+    #endif
+
+    /**
+     * tuple_vector_column_alignment
+     *
+     * Политика выравнивания колонки типа T в tuple_vector. По умолчанию - большее из alignof(T)
+     * и CORSAC_TUPLE_VECTOR_COLUMN_ALIGNMENT. Специализация позволяет задать выравнивание
+     * отдельного типа колонки, например 64 байта для матриц под AVX-512:
+     *
+     *      template <> struct corsac::tuple_vector_column_alignment<Matrix4> : integral_constant<size_t, 64> {};
+     */
+    template <typename T>
+    struct tuple_vector_column_alignment
+            : public integral_constant<size_t, (alignof(T) > CORSAC_TUPLE_VECTOR_COLUMN_ALIGNMENT) ? alignof(T) : CORSAC_TUPLE_VECTOR_COLUMN_ALIGNMENT>
+    {};
+
+    template <typename T>
+    struct tuple_vector_column_alignment<const T> : public tuple_vector_column_alignment<T>
+    {};
+
+    /**
+     * column_span
+     *
+     * Непрерывная колонка tuple_vector: указатель, число элементов и гарантия выравнивания
+     * начала колонки на Alignment байт. Векторизованное ядро может читать колонку выровненными
+     * загрузками с самого первого элемента, без пролога для выравнивания.
+     */
+    template <typename T, size_t Alignment>
+    class column_span
+    {
+    public:
+        using element_type = T;
+        using value_type   = remove_cv_t<T>;
+        using size_type    = size_t;
+        using pointer      = T*;
+        using reference    = T&;
+        using iterator     = T*;
+
+        static constexpr size_type alignment = Alignment;
+
+        column_span() noexcept = default;
+        column_span(T* pData, size_type size) noexcept : mpData(pData), mSize(size) {}
+
+        pointer data() const noexcept { return mpData; }
+
+        // То же, что data(), но с подсказкой компилятору о выравнивании.
+        pointer aligned_data() const noexcept
+        {
+            #if defined(CORSAC_COMPILER_GCC) || defined(CORSAC_COMPILER_CLANG)
+                return static_cast<pointer>(__builtin_assume_aligned(mpData, Alignment));
+            #else
+                return mpData;
+            #endif
+        }
+
+        size_type size() const noexcept { return mSize; }
+        size_type size_bytes() const noexcept { return mSize * sizeof(T); }
+        bool empty() const noexcept { return mSize == 0; }
+
+        iterator begin() const noexcept { return mpData; }
+        iterator end() const noexcept { return mpData + mSize; }
+
+        reference operator[](size_type n) const { return mpData[n]; }
+
+    private:
+        T* mpData = nullptr;
+        size_type mSize = 0;
+    };
+
     namespace TupleVecInternal
     {
         template <size_t I, typename... Ts>
@@ -144,7 +219,7 @@ namespace corsac
                 void* ptr = capacity ? allocate_memory(vec.get_allocator(), offset, alignment, 0) : nullptr;
 
                 #if CORSAC_ASSERT_ENABLED
-                    if (CORSAC_UNLIKELY((size_t)ptr & (alignment - 1)) != 0)
+                    if (CORSAC_UNLIKELY(((size_t)ptr & (alignment - 1)) != 0))
                     {
                         CORSAC_FAIL_MSG("tuple_vector::DoAllocate -- memory not alignment at requested alignment");
                     }
@@ -170,7 +245,7 @@ namespace corsac
 
             static constexpr size_type GetTotalAlignment()
             {
-                return max(alignof(T), TupleRecurser<Ts...>::GetTotalAlignment());
+                return max(tuple_vector_column_alignment<T>::value, TupleRecurser<Ts...>::GetTotalAlignment());
             }
 
             static constexpr size_type GetTotalAllocationSize(size_type capacity, size_type offset)
@@ -204,7 +279,8 @@ namespace corsac
                 return CalculatAllocationOffset(offset) + sizeof(T) * capacity;
             }
 
-            static constexpr size_type CalculatAllocationOffset(size_type offset) { return (offset + alignof(T) - 1) & (~alignof(T) + 1); }
+            static constexpr size_type kColumnAlignment = tuple_vector_column_alignment<T>::value;
+            static constexpr size_type CalculatAllocationOffset(size_type offset) { return (offset + kColumnAlignment - 1) & (~kColumnAlignment + 1); }
         };
 
         template <size_t I, typename T>
@@ -271,9 +347,68 @@ namespace corsac
                 ::new (pDest) T(corsac::forward<T>(arg));
             }
 
+            // Элемент i становится бывшим элементом indices[i]: сбор во временный буфер и перемещение обратно.
+            void DoApplyPermutation(const size_type* indices, size_type numElements, void* pScratch)
+            {
+                T* pTemp = (T*)pScratch;
+                for (size_type i = 0; i < numElements; ++i)
+                    ::new (pTemp + i) T(corsac::move(mpData[indices[i]]));
+                for (size_type i = 0; i < numElements; ++i)
+                    mpData[i] = corsac::move(pTemp[i]);
+                corsac::destruct(pTemp, pTemp + numElements);
+            }
+
             T* mpData = nullptr;
         };
 
+        // Устойчивая сортировка индексов по ключам keys[index]: вставками по блокам, затем слияния снизу вверх.
+        // buffer - место под numElements индексов.
+        template <typename Key, typename Compare>
+        void IndexSort(size_t* indices, size_t* buffer, size_t numElements, const Key* keys, Compare& compare)
+        {
+            const size_t kRunSize = 32;
+            for (size_t first = 0; first < numElements; first += kRunSize)
+            {
+                const size_t last = corsac::min(first + kRunSize, numElements);
+                for (size_t i = first + 1; i < last; ++i)
+                {
+                    const size_t index = indices[i];
+                    size_t j = i;
+                    for (; j > first && compare(keys[index], keys[indices[j - 1]]); --j)
+                        indices[j] = indices[j - 1];
+                    indices[j] = index;
+                }
+            }
+
+            size_t* pSrc = indices;
+            size_t* pDest = buffer;
+            for (size_t width = kRunSize; width < numElements; width *= 2)
+            {
+                for (size_t first = 0; first < numElements; first += 2 * width)
+                {
+                    const size_t middle = corsac::min(first + width, numElements);
+                    const size_t last = corsac::min(first + 2 * width, numElements);
+                    size_t a = first, b = middle, out = first;
+                    while (a < middle && b < last)
+                    {
+                        // Без ветвления по результату сравнения: на случайных ключах переход предсказывается плохо.
+                        const bool takeB = compare(keys[pSrc[b]], keys[pSrc[a]]);
+                        pDest[out++] = takeB ? pSrc[b] : pSrc[a];
+                        b += takeB;
+                        a += !takeB;
+                    }
+                    while (a < middle)
+                        pDest[out++] = pSrc[a++];
+                    while (b < last)
+                        pDest[out++] = pSrc[b++];
+                }
+                corsac::swap(pSrc, pDest);
+            }
+
+            if (pSrc != indices)
+                memcpy(indices, pSrc, numElements * sizeof(size_t));
+        }
+
         // swallow позволяет расширение пакета параметров аргументов в качестве средства расширения операций,
         // выполняемых, если для раскрытия операции используется функция void, она должна быть заключена в (..., 0),
         // чтобы компилятор считал, что у него есть параметр для передачи в функцию
@@ -1203,6 +1338,97 @@ namespace corsac
             return TupleVecLeaf<Index::index, T>::mpData;
         }
 
+        // Колонка I целиком; начало выровнено на tuple_vector_column_alignment<T>::value.
+        template <size_type I>
+        column_span<tuplevec_element_t<I, Ts...>, tuple_vector_column_alignment<tuplevec_element_t<I, Ts...>>::value> get_span()
+        {
+            using Element = tuplevec_element_t<I, Ts...>;
+            return { TupleVecLeaf<I, Element>::mpData, mNumElements };
+        }
+
+        template <size_type I>
+        column_span<const tuplevec_element_t<I, Ts...>, tuple_vector_column_alignment<tuplevec_element_t<I, Ts...>>::value> get_span() const
+        {
+            using Element = tuplevec_element_t<I, Ts...>;
+            return { TupleVecLeaf<I, Element>::mpData, mNumElements };
+        }
+
+        template <typename T>
+        column_span<T, tuple_vector_column_alignment<T>::value> get_span()
+        {
+            using Index = tuplevec_index<T, TupleTypes<Ts...>>;
+            return { TupleVecLeaf<Index::index, T>::mpData, mNumElements };
+        }
+
+        template <typename T>
+        column_span<const T, tuple_vector_column_alignment<T>::value> get_span() const
+        {
+            using Index = tuplevec_index<T, TupleTypes<Ts...>>;
+            return { TupleVecLeaf<Index::index, T>::mpData, mNumElements };
+        }
+
+        /**
+         * sort_by
+         *
+         * Устойчиво сортирует строки по колонке I. Сортируются только индексы (ключи читаются
+         * из колонки на месте), затем каждая колонка переставляется одним проходом сбора -
+         * строки в кортежи не копируются. Если колонка уже упорядочена, перестановки нет.
+         */
+        template <size_type I, typename Compare = less<tuplevec_element_t<I, Ts...>>>
+        void sort_by(Compare compare = Compare())
+        {
+            using Element = tuplevec_element_t<I, Ts...>;
+            const Element* keys = TupleVecLeaf<I, Element>::mpData;
+
+            size_type i = 1;
+            while (i < mNumElements && !compare(keys[i], keys[i - 1]))
+                ++i;
+            if (i >= mNumElements)
+                return;
+
+            // Один буфер: индексы, затем место, которое сначала служит буфером слияния, а потом - буфером колонки.
+            const size_type indicesSize = mNumElements * sizeof(size_type);
+            const size_type scratchOffset = (indicesSize + kScratchAlignment - 1) & ~(kScratchAlignment - 1);
+            const size_type scratchSize = mNumElements * corsac::max<size_type>(sizeof(size_type), kScratchElementSize);
+            const size_type allocationSize = scratchOffset + scratchSize;
+            CORSAC_ALLOCATOR_TYPE scratchAllocator(CORSAC_TUPLE_VECTOR_DEFAULT_NAME);
+            void* pScratch = allocate_memory(scratchAllocator, allocationSize, kScratchAlignment, 0);
+
+            size_type* indices = (size_type*)pScratch;
+            void* pColumnScratch = (char*)pScratch + scratchOffset;
+            for (size_type n = 0; n < mNumElements; ++n)
+                indices[n] = n;
+            IndexSort(indices, (size_type*)pColumnScratch, mNumElements, keys, compare);
+            swallow((TupleVecLeaf<Indices, Ts>::DoApplyPermutation(indices, mNumElements, pColumnScratch), 0)...);
+
+            CORSAC_Free(scratchAllocator, pScratch, allocationSize);
+        }
+
+        template <typename T, typename Compare = less<T>>
+        void sort_by(Compare compare = Compare())
+        {
+            sort_by<tuplevec_index<T, TupleTypes<Ts...>>::index>(compare);
+        }
+
+        /**
+         * apply_permutation
+         *
+         * Строка i становится бывшей строкой indices[i]. indices - перестановка [0, size()),
+         * например результат собственной сортировки индексов. Каждая колонка переставляется
+         * отдельным проходом через общий временный буфер.
+         */
+        void apply_permutation(const size_type* indices)
+        {
+            if (mNumElements == 0)
+                return;
+
+            const size_type allocationSize = mNumElements * kScratchElementSize;
+            CORSAC_ALLOCATOR_TYPE scratchAllocator(CORSAC_TUPLE_VECTOR_DEFAULT_NAME);
+            void* pScratch = allocate_memory(scratchAllocator, allocationSize, kScratchAlignment, 0);
+            swallow((TupleVecLeaf<Indices, Ts>::DoApplyPermutation(indices, mNumElements, pScratch), 0)...);
+            CORSAC_Free(scratchAllocator, pScratch, allocationSize);
+        }
+
         this_type& operator=(const this_type& other)
         {
             if (this != &other)
@@ -1268,6 +1494,17 @@ namespace corsac
         void set_allocator(const allocator_type& alloc) { mDataSizeAndAllocator.second() = alloc; }
 
     protected:
+        // Временный буфер sort_by и apply_permutation вмещает одну любую колонку.
+        static constexpr size_type GetMaxValue(std::initializer_list<size_type> values)
+        {
+            size_type result = 0;
+            for (size_type value : values)
+                result = (value > result) ? value : result;
+            return result;
+        }
+
+        static constexpr size_type kScratchElementSize = GetMaxValue({ sizeof(Ts)... });
+        static constexpr size_type kScratchAlignment = GetMaxValue({ alignof(size_type), alignof(Ts)... });
 
         void* mpData = nullptr;
         size_type mNumElements = 0;
@@ -0,0 +1,1840 @@
+/**
+ * corsac::STL
+ *
+ * world.h
+ *
+ * Created by Falldot on 18.10.2026.
+ * Copyright (c) 2021 Corsac. All rights reserved.
+ */
+#ifndef CORSAC_STL_WORLD_H
+#define CORSAC_STL_WORLD_H
+
+#pragma once
+/**
+ * Описание (Falldot 18.10.2026)
+ *
+ * Мир сущностей с архетипным хранением компонентов (ECS).
+ *
+ * Сущности с одинаковым набором компонентов лежат в одном архетипе. Архетип - это набор колонок,
+ * как у tuple_vector: каждая колонка - непрерывный выровненный массив одного компонента, строка -
+ * одна сущность. Набор компонентов известен только во время выполнения, поэтому колонки
+ * нетипизированы: размер, выравнивание, перенос и уничтожение берутся из component_info,
+ * зарегистрированного при первом обращении к типу.
+ *
+ * Добавление или удаление компонента - структурное изменение: сущность переезжает в другой
+ * архетип, а последняя строка старого архетипа переносится на ее место. Переходы между
+ * архетипами по одному компоненту кэшируются в самих архетипах.
+ *
+ * Структурные изменения нельзя делать, пока колонки обходятся, в том числе из рабочих потоков.
+ * Для этого есть command_buffer: команды spawn, despawn, add и remove записываются в буфер
+ * (у каждого потока свой, см. world::thread_commands), а компоненты команд add размещаются
+ * в арене буфера. В точке синхронизации world::flush применяет команды всех буферов за один проход:
+ *  - новые сущности создаются одним пакетом entity_manager::create;
+ *  - команды сортируются по сущности (поразрядная сортировка, порядок записи сохраняется) и
+ *    сворачиваются: для каждой сущности вычисляется итоговый архетип, и она переезжает один раз,
+ *    сколько бы компонентов ей ни добавили и ни удалили;
+ *  - переезды группируются по паре архетипов "откуда-куда" и выполняются по колонкам: колонка
+ *    целиком переносится для всей группы, затем дыры в исходном архетипе закрываются.
+ *
+ * Изменения отслеживаются тактами (world::change_tick). У каждой строки каждой колонки два такта:
+ * added - когда компонент появился у сущности, changed - когда его последний раз открыли на запись
+ * (world::get без const, обход query с неконстантным компонентом, замена через add). Кроме того,
+ * у каждого куска из CORSAC_WORLD_CHUNK_ROWS строк хранится максимум тактов его строк, и фильтры
+ * query changed<T> и added<T> пропускают неизмененные куски целиком, не читая такты строк.
+ * Такты переносятся вместе со строками. Такт 32-битный: сравнение ломается после 2^32 обходов.
+ *
+ * Снимки (world::snapshot, world::restore) для отката сетевой симуляции и быстрого сохранения:
+ * компоненты должны быть тривиально копируемыми (иначе snapshot возвращает false), поэтому каждая
+ * колонка архетипа копируется одним memcpy, вместе с массивом сущностей архетипа, состоянием
+ * entity_manager и положениями сущностей.
+ * Снимок-дельта относительно полного снимка base копирует только куски колонок, в которых после
+ * base что-то записано (такт куска больше такта base) или строки заняты другими сущностями
+ * (структурные изменения). Окно отката в 8 кадров - один полный снимок и дельты к нему.
+ * Архетипы не удаляются, поэтому после restore кэши query остаются действительными.
+ *
+ * Мир не потокобезопасен: прямые вызовы spawn, add и т.д. и flush - только из одного потока, когда
+ * никто не записывает команды. Запись в разные буферы из разных потоков безопасна.
+ *
+ * ---------------------------------------------------------------------------------------------------
+ * === Классы:
+ *
+ *      component_info                  Размер, выравнивание, перенос и уничтожение типа компонента.
+ *      component_registry              Глобальный реестр типов компонентов.
+ *      component_mask                  Набор компонентов - битовая маска фиксированной ширины.
+ *      archetype                       Колонки компонентов сущностей с одинаковым набором.
+ *      command_buffer                  Отложенные структурные изменения.
+ *      world_snapshot                  Снимок состояния мира: полный или дельта.
+ *      world                           Сущности, архетипы и применение команд.
+ *
+ * Пример использования:
+ *      corsac::world world;
+ *      corsac::entity e = world.spawn(Position{}, Velocity{ 1.0f, 0.0f, 0.0f });
+ *      world.get<Position>(e)->x += 1.0f;
+ *
+ *      // В рабочем потоке:
+ *      world.thread_commands().add<Burning>(e, 5.0f);
+ *      world.thread_commands().spawn(Position{}, Bullet{});
+ *
+ *      // В точке синхронизации:
+ *      world.flush();
+ *
+ *      // Откат:
+ *      corsac::world_snapshot full, frames[7];
+ *      world.snapshot(full);
+ *      world.snapshot(frames[0], &full);
+ *      ...
+ *      world.restore(frames[0]);
+ */
+
+#include "Corsac/STL/config.h"
+#include "Corsac/entity.h"
+#include "Corsac/vector.h"
+
+#include <string.h>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+/**
+ * CORSAC_WORLD_MAX_COMPONENTS
+ *
+ * Максимальное число типов компонентов в программе. Определяет ширину component_mask.
+ */
+#ifndef CORSAC_WORLD_MAX_COMPONENTS
+    #define CORSAC_WORLD_MAX_COMPONENTS 128
+#endif
+
+/**
+ * CORSAC_WORLD_COLUMN_ALIGNMENT
+ *
+ * Минимальное выравнивание колонок архетипа, как CORSAC_TUPLE_VECTOR_COLUMN_ALIGNMENT у tuple_vector.
+ */
+#ifndef CORSAC_WORLD_COLUMN_ALIGNMENT
+    #define CORSAC_WORLD_COLUMN_ALIGNMENT 32
+#endif
+
+/**
+ * CORSAC_WORLD_CHUNK_ROWS
+ *
+ * Число строк в куске колонки, для которого хранится общий такт изменений (см. archetype::chunk_changed_ticks).
+ * Степень двойки.
+ */
+#ifndef CORSAC_WORLD_CHUNK_ROWS
+    #define CORSAC_WORLD_CHUNK_ROWS 256
+#endif
+
+/**
+ * CORSAC_COMMAND_BUFFER_BLOCK_SIZE
+ *
+ * Размер блока арены command_buffer. Компонент больше блока получает отдельный блок.
+ */
+#ifndef CORSAC_COMMAND_BUFFER_BLOCK_SIZE
+    #define CORSAC_COMMAND_BUFFER_BLOCK_SIZE (64 * 1024)
+#endif
+
+namespace corsac
+{
+    static_assert(CORSAC_WORLD_MAX_COMPONENTS < 255, "archetype column index table stores uint8_t");
+    static_assert((CORSAC_WORLD_CHUNK_ROWS & (CORSAC_WORLD_CHUNK_ROWS - 1)) == 0, "CORSAC_WORLD_CHUNK_ROWS must be a power of two");
+
+    // CORSAC_WORLD_DEFAULT_NAME
+    #ifndef CORSAC_WORLD_DEFAULT_NAME
+        #define CORSAC_WORLD_DEFAULT_NAME CORSAC_DEFAULT_NAME_PREFIX " world"
+    #endif
+
+    // CORSAC_WORLD_DEFAULT_ALLOCATOR
+    #ifndef CORSAC_WORLD_DEFAULT_ALLOCATOR
+        #define CORSAC_WORLD_DEFAULT_ALLOCATOR CORSAC_ALLOCATOR_TYPE(CORSAC_WORLD_DEFAULT_NAME)
+    #endif
+
+    using component_id = uint32_t;
+
+    /**
+     * component_info
+     *
+     * relocate == nullptr и destroy == nullptr означают тривиально копируемый и уничтожаемый тип:
+     * перенос - memcpy, уничтожение не нужно.
+     */
+    struct component_info
+    {
+        size_t size;
+        size_t alignment;
+        void (*relocate)(void* to, void* from) noexcept;   // Перемещает компонент и уничтожает исходный. nullptr - тривиально копируем.
+        void (*destroy)(void* p) noexcept;
+    };
+
+    namespace internal
+    {
+        template <typename T>
+        struct component_ops
+        {
+            static void relocate(void* to, void* from) noexcept
+            {
+                ::new (to) T(corsac::move(*static_cast<T*>(from)));
+                static_cast<T*>(from)->~T();
+            }
+
+            static void destroy(void* p) noexcept
+            {
+                static_cast<T*>(p)->~T();
+            }
+
+            static constexpr component_info info =
+            {
+                sizeof(T),
+                alignof(T),
+                corsac::is_trivially_copyable_v<T> ? nullptr : &relocate,
+                corsac::is_trivially_destructible_v<T> ? nullptr : &destroy
+            };
+        };
+
+        inline void relocate_component(const component_info& info, void* to, void* from) noexcept
+        {
+            if(info.relocate)
+                info.relocate(to, from);
+            else
+                memcpy(to, from, info.size);
+        }
+
+        inline void destroy_component(const component_info& info, void* p) noexcept
+        {
+            if(info.destroy)
+                info.destroy(p);
+        }
+
+        inline uint32_t count_bits64(uint64_t word) noexcept
+        {
+            uint32_t count = 0;
+            for(; word; word &= word - 1)
+                ++count;
+            return count;
+        }
+
+        /**
+         * radix_sort
+         *
+         * Устойчивая поразрядная сортировка по 64-битному ключу key(element), разряды по 8 бит.
+         * Первый проход проверяет, не упорядочен ли массив уже, и находит разряды, одинаковые
+         * у всех элементов: они пропускаются, поэтому ключ из 12 значащих бит сортируется за 2 прохода.
+         * T копируется присваиванием. Результат оказывается в first или в buffer, возвращается указатель на него.
+         */
+        template <typename T, typename KeyFunction>
+        T* radix_sort(T* first, T* buffer, uint32_t n, KeyFunction key)
+        {
+            uint64_t keyAnd = ~uint64_t(0), keyOr = 0, previous = 0;
+            bool ordered = true;
+            for(uint32_t i = 0; i < n; ++i)
+            {
+                const uint64_t k = key(first[i]);
+                ordered = ordered && previous <= k;
+                previous = k;
+                keyAnd &= k;
+                keyOr  |= k;
+            }
+            if(ordered)
+                return first;
+
+            const uint64_t varying = keyAnd ^ keyOr;
+            T* from = first;
+            T* to   = buffer;
+            for(uint32_t shift = 0; shift < 64; shift += 8)
+            {
+                if(((varying >> shift) & 0xFF) == 0)
+                    continue;
+
+                uint32_t count[256] = {};
+                for(uint32_t i = 0; i < n; ++i)
+                    ++count[(key(from[i]) >> shift) & 0xFF];
+                for(uint32_t b = 0, offset = 0; b < 256; ++b)
+                {
+                    const uint32_t c = count[b];
+                    count[b] = offset;
+                    offset += c;
+                }
+                for(uint32_t i = 0; i < n; ++i)
+                    to[count[(key(from[i]) >> shift) & 0xFF]++] = from[i];
+
+                T* temp = from;
+                from = to;
+                to = temp;
+            }
+            return from;
+        }
+    }
+
+    /**
+     * component_registry
+     *
+     * Идентификаторы выдаются по порядку первого обращения к типу и общие для всех миров программы.
+     * Описания публикуются до того, как идентификатор становится известен вызывающему, поэтому
+     * info(id) читается без блокировки.
+     */
+    class component_registry
+    {
+    public:
+        static component_registry& get()
+        {
+            static component_registry instance;
+            return instance;
+        }
+
+        component_registry(const component_registry&) = delete;
+        component_registry& operator=(const component_registry&) = delete;
+
+        component_id register_component(const component_info& info)
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            const uint32_t id = mCount.load(std::memory_order_relaxed);
+            CORSAC_ASSERT_MSG(id < CORSAC_WORLD_MAX_COMPONENTS, "component_registry: too many component types, increase CORSAC_WORLD_MAX_COMPONENTS.");
+            mInfos[id] = info;
+            mCount.store(id + 1, std::memory_order_release);
+            return id;
+        }
+
+        const component_info& info(component_id id) const noexcept { return mInfos[id]; }
+        uint32_t size() const noexcept { return mCount.load(std::memory_order_acquire); }
+
+    private:
+        component_registry() = default;
+
+        component_info        mInfos[CORSAC_WORLD_MAX_COMPONENTS];
+        std::atomic<uint32_t> mCount{0};
+        std::mutex            mMutex;
+    };
+
+    namespace internal
+    {
+        template <typename T>
+        struct component_type
+        {
+            static component_id id()
+            {
+                static const component_id value = component_registry::get().register_component(component_ops<T>::info);
+                return value;
+            }
+        };
+    }
+
+    // Идентификатор типа компонента. const и ссылки отбрасываются: T, const T и T& - один компонент.
+    template <typename T>
+    inline component_id component_type_id()
+    {
+        return internal::component_type<remove_cvref_t<T>>::id();
+    }
+
+    /**
+     * component_mask
+     */
+    class component_mask
+    {
+    public:
+        static constexpr uint32_t kWordCount = (CORSAC_WORLD_MAX_COMPONENTS + 63) / 64;
+
+        constexpr component_mask() noexcept : mWords{} {}
+
+        template <typename... Ts>
+        static component_mask of()
+        {
+            component_mask mask;
+            (mask.set(component_type_id<Ts>()), ...);
+            return mask;
+        }
+
+        void set(component_id id) noexcept { mWords[id >> 6] |= uint64_t(1) << (id & 63); }
+        void reset(component_id id) noexcept { mWords[id >> 6] &= ~(uint64_t(1) << (id & 63)); }
+        bool test(component_id id) const noexcept { return (mWords[id >> 6] >> (id & 63)) & 1; }
+
+        // Все компоненты x есть в *this.
+        bool contains(const component_mask& x) const noexcept
+        {
+            for(uint32_t w = 0; w < kWordCount; ++w)
+            {
+                if((mWords[w] & x.mWords[w]) != x.mWords[w])
+                    return false;
+            }
+            return true;
+        }
+
+        bool intersects(const component_mask& x) const noexcept
+        {
+            for(uint32_t w = 0; w < kWordCount; ++w)
+            {
+                if(mWords[w] & x.mWords[w])
+                    return true;
+            }
+            return false;
+        }
+
+        bool none() const noexcept
+        {
+            for(uint32_t w = 0; w < kWordCount; ++w)
+            {
+                if(mWords[w])
+                    return false;
+            }
+            return true;
+        }
+
+        uint32_t count() const noexcept
+        {
+            uint32_t n = 0;
+            for(uint32_t w = 0; w < kWordCount; ++w)
+                n += internal::count_bits64(mWords[w]);
+            return n;
+        }
+
+        // function(component_id) для каждого компонента по возрастанию идентификатора.
+        template <typename Function>
+        void for_each(Function function) const
+        {
+            for(uint32_t w = 0; w < kWordCount; ++w)
+            {
+                for(uint64_t word = mWords[w]; word; word &= word - 1)
+                    function((component_id)((w << 6) + internal::count_trailing_zeros64(word)));
+            }
+        }
+
+        const uint64_t* words() const noexcept { return mWords; }
+
+        bool operator==(const component_mask& x) const noexcept
+        {
+            for(uint32_t w = 0; w < kWordCount; ++w)
+            {
+                if(mWords[w] != x.mWords[w])
+                    return false;
+            }
+            return true;
+        }
+
+        bool operator!=(const component_mask& x) const noexcept { return !(*this == x); }
+
+    private:
+        uint64_t mWords[kWordCount];
+    };
+
+    /**
+     * archetype
+     *
+     * Колонки упорядочены по возрастанию идентификатора компонента. Строки плотные: удаление строки
+     * переносит на ее место последнюю. Колонки растут вместе, емкость у всех одна.
+     *
+     * Такты колонки лежат в том же блоке памяти, что и данные: changed и added по строкам,
+     * затем changed и added по кускам.
+     */
+    class archetype
+    {
+    public:
+        static constexpr uint32_t npos = 0xFFFFFFFFu;
+        static constexpr uint32_t kChunkRows = CORSAC_WORLD_CHUNK_ROWS;
+
+        struct column
+        {
+            char*                 data;
+            const component_info* info;
+            component_id          id;
+            uint32_t*             changed;
+            uint32_t*             added;
+            uint32_t*             chunkChanged;
+            uint32_t*             chunkAdded;
+        };
+
+        archetype(uint32_t index, const component_mask& mask);
+        ~archetype();
+
+        archetype(const archetype&) = delete;
+        archetype& operator=(const archetype&) = delete;
+
+        uint32_t index() const noexcept { return mIndex; }
+        const component_mask& mask() const noexcept { return mMask; }
+
+        uint32_t size() const noexcept { return (uint32_t)mEntities.size(); }
+        uint32_t capacity() const noexcept { return mCapacity; }
+        bool empty() const noexcept { return mEntities.empty(); }
+
+        uint32_t column_count() const noexcept { return (uint32_t)mColumns.size(); }
+
+        // Номер колонки компонента, npos - компонента в архетипе нет.
+        uint32_t column_index(component_id id) const noexcept
+        {
+            return (mColumnIndex[id] == 0xFF) ? npos : mColumnIndex[id];
+        }
+
+        const column& column_at(uint32_t c) const noexcept { return mColumns[c]; }
+        const void* column_data(uint32_t c) const noexcept { return mColumns[c].data; }
+
+        // Колонка компонента T, nullptr - компонента в архетипе нет.
+        template <typename T>
+        const T* column_data() const noexcept
+        {
+            const uint32_t c = column_index(component_type_id<T>());
+            return (c == npos) ? nullptr : reinterpret_cast<const T*>(mColumns[c].data);
+        }
+
+        const void* element(uint32_t c, uint32_t row) const noexcept { return mColumns[c].data + row * mColumns[c].info->size; }
+
+        // Доступ для записи сразу помечает строки измененными в такте tick (обычно world::change_tick()),
+        // иначе фильтр changed<T> и разностный снимок не увидели бы запись через указатель.
+        void* column_data_mut(uint32_t c, uint32_t tick) noexcept
+        {
+            mark_changed(c, 0, size(), tick);
+            return mColumns[c].data;
+        }
+
+        template <typename T>
+        T* column_data_mut(uint32_t tick) noexcept
+        {
+            const uint32_t c = column_index(component_type_id<T>());
+            return (c == npos) ? nullptr : static_cast<T*>(column_data_mut(c, tick));
+        }
+
+        void* element_mut(uint32_t c, uint32_t row, uint32_t tick) noexcept
+        {
+            mark_changed(c, row, tick);
+            return DoElement(c, row);
+        }
+
+        const entity* entities() const noexcept { return mEntities.data(); }
+
+        // Такты строк и кусков колонки c. Такт куска не меньше тактов его строк.
+        const uint32_t* changed_ticks(uint32_t c) const noexcept { return mColumns[c].changed; }
+        const uint32_t* added_ticks(uint32_t c) const noexcept { return mColumns[c].added; }
+        const uint32_t* chunk_changed_ticks(uint32_t c) const noexcept { return mColumns[c].chunkChanged; }
+        const uint32_t* chunk_added_ticks(uint32_t c) const noexcept { return mColumns[c].chunkAdded; }
+
+        void mark_changed(uint32_t c, uint32_t row, uint32_t tick) noexcept;
+        void mark_changed(uint32_t c, uint32_t first, uint32_t count, uint32_t tick) noexcept;
+
+        // Компонент появился у сущности: added и changed.
+        void mark_added(uint32_t c, uint32_t row, uint32_t tick) noexcept;
+        void mark_added(uint32_t c, uint32_t first, uint32_t count, uint32_t tick) noexcept;
+
+        // Такты строки fromRow колонки fromColumn архетипа from переносятся в строку row колонки c.
+        void copy_ticks(uint32_t c, uint32_t row, const archetype& from, uint32_t fromColumn, uint32_t fromRow) noexcept;
+
+        void reserve(uint32_t n);
+
+        // Добавляет строку сущности e. Компоненты строки не инициализированы.
+        uint32_t push_row(entity e);
+
+        // Добавляет count строк сущностей entities и возвращает номер первой.
+        uint32_t push_rows(const entity* entities, uint32_t count);
+
+        // Уничтожает компоненты строки, строка остается.
+        void destroy_row(uint32_t row) noexcept;
+
+        // Убирает строку, компоненты которой уже уничтожены или перенесены: на ее место переносится
+        // последняя строка. Возвращает сущность, переехавшую в row, или null, если row была последней.
+        entity erase_row(uint32_t row) noexcept;
+
+        // Переходы в архетип с добавленным или удаленным компонентом id, npos - переход еще не известен.
+        uint32_t add_edge(component_id id) const noexcept { return mAddEdges[id]; }
+        uint32_t remove_edge(component_id id) const noexcept { return mRemoveEdges[id]; }
+        void set_add_edge(component_id id, uint32_t to) noexcept { mAddEdges[id] = to; }
+        void set_remove_edge(component_id id, uint32_t to) noexcept { mRemoveEdges[id] = to; }
+
+    protected:
+        friend class world;
+        template <typename...> friend class query;
+
+        // Запись без тактов: для world и query, которые помечают строки сами.
+        void* DoColumnData(uint32_t c) noexcept { return mColumns[c].data; }
+        void* DoElement(uint32_t c, uint32_t row) noexcept { return mColumns[c].data + row * mColumns[c].info->size; }
+
+        void DoGrow(uint32_t capacity);
+
+        static size_t GetColumnAlignment(const component_info& info) noexcept
+        {
+            return (info.alignment > CORSAC_WORLD_COLUMN_ALIGNMENT) ? info.alignment : CORSAC_WORLD_COLUMN_ALIGNMENT;
+        }
+
+        static uint32_t GetChunkCount(uint32_t capacity) noexcept
+        {
+            return (capacity + kChunkRows - 1) / kChunkRows;
+        }
+
+        static size_t GetDataSize(const component_info& info, uint32_t capacity) noexcept
+        {
+            return (info.size * capacity + sizeof(uint32_t) - 1) & ~(sizeof(uint32_t) - 1);
+        }
+
+        static size_t GetAllocationSize(const component_info& info, uint32_t capacity) noexcept
+        {
+            return GetDataSize(info, capacity) + (2 * capacity + 2 * GetChunkCount(capacity)) * sizeof(uint32_t);
+        }
+
+        static void DoRaise(uint32_t& chunkTick, uint32_t tick) noexcept
+        {
+            if(chunkTick < tick)
+                chunkTick = tick;
+        }
+
+        CORSAC_ALLOCATOR_TYPE mAllocator;
+        vector<column>        mColumns;
+        vector<entity>        mEntities;
+        component_mask        mMask;
+        uint32_t              mIndex;
+        uint32_t              mCapacity = 0;
+        uint8_t               mColumnIndex[CORSAC_WORLD_MAX_COMPONENTS];
+        uint32_t              mAddEdges[CORSAC_WORLD_MAX_COMPONENTS];
+        uint32_t              mRemoveEdges[CORSAC_WORLD_MAX_COMPONENTS];
+    };
+
+    inline archetype::archetype(uint32_t index, const component_mask& mask)
+        : mAllocator(CORSAC_WORLD_DEFAULT_NAME), mColumns(CORSAC_WORLD_DEFAULT_ALLOCATOR), mEntities(CORSAC_WORLD_DEFAULT_ALLOCATOR),
+          mMask(mask), mIndex(index)
+    {
+        memset(mColumnIndex, 0xFF, sizeof(mColumnIndex));
+        memset(mAddEdges, 0xFF, sizeof(mAddEdges));
+        memset(mRemoveEdges, 0xFF, sizeof(mRemoveEdges));
+
+        mColumns.reserve(mask.count());
+        mask.for_each([this](component_id id)
+        {
+            mColumnIndex[id] = (uint8_t)mColumns.size();
+            mColumns.push_back(column{ nullptr, &component_registry::get().info(id), id, nullptr, nullptr, nullptr, nullptr });
+        });
+    }
+
+    inline archetype::~archetype()
+    {
+        for(uint32_t row = 0, n = size(); row < n; ++row)
+            destroy_row(row);
+        for(column& c : mColumns)
+        {
+            if(c.data)
+                CORSAC_Free(mAllocator, c.data, GetAllocationSize(*c.info, mCapacity));
+        }
+    }
+
+    inline void archetype::mark_changed(uint32_t c, uint32_t row, uint32_t tick) noexcept
+    {
+        column& col = mColumns[c];
+        col.changed[row] = tick;
+        DoRaise(col.chunkChanged[row / kChunkRows], tick);
+    }
+
+    inline void archetype::mark_changed(uint32_t c, uint32_t first, uint32_t count, uint32_t tick) noexcept
+    {
+        column& col = mColumns[c];
+        for(uint32_t row = first, last = first + count; row < last; ++row)
+            col.changed[row] = tick;
+        for(uint32_t chunk = first / kChunkRows, last = (first + count + kChunkRows - 1) / kChunkRows; chunk < last; ++chunk)
+            DoRaise(col.chunkChanged[chunk], tick);
+    }
+
+    inline void archetype::mark_added(uint32_t c, uint32_t row, uint32_t tick) noexcept
+    {
+        column& col = mColumns[c];
+        col.added[row] = tick;
+        DoRaise(col.chunkAdded[row / kChunkRows], tick);
+        mark_changed(c, row, tick);
+    }
+
+    inline void archetype::mark_added(uint32_t c, uint32_t first, uint32_t count, uint32_t tick) noexcept
+    {
+        column& col = mColumns[c];
+        for(uint32_t row = first, last = first + count; row < last; ++row)
+            col.added[row] = tick;
+        for(uint32_t chunk = first / kChunkRows, last = (first + count + kChunkRows - 1) / kChunkRows; chunk < last; ++chunk)
+            DoRaise(col.chunkAdded[chunk], tick);
+        mark_changed(c, first, count, tick);
+    }
+
+    inline void archetype::copy_ticks(uint32_t c, uint32_t row, const archetype& from, uint32_t fromColumn, uint32_t fromRow) noexcept
+    {
+        column& col = mColumns[c];
+        const column& fromCol = from.mColumns[fromColumn];
+        col.changed[row] = fromCol.changed[fromRow];
+        col.added[row]   = fromCol.added[fromRow];
+        DoRaise(col.chunkChanged[row / kChunkRows], col.changed[row]);
+        DoRaise(col.chunkAdded[row / kChunkRows], col.added[row]);
+    }
+
+    inline void archetype::reserve(uint32_t n)
+    {
+        if(n > mCapacity)
+            DoGrow(n);
+        mEntities.reserve(n);
+    }
+
+    inline uint32_t archetype::push_row(entity e)
+    {
+        const uint32_t row = size();
+        if(row == mCapacity)
+            DoGrow(mCapacity ? mCapacity * 2 : 16);
+        mEntities.push_back(e);
+        return row;
+    }
+
+    inline uint32_t archetype::push_rows(const entity* entities, uint32_t count)
+    {
+        const uint32_t row = size();
+        if(row + count > mCapacity)
+            DoGrow((row + count > mCapacity * 2) ? row + count : mCapacity * 2);
+        mEntities.insert(mEntities.end(), entities, entities + count);
+        return row;
+    }
+
+    inline void archetype::destroy_row(uint32_t row) noexcept
+    {
+        for(uint32_t c = 0, n = column_count(); c < n; ++c)
+            internal::destroy_component(*mColumns[c].info, DoElement(c, row));
+    }
+
+    inline entity archetype::erase_row(uint32_t row) noexcept
+    {
+        const uint32_t last = size() - 1;
+        entity moved;
+        if(row != last)
+        {
+            for(uint32_t c = 0, n = column_count(); c < n; ++c)
+            {
+                internal::relocate_component(*mColumns[c].info, DoElement(c, row), DoElement(c, last));
+                copy_ticks(c, row, *this, c, last);
+            }
+            moved = mEntities[last];
+            mEntities[row] = moved;
+        }
+        mEntities.pop_back();
+        return moved;
+    }
+
+    inline void archetype::DoGrow(uint32_t capacity)
+    {
+        const uint32_t n = size();
+        for(column& c : mColumns)
+        {
+            const component_info& info = *c.info;
+            char* data = (char*)allocate_memory(mAllocator, GetAllocationSize(info, capacity), GetColumnAlignment(info), 0);
+
+            if(info.relocate)
+            {
+                for(uint32_t row = 0; row < n; ++row)
+                    info.relocate(data + row * info.size, c.data + row * info.size);
+            }
+            else if(n)
+                memcpy(data, c.data, n * info.size);
+
+            uint32_t* changed      = (uint32_t*)(data + GetDataSize(info, capacity));
+            uint32_t* added        = changed + capacity;
+            uint32_t* chunkChanged = added + capacity;
+            uint32_t* chunkAdded   = chunkChanged + GetChunkCount(capacity);
+            const uint32_t chunks  = GetChunkCount(mCapacity);
+            if(n)
+            {
+                memcpy(changed, c.changed, n * sizeof(uint32_t));
+                memcpy(added, c.added, n * sizeof(uint32_t));
+            }
+            if(chunks)
+            {
+                memcpy(chunkChanged, c.chunkChanged, chunks * sizeof(uint32_t));
+                memcpy(chunkAdded, c.chunkAdded, chunks * sizeof(uint32_t));
+            }
+            memset(chunkChanged + chunks, 0, (GetChunkCount(capacity) - chunks) * sizeof(uint32_t));
+            memset(chunkAdded + chunks, 0, (GetChunkCount(capacity) - chunks) * sizeof(uint32_t));
+
+            if(c.data)
+                CORSAC_Free(mAllocator, c.data, GetAllocationSize(info, mCapacity));
+            c.data         = data;
+            c.changed      = changed;
+            c.added        = added;
+            c.chunkChanged = chunkChanged;
+            c.chunkAdded   = chunkAdded;
+        }
+        mCapacity = capacity;
+    }
+
+    class world;
+
+    /**
+     * command_buffer
+     *
+     * Записывает структурные изменения для world::apply и world::flush. Буфер пишет один поток.
+     * Компоненты команд add и spawn перемещаются в арену - список блоков, которые не освобождаются
+     * между кадрами: после первых кадров запись команды не выделяет память.
+     *
+     * Команды одной сущности применяются в порядке записи. Команды из разных буферов применяются
+     * в порядке буферов, который не определен. Команды для сущностей, уничтоженных к моменту
+     * применения, пропускаются.
+     */
+    class command_buffer
+    {
+    public:
+        enum class command_type : uint32_t
+        {
+            spawn,
+            despawn,
+            add,
+            remove
+        };
+
+        // Цель команды для сущности, созданной spawn в этом же буфере: индекс npos, в поколении номер spawn.
+        struct command
+        {
+            entity        target;
+            command_type  type;
+            component_id  component;
+            void*         payload;      // add: компонент в арене.
+        };
+
+        command_buffer();
+        ~command_buffer();
+
+        command_buffer(const command_buffer&) = delete;
+        command_buffer& operator=(const command_buffer&) = delete;
+
+        // Создает сущность с компонентами components.
+        template <typename... Ts>
+        void spawn(Ts&&... components);
+
+        void despawn(entity e);
+
+        // Добавляет компонент T(args...) или заменяет существующий.
+        template <typename T, typename... Args>
+        void add(entity e, Args&&... args);
+
+        template <typename T>
+        void remove(entity e);
+
+        uint32_t size() const noexcept { return (uint32_t)mCommands.size(); }
+        bool empty() const noexcept { return mCommands.empty(); }
+        const command* data() const noexcept { return mCommands.data(); }
+        uint32_t spawn_count() const noexcept { return mSpawnCount; }
+
+        // Отбрасывает команды и уничтожает их компоненты. Блоки арены остаются для следующих команд.
+        void clear() noexcept;
+
+    protected:
+        friend class world;
+
+        struct block
+        {
+            char*  data;
+            size_t size;
+        };
+
+        template <typename T, typename... Args>
+        void DoAdd(entity e, Args&&... args);
+
+        void* DoAllocate(size_t size, size_t alignment);
+
+        // Сбрасывает команды, компоненты которых уже перенесены или уничтожены миром.
+        void DoReset() noexcept;
+
+        CORSAC_ALLOCATOR_TYPE mAllocator;
+        vector<command>       mCommands;
+        vector<block>         mBlocks;
+        uint32_t              mBlock = 0;       // Текущий блок арены.
+        size_t                mOffset = 0;      // Занято в текущем блоке.
+        uint32_t              mSpawnCount = 0;
+    };
+
+    inline command_buffer::command_buffer()
+        : mAllocator(CORSAC_WORLD_DEFAULT_NAME), mCommands(CORSAC_WORLD_DEFAULT_ALLOCATOR), mBlocks(CORSAC_WORLD_DEFAULT_ALLOCATOR)
+    {}
+
+    inline command_buffer::~command_buffer()
+    {
+        clear();
+        for(block& b : mBlocks)
+            CORSAC_Free(mAllocator, b.data, b.size);
+    }
+
+    template <typename... Ts>
+    inline void command_buffer::spawn(Ts&&... components)
+    {
+        const entity pending(entity::npos, mSpawnCount++);
+        mCommands.push_back(command{ pending, command_type::spawn, 0, nullptr });
+        (DoAdd<remove_cvref_t<Ts>>(pending, corsac::forward<Ts>(components)), ...);
+    }
+
+    inline void command_buffer::despawn(entity e)
+    {
+        mCommands.push_back(command{ e, command_type::despawn, 0, nullptr });
+    }
+
+    template <typename T, typename... Args>
+    inline void command_buffer::add(entity e, Args&&... args)
+    {
+        DoAdd<remove_cvref_t<T>>(e, corsac::forward<Args>(args)...);
+    }
+
+    template <typename T>
+    inline void command_buffer::remove(entity e)
+    {
+        mCommands.push_back(command{ e, command_type::remove, component_type_id<T>(), nullptr });
+    }
+
+    inline void command_buffer::clear() noexcept
+    {
+        component_registry& registry = component_registry::get();
+        for(command& c : mCommands)
+        {
+            if(c.payload)
+                internal::destroy_component(registry.info(c.component), c.payload);
+        }
+        DoReset();
+    }
+
+    template <typename T, typename... Args>
+    inline void command_buffer::DoAdd(entity e, Args&&... args)
+    {
+        void* payload = DoAllocate(sizeof(T), alignof(T));
+        ::new (payload) T(corsac::forward<Args>(args)...);
+        mCommands.push_back(command{ e, command_type::add, component_type_id<T>(), payload });
+    }
+
+    inline void* command_buffer::DoAllocate(size_t size, size_t alignment)
+    {
+        for(;; ++mBlock, mOffset = 0)
+        {
+            if(mBlock == mBlocks.size())
+            {
+                const size_t blockSize = (size + alignment > CORSAC_COMMAND_BUFFER_BLOCK_SIZE) ? size + alignment : CORSAC_COMMAND_BUFFER_BLOCK_SIZE;
+                mBlocks.push_back(block{ (char*)CORSAC_ALLOC(mAllocator, blockSize), blockSize });
+            }
+
+            block& b = mBlocks[mBlock];
+            const uintptr_t p = ((uintptr_t)(b.data + mOffset) + alignment - 1) & ~(uintptr_t)(alignment - 1);
+            if(p + size <= (uintptr_t)(b.data + b.size))
+            {
+                mOffset = (size_t)(p + size - (uintptr_t)b.data);
+                return (void*)p;
+            }
+        }
+    }
+
+    inline void command_buffer::DoReset() noexcept
+    {
+        mCommands.clear();
+        mBlock = 0;
+        mOffset = 0;
+        mSpawnCount = 0;
+    }
+
+    /**
+     * world_snapshot
+     *
+     * Заполняется world::snapshot, память переиспользуется следующими снимками. Данные лежат в одном
+     * растущем блоке: положения сущностей, массивы сущностей архетипов и отрезки колонок (block).
+     * Полный снимок - по одному отрезку на колонку. Дельта ссылается на base: base должен жить
+     * и не перезаписываться, пока дельта нужна.
+     */
+    class world_snapshot
+    {
+    public:
+        world_snapshot();
+        ~world_snapshot();
+
+        world_snapshot(const world_snapshot&) = delete;
+        world_snapshot& operator=(const world_snapshot&) = delete;
+
+        bool empty() const noexcept { return mWorld == 0; }
+
+        // Такт мира в момент снимка: дельта копирует куски с тактом больше такта base.
+        uint32_t tick() const noexcept { return mTick; }
+        const world_snapshot* base() const noexcept { return mBase; }
+
+        // Занятая снимком память и число скопированных отрезков колонок.
+        size_t size_bytes() const noexcept { return mSize; }
+        uint32_t block_count() const noexcept { return (uint32_t)mBlocks.size(); }
+
+        // Память сохраняется для следующего снимка.
+        void clear() noexcept;
+
+    protected:
+        friend class world;
+
+        struct archetype_state
+        {
+            uint32_t size;
+            size_t   entities;      // Смещение массива сущностей в mData.
+        };
+
+        // Строки [first, first + count) колонки column архетипа archetype.
+        struct block
+        {
+            uint32_t archetype;
+            uint32_t column;
+            uint32_t first;
+            uint32_t count;
+            size_t   data;          // Смещение в mData.
+        };
+
+        // Копирует size байт в конец данных и возвращает смещение, выровненное на 8.
+        size_t DoAppend(const void* data, size_t size);
+
+        CORSAC_ALLOCATOR_TYPE   mAllocator;
+        char*                   mData = nullptr;
+        size_t                  mSize = 0;
+        size_t                  mCapacity = 0;
+        entity_manager          mEntities;
+        vector<archetype_state> mArchetypes;
+        vector<block>           mBlocks;
+        size_t                  mLocations = 0;
+        uint32_t                mLocationCount = 0;
+        uint64_t                mWorld = 0;
+        uint32_t                mTick = 0;
+        const world_snapshot*   mBase = nullptr;
+    };
+
+    inline world_snapshot::world_snapshot()
+        : mAllocator(CORSAC_WORLD_DEFAULT_NAME), mArchetypes(CORSAC_WORLD_DEFAULT_ALLOCATOR), mBlocks(CORSAC_WORLD_DEFAULT_ALLOCATOR)
+    {}
+
+    inline world_snapshot::~world_snapshot()
+    {
+        if(mData)
+            CORSAC_Free(mAllocator, mData, mCapacity);
+    }
+
+    inline void world_snapshot::clear() noexcept
+    {
+        mSize = 0;
+        mArchetypes.clear();
+        mBlocks.clear();
+        mLocations = 0;
+        mLocationCount = 0;
+        mWorld = 0;
+        mTick = 0;
+        mBase = nullptr;
+    }
+
+    inline size_t world_snapshot::DoAppend(const void* data, size_t size)
+    {
+        const size_t offset = (mSize + 7) & ~size_t(7);
+        if(offset + size > mCapacity)
+        {
+            const size_t capacity = (offset + size > 2 * mCapacity) ? offset + size : 2 * mCapacity;
+            char* newData = (char*)CORSAC_ALLOC(mAllocator, capacity);
+            if(mData)
+            {
+                memcpy(newData, mData, mSize);
+                CORSAC_Free(mAllocator, mData, mCapacity);
+            }
+            mData = newData;
+            mCapacity = capacity;
+        }
+        if(size)
+            memcpy(mData + offset, data, size);
+        mSize = offset + size;
+        return offset;
+    }
+
+    /**
+     * world
+     *
+     * Архетип 0 - пустой набор компонентов, в нем живут сущности без компонентов.
+     */
+    class world
+    {
+    public:
+        world();
+        ~world();
+
+        world(const world&) = delete;
+        world& operator=(const world&) = delete;
+
+        entity spawn();
+
+        template <typename... Ts>
+        entity spawn(Ts&&... components);
+
+        // Возвращает false, если сущность уже уничтожена.
+        bool despawn(entity e);
+
+        bool alive(entity e) const noexcept { return mEntities.alive(e); }
+
+        // Добавляет компонент T(args...) или заменяет существующий. Сущность должна быть живой.
+        template <typename T, typename... Args>
+        T& add(entity e, Args&&... args);
+
+        // Возвращает false, если компонента не было или сущность уничтожена.
+        template <typename T>
+        bool remove(entity e);
+
+        // nullptr, если компонента нет или сущность уничтожена.
+        template <typename T>
+        T* get(entity e) noexcept;
+
+        template <typename T>
+        const T* get(entity e) const noexcept;
+
+        template <typename T>
+        bool has(entity e) const noexcept;
+
+        uint32_t size() const noexcept { return mEntities.size(); }
+        const entity_manager& entities() const noexcept { return mEntities; }
+
+        uint32_t archetype_count() const noexcept { return (uint32_t)mArchetypes.size(); }
+        archetype& archetype_at(uint32_t i) noexcept { return *mArchetypes[i]; }
+        const archetype& archetype_at(uint32_t i) const noexcept { return *mArchetypes[i]; }
+
+        // Архетип с набором mask, создается при первом обращении.
+        archetype& find_archetype(const component_mask& mask);
+
+        // Буфер команд текущего потока для этого мира, создается при первом вызове в потоке.
+        command_buffer& thread_commands();
+
+        // Применяет команды одного буфера и очищает его.
+        void apply(command_buffer& commands);
+
+        // Применяет команды всех буферов thread_commands за один проход.
+        void flush();
+
+        // Текущий такт изменений: им помечаются записи через мир и применение команд. Обход query
+        // занимает собственный такт (advance_tick до и после обхода), поэтому запрос не видит своих записей.
+        uint32_t change_tick() const noexcept { return mTick; }
+        uint32_t advance_tick() noexcept { return ++mTick; }
+
+        // Снимок в out: полный или, с base, дельта к полному снимку base этого мира. Занимает такт мира.
+        // Все компоненты в непустых архетипах должны быть тривиально копируемыми: байты string или
+        // unique_ptr нельзя скопировать memcpy и затем записать поверх живых объектов. Если это не так
+        // или base не полный снимок этого мира, возвращает false и оставляет out пустым.
+        bool snapshot(world_snapshot& out, const world_snapshot* base = nullptr);
+
+        // Возвращает мир к снимку. Такт мира не откатывается: все восстановленные компоненты
+        // помечаются добавленными и измененными текущим тактом. Команды в буферах не затрагиваются.
+        // Пустой снимок или снимок другого мира не применяется, тогда возвращается false.
+        bool restore(const world_snapshot& s);
+
+    protected:
+        struct location
+        {
+            uint32_t archetype;
+            uint32_t row;
+        };
+
+        struct payload_ref
+        {
+            component_id component;
+            void*        data;
+        };
+
+        // Сущность после свертки своих команд: переезд src -> dst (dst == npos - уничтожение)
+        // и компоненты команд add [payloadBegin, payloadEnd) в mApplyPayloads.
+        struct move_plan
+        {
+            entity   target;
+            uint32_t src;
+            uint32_t dst;
+            uint32_t payloadBegin;
+            uint32_t payloadEnd;
+        };
+
+        struct thread_commands_entry
+        {
+            std::thread::id thread;
+            command_buffer* commands;
+        };
+
+        static uint64_t GetNextId() noexcept
+        {
+            static std::atomic<uint64_t> next{1};
+            return next.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        uint32_t DoAddEdge(archetype& from, component_id id);
+        uint32_t DoRemoveEdge(archetype& from, component_id id);
+
+        // Переносит сущность в архетип to и возвращает ее новую строку. Компоненты, которых нет
+        // в to, уничтожаются, новые компоненты не инициализированы.
+        uint32_t DoMoveEntity(entity e, archetype& to);
+
+        // Закрывает строку row в архетипе a и исправляет положение переехавшей сущности.
+        void DoEraseRow(archetype& a, uint32_t row) noexcept;
+
+        void DoApply(command_buffer* const* buffers, uint32_t count);
+        void DoApplyGroup(const move_plan* plans, uint32_t count);
+
+        // Закрывает строки mApplyRows, компоненты которых уже перенесены или уничтожены.
+        void DoEraseRows(archetype& a);
+
+        entity_manager        mEntities;
+        vector<location>      mLocations;           // По индексу сущности.
+        vector<archetype*>    mArchetypes;
+        uint64_t              mId;
+        uint32_t              mTick = 1;
+
+        vector<thread_commands_entry> mThreadCommands;
+        std::mutex                    mThreadCommandsMutex;
+
+        // Рабочие массивы DoApply, сохраняются между вызовами.
+        vector<command_buffer::command> mApplyCommands;
+        vector<command_buffer::command> mApplyCommandsBuffer;
+        vector<move_plan>               mApplyPlans;
+        vector<move_plan>               mApplyPlansBuffer;
+        vector<payload_ref>             mApplyPayloads;
+        vector<component_id>            mApplyTouched;
+        vector<entity>                  mApplyEntities;
+        vector<uint32_t>                mApplyRows;
+        vector<uint32_t>                mApplyRowsBuffer;
+        uint32_t                        mApplyLive[CORSAC_WORLD_MAX_COMPONENTS];
+
+        vector<uint8_t>                 mSnapshotMoved;     // Рабочий массив snapshot: куски, где сменились сущности.
+    };
+
+    inline world::world()
+        : mLocations(CORSAC_WORLD_DEFAULT_ALLOCATOR), mArchetypes(CORSAC_WORLD_DEFAULT_ALLOCATOR), mId(GetNextId()),
+          mThreadCommands(CORSAC_WORLD_DEFAULT_ALLOCATOR), mApplyCommands(CORSAC_WORLD_DEFAULT_ALLOCATOR),
+          mApplyCommandsBuffer(CORSAC_WORLD_DEFAULT_ALLOCATOR), mApplyPlans(CORSAC_WORLD_DEFAULT_ALLOCATOR),
+          mApplyPlansBuffer(CORSAC_WORLD_DEFAULT_ALLOCATOR), mApplyPayloads(CORSAC_WORLD_DEFAULT_ALLOCATOR),
+          mApplyTouched(CORSAC_WORLD_DEFAULT_ALLOCATOR), mApplyEntities(CORSAC_WORLD_DEFAULT_ALLOCATOR), mApplyRows(CORSAC_WORLD_DEFAULT_ALLOCATOR),
+          mApplyRowsBuffer(CORSAC_WORLD_DEFAULT_ALLOCATOR), mSnapshotMoved(CORSAC_WORLD_DEFAULT_ALLOCATOR)
+    {
+        memset(mApplyLive, 0xFF, sizeof(mApplyLive));
+        mArchetypes.push_back(new archetype(0, component_mask()));
+    }
+
+    inline world::~world()
+    {
+        for(thread_commands_entry& entry : mThreadCommands)
+            delete entry.commands;
+        for(archetype* a : mArchetypes)
+            delete a;
+    }
+
+    inline entity world::spawn()
+    {
+        const entity e = mEntities.create();
+        if(mLocations.size() < mEntities.capacity())
+            mLocations.resize(mEntities.capacity());
+        mLocations[e.index] = location{ 0, mArchetypes[0]->push_row(e) };
+        return e;
+    }
+
+    template <typename... Ts>
+    inline entity world::spawn(Ts&&... components)
+    {
+        archetype& a = find_archetype(component_mask::of<Ts...>());
+        CORSAC_ASSERT_MSG(a.column_count() == sizeof...(Ts), "world::spawn: duplicate component types.");
+
+        const entity e = mEntities.create();
+        if(mLocations.size() < mEntities.capacity())
+            mLocations.resize(mEntities.capacity());
+        const uint32_t row = a.push_row(e);
+        mLocations[e.index] = location{ a.index(), row };
+        (::new (a.DoElement(a.column_index(component_type_id<Ts>()), row)) remove_cvref_t<Ts>(corsac::forward<Ts>(components)), ...);
+        for(uint32_t c = 0; c < sizeof...(Ts); ++c)
+            a.mark_added(c, row, mTick);
+        return e;
+    }
+
+    inline bool world::despawn(entity e)
+    {
+        if(!alive(e))
+            return false;
+        const location loc = mLocations[e.index];
+        archetype& a = *mArchetypes[loc.archetype];
+        a.destroy_row(loc.row);
+        DoEraseRow(a, loc.row);
+        mEntities.destroy(e);
+        return true;
+    }
+
+    template <typename T, typename... Args>
+    inline T& world::add(entity e, Args&&... args)
+    {
+        CORSAC_ASSERT(alive(e));
+        using type = remove_cvref_t<T>;
+        const component_id id = component_type_id<type>();
+        const location loc = mLocations[e.index];
+        archetype& from = *mArchetypes[loc.archetype];
+
+        uint32_t c = from.column_index(id);
+        if(c != archetype::npos)
+        {
+            type* p = static_cast<type*>(from.DoElement(c, loc.row));
+            p->~type();
+            from.mark_changed(c, loc.row, mTick);
+            return *::new (p) type(corsac::forward<Args>(args)...);
+        }
+
+        archetype& to = *mArchetypes[DoAddEdge(from, id)];
+        const uint32_t row = DoMoveEntity(e, to);
+        c = to.column_index(id);
+        to.mark_added(c, row, mTick);
+        return *::new (to.DoElement(c, row)) type(corsac::forward<Args>(args)...);
+    }
+
+    template <typename T>
+    inline bool world::remove(entity e)
+    {
+        const component_id id = component_type_id<T>();
+        if(!alive(e))
+            return false;
+        archetype& from = *mArchetypes[mLocations[e.index].archetype];
+        if(from.column_index(id) == archetype::npos)
+            return false;
+        DoMoveEntity(e, *mArchetypes[DoRemoveEdge(from, id)]);
+        return true;
+    }
+
+    template <typename T>
+    inline T* world::get(entity e) noexcept
+    {
+        // Доступ на запись помечает компонент измененным, get<const T> - нет.
+        if(!alive(e))
+            return nullptr;
+        const location loc = mLocations[e.index];
+        archetype& a = *mArchetypes[loc.archetype];
+        const uint32_t c = a.column_index(component_type_id<T>());
+        if(c == archetype::npos)
+            return nullptr;
+        if constexpr(!is_const_v<T>)
+            a.mark_changed(c, loc.row, mTick);
+        return static_cast<T*>(a.DoElement(c, loc.row));
+    }
+
+    template <typename T>
+    inline const T* world::get(entity e) const noexcept
+    {
+        if(!alive(e))
+            return nullptr;
+        const location loc = mLocations[e.index];
+        const archetype& a = *mArchetypes[loc.archetype];
+        const uint32_t c = a.column_index(component_type_id<T>());
+        return (c == archetype::npos) ? nullptr : static_cast<const T*>(a.element(c, loc.row));
+    }
+
+    template <typename T>
+    inline bool world::has(entity e) const noexcept
+    {
+        return alive(e) && mArchetypes[mLocations[e.index].archetype]->mask().test(component_type_id<T>());
+    }
+
+    inline archetype& world::find_archetype(const component_mask& mask)
+    {
+        for(archetype* a : mArchetypes)
+        {
+            if(a->mask() == mask)
+                return *a;
+        }
+        mArchetypes.push_back(new archetype((uint32_t)mArchetypes.size(), mask));
+        return *mArchetypes.back();
+    }
+
+    inline command_buffer& world::thread_commands()
+    {
+        // Поток запоминает буфер последнего мира, с которым работал. Остальные ищутся под блокировкой.
+        struct cache
+        {
+            uint64_t        world;
+            command_buffer* commands;
+        };
+        static thread_local cache local = { 0, nullptr };
+        if(CORSAC_LIKELY(local.world == mId))
+            return *local.commands;
+
+        std::lock_guard<std::mutex> lock(mThreadCommandsMutex);
+        const std::thread::id thread = std::this_thread::get_id();
+        command_buffer* commands = nullptr;
+        for(thread_commands_entry& entry : mThreadCommands)
+        {
+            if(entry.thread == thread)
+                commands = entry.commands;
+        }
+        if(!commands)
+        {
+            commands = new command_buffer();
+            mThreadCommands.push_back(thread_commands_entry{ thread, commands });
+        }
+        local = cache{ mId, commands };
+        return *commands;
+    }
+
+    inline void world::apply(command_buffer& commands)
+    {
+        command_buffer* buffers[] = { &commands };
+        DoApply(buffers, 1);
+    }
+
+    inline void world::flush()
+    {
+        vector<command_buffer*> buffers(CORSAC_WORLD_DEFAULT_ALLOCATOR);
+        {
+            std::lock_guard<std::mutex> lock(mThreadCommandsMutex);
+            buffers.reserve(mThreadCommands.size());
+            for(thread_commands_entry& entry : mThreadCommands)
+            {
+                if(!entry.commands->empty())
+                    buffers.push_back(entry.commands);
+            }
+        }
+        if(!buffers.empty())
+            DoApply(buffers.data(), (uint32_t)buffers.size());
+    }
+
+    inline bool world::snapshot(world_snapshot& out, const world_snapshot* base)
+    {
+        out.clear();
+        if(base && (base->mWorld != mId || base->mBase))
+        {
+            CORSAC_FAIL_MSG("world::snapshot: base must be a full snapshot of this world.");
+            return false;
+        }
+
+        // Проверка до копирования: в релизе нетривиальный компонент не должен попасть в снимок.
+        for(const archetype* a : mArchetypes)
+        {
+            for(uint32_t c = 0, columns = a->column_count(); a->size() && c < columns; ++c)
+            {
+                if(a->column_at(c).info->relocate)
+                    return false;
+            }
+        }
+
+        out.mWorld = mId;
+        out.mTick  = mTick;
+        out.mBase  = base;
+        advance_tick();     // Записи после снимка получают больший такт.
+
+        out.mEntities = mEntities;
+        out.mLocationCount = (uint32_t)mLocations.size();
+        out.mLocations = out.DoAppend(mLocations.data(), mLocations.size() * sizeof(location));
+
+        for(uint32_t i = 0, n = archetype_count(); i < n; ++i)
+        {
+            const archetype& a = *mArchetypes[i];
+            const uint32_t count = a.size();
+            out.mArchetypes.push_back(world_snapshot::archetype_state{ count, out.DoAppend(a.entities(), count * sizeof(entity)) });
+            if(!count)
+                continue;
+
+            // Кусок дельты копируется, если в нем записано что-то после base или его строки теперь
+            // занимают другие сущности: переезды переносят такты вместе со строками.
+            const bool full = !base || i >= base->mArchetypes.size();
+            const uint32_t chunks = (count + archetype::kChunkRows - 1) / archetype::kChunkRows;
+            if(!full)
+            {
+                const world_snapshot::archetype_state& was = base->mArchetypes[i];
+                const entity* wasEntities = (const entity*)(base->mData + was.entities);
+                mSnapshotMoved.resize(chunks);
+                for(uint32_t k = 0; k < chunks; ++k)
+                {
+                    const uint32_t first = k * archetype::kChunkRows;
+                    const uint32_t rows  = (count - first < archetype::kChunkRows) ? count - first : archetype::kChunkRows;
+                    mSnapshotMoved[k] = first + rows > was.size || memcmp(a.entities() + first, wasEntities + first, rows * sizeof(entity)) != 0;
+                }
+            }
+
+            for(uint32_t c = 0, columns = a.column_count(); c < columns; ++c)
+            {
+                const component_info& info = *a.column_at(c).info;
+                const char* data = static_cast<const char*>(a.column_data(c));
+                if(full)
+                {
+                    out.mBlocks.push_back(world_snapshot::block{ i, c, 0, count, out.DoAppend(data, count * info.size) });
+                    continue;
+                }
+
+                // Подряд идущие измененные куски - один отрезок.
+                const uint32_t* chunkTicks = a.chunk_changed_ticks(c);
+                for(uint32_t k = 0; k < chunks;)
+                {
+                    if(!mSnapshotMoved[k] && chunkTicks[k] <= base->mTick)
+                    {
+                        ++k;
+                        continue;
+                    }
+                    const uint32_t first = k * archetype::kChunkRows;
+                    while(k < chunks && (mSnapshotMoved[k] || chunkTicks[k] > base->mTick))
+                        ++k;
+                    const uint32_t last = (k * archetype::kChunkRows < count) ? k * archetype::kChunkRows : count;
+                    out.mBlocks.push_back(world_snapshot::block{ i, c, first, last - first,
+                                                                 out.DoAppend(data + first * info.size, (last - first) * info.size) });
+                }
+            }
+        }
+        return true;
+    }
+
+    inline bool world::restore(const world_snapshot& s)
+    {
+        if(s.mWorld != mId)
+        {
+            CORSAC_FAIL_MSG("world::restore: empty snapshot or snapshot of another world.");
+            return false;
+        }
+
+        // Текущие компоненты уничтожаются, строки и сущности архетипов берутся из снимка.
+        // Архетипы, созданные после снимка, остаются пустыми.
+        for(uint32_t i = 0, n = archetype_count(); i < n; ++i)
+        {
+            archetype& a = *mArchetypes[i];
+            for(uint32_t c = 0, columns = a.column_count(); c < columns; ++c)
+            {
+                const component_info& info = *a.column_at(c).info;
+                if(info.destroy)
+                {
+                    for(uint32_t row = 0, count = a.size(); row < count; ++row)
+                        info.destroy(a.DoElement(c, row));
+                }
+            }
+
+            // Строки убираются до reserve, чтобы рост не переносил уничтоженные компоненты.
+            const uint32_t count = (i < s.mArchetypes.size()) ? s.mArchetypes[i].size : 0;
+            a.mEntities.clear();
+            a.reserve(count);
+            a.mEntities.resize(count);
+            if(count)
+                memcpy(a.mEntities.data(), s.mData + s.mArchetypes[i].entities, count * sizeof(entity));
+        }
+
+        // Сначала отрезки полного снимка, затем дельты: строки чистых кусков у них совпадают.
+        const world_snapshot* layers[] = { s.mBase ? s.mBase : &s, &s };
+        for(uint32_t l = s.mBase ? 0 : 1; l < 2; ++l)
+        {
+            const world_snapshot& layer = *layers[l];
+            for(const world_snapshot::block& b : layer.mBlocks)
+            {
+                archetype& a = *mArchetypes[b.archetype];
+                if(b.first >= a.size())
+                    continue;
+                const uint32_t count = (b.count < a.size() - b.first) ? b.count : a.size() - b.first;
+                memcpy(a.DoElement(b.column, b.first), layer.mData + b.data, count * a.column_at(b.column).info->size);
+            }
+        }
+
+        for(archetype* a : mArchetypes)
+        {
+            for(uint32_t c = 0, columns = a->column_count(); c < columns; ++c)
+                a->mark_added(c, 0, a->size(), mTick);
+        }
+
+        mEntities = s.mEntities;
+        mLocations.resize(s.mLocationCount);
+        if(s.mLocationCount)
+            memcpy(mLocations.data(), s.mData + s.mLocations, s.mLocationCount * sizeof(location));
+        return true;
+    }
+
+    inline uint32_t world::DoAddEdge(archetype& from, component_id id)
+    {
+        uint32_t to = from.add_edge(id);
+        if(to == archetype::npos)
+        {
+            component_mask mask = from.mask();
+            mask.set(id);
+            to = find_archetype(mask).index();
+            from.set_add_edge(id, to);
+        }
+        return to;
+    }
+
+    inline uint32_t world::DoRemoveEdge(archetype& from, component_id id)
+    {
+        uint32_t to = from.remove_edge(id);
+        if(to == archetype::npos)
+        {
+            component_mask mask = from.mask();
+            mask.reset(id);
+            to = find_archetype(mask).index();
+            from.set_remove_edge(id, to);
+        }
+        return to;
+    }
+
+    inline uint32_t world::DoMoveEntity(entity e, archetype& to)
+    {
+        const location loc = mLocations[e.index];
+        archetype& from = *mArchetypes[loc.archetype];
+        const uint32_t row = to.push_row(e);
+        for(uint32_t c = 0, n = from.column_count(); c < n; ++c)
+        {
+            const archetype::column& column = from.column_at(c);
+            const uint32_t toColumn = to.column_index(column.id);
+            if(toColumn == archetype::npos)
+                internal::destroy_component(*column.info, from.DoElement(c, loc.row));
+            else
+            {
+                internal::relocate_component(*column.info, to.DoElement(toColumn, row), from.DoElement(c, loc.row));
+                to.copy_ticks(toColumn, row, from, c, loc.row);
+            }
+        }
+        DoEraseRow(from, loc.row);
+        mLocations[e.index] = location{ to.index(), row };
+        return row;
+    }
+
+    inline void world::DoEraseRow(archetype& a, uint32_t row) noexcept
+    {
+        const entity moved = a.erase_row(row);
+        if(!moved.is_null())
+            mLocations[moved.index].row = row;
+    }
+
+    inline void world::DoApply(command_buffer* const* buffers, uint32_t count)
+    {
+        component_registry& registry = component_registry::get();
+
+        // 1. Все новые сущности создаются одним пакетом в пустом архетипе.
+        uint32_t spawnCount = 0;
+        for(uint32_t b = 0; b < count; ++b)
+            spawnCount += buffers[b]->spawn_count();
+        mApplyEntities.resize(spawnCount);
+        if(spawnCount)
+        {
+            mEntities.create(spawnCount, mApplyEntities.data());
+            if(mLocations.size() < mEntities.capacity())
+                mLocations.resize(mEntities.capacity());
+            const uint32_t firstRow = mArchetypes[0]->push_rows(mApplyEntities.data(), spawnCount);
+            for(uint32_t i = 0; i < spawnCount; ++i)
+                mLocations[mApplyEntities[i].index] = location{ 0, firstRow + i };
+        }
+
+        // 2. Команды всех буферов с настоящими целями, затем устойчивая сортировка по индексу сущности.
+        uint32_t commandCount = 0;
+        for(uint32_t b = 0; b < count; ++b)
+            commandCount += buffers[b]->size();
+        mApplyCommands.resize(commandCount);
+        commandCount = 0;
+        for(uint32_t b = 0, spawnBase = 0; b < count; ++b)
+        {
+            const command_buffer& commands = *buffers[b];
+            command_buffer::command* out = mApplyCommands.data();
+            for(uint32_t i = 0, n = commands.size(); i < n; ++i)
+            {
+                command_buffer::command c = commands.data()[i];
+                if(c.type == command_buffer::command_type::spawn)
+                    continue;
+                if(c.target.is_null())
+                    c.target = mApplyEntities[spawnBase + c.target.generation];
+                out[commandCount++] = c;
+            }
+            spawnBase += commands.spawn_count();
+        }
+
+        // Системы обычно пишут команды сущность за сущностью, тогда сортировка сводится к одной проверке.
+        mApplyCommandsBuffer.resize(commandCount);
+        const command_buffer::command* sorted = internal::radix_sort(mApplyCommands.data(), mApplyCommandsBuffer.data(), commandCount,
+                                                                     [](const command_buffer::command& c) { return (uint64_t)c.target.index; });
+
+        // 3. Свертка команд каждой сущности в один переезд. mApplyLive[id] - номер команды add, чей
+        //    компонент окажется в сущности, kDropped - компонент снят, npos - команд с ним не было.
+        static constexpr uint32_t kDropped = archetype::npos - 1;
+        mApplyPlans.clear();
+        mApplyPayloads.clear();
+        component_mask lastMask;
+        uint32_t lastDst = archetype::npos;
+        for(uint32_t first = 0, last = 0; first < commandCount; first = last)
+        {
+            const uint32_t index = sorted[first].target.index;
+            while(last < commandCount && sorted[last].target.index == index)
+                ++last;
+
+            // Команды для уничтоженных сущностей и для прошлых поколений индекса пропускаются.
+            const entity target = mEntities.at(index);
+            const uint32_t src = target.is_null() ? 0 : mLocations[index].archetype;
+            component_mask mask = mArchetypes[src]->mask();
+            bool despawned = false;
+
+            mApplyTouched.clear();
+            for(uint32_t i = first; i < last; ++i)
+            {
+                const command_buffer::command& c = sorted[i];
+                if(despawned || c.target != target)
+                {
+                    if(c.payload)
+                        internal::destroy_component(registry.info(c.component), c.payload);
+                    continue;
+                }
+
+                uint32_t& live = mApplyLive[c.component];
+                switch(c.type)
+                {
+                    case command_buffer::command_type::add:
+                        if(live == archetype::npos)
+                            mApplyTouched.push_back(c.component);
+                        else if(live != kDropped)
+                            internal::destroy_component(registry.info(c.component), sorted[live].payload);
+                        live = i;
+                        mask.set(c.component);
+                        break;
+
+                    case command_buffer::command_type::remove:
+                        if(live != archetype::npos && live != kDropped)
+                        {
+                            internal::destroy_component(registry.info(c.component), sorted[live].payload);
+                            live = kDropped;
+                        }
+                        mask.reset(c.component);
+                        break;
+
+                    default:
+                        despawned = true;
+                        break;
+                }
+            }
+
+            if(target.is_null())
+                continue;
+
+            const uint32_t payloadBegin = (uint32_t)mApplyPayloads.size();
+            for(component_id id : mApplyTouched)
+            {
+                const uint32_t live = mApplyLive[id];
+                if(live != kDropped)
+                {
+                    if(despawned)
+                        internal::destroy_component(registry.info(id), sorted[live].payload);
+                    else
+                        mApplyPayloads.push_back(payload_ref{ id, sorted[live].payload });
+                }
+                mApplyLive[id] = archetype::npos;
+            }
+            const uint32_t payloadEnd = (uint32_t)mApplyPayloads.size();
+
+            if(despawned || payloadEnd != payloadBegin || mask != mArchetypes[src]->mask())
+            {
+                // Соседние сущности обычно получают одинаковый набор: поиск архетипа повторяется только при смене набора.
+                if(!despawned && (lastDst == archetype::npos || mask != lastMask))
+                {
+                    lastMask = mask;
+                    lastDst  = find_archetype(mask).index();
+                }
+                const uint32_t dst = despawned ? archetype::npos : lastDst;
+                mApplyPlans.push_back(move_plan{ target, src, dst, payloadBegin, payloadEnd });
+            }
+        }
+
+        // 4. Переезды группируются по паре архетипов и выполняются по колонкам.
+        const uint32_t planCount = (uint32_t)mApplyPlans.size();
+        mApplyPlansBuffer.resize(planCount);
+        const move_plan* plans = internal::radix_sort(mApplyPlans.data(), mApplyPlansBuffer.data(), planCount,
+                                                      [](const move_plan& p) { return ((uint64_t)p.src << 32) | p.dst; });
+        for(uint32_t first = 0, last = 0; first < planCount; first = last)
+        {
+            while(last < planCount && plans[last].src == plans[first].src && plans[last].dst == plans[first].dst)
+                ++last;
+            DoApplyGroup(plans + first, last - first);
+        }
+
+        // Компоненты команд перенесены в колонки или уничтожены, буферы сбрасываются без деструкторов.
+        for(uint32_t b = 0; b < count; ++b)
+            buffers[b]->DoReset();
+    }
+
+    inline void world::DoApplyGroup(const move_plan* plans, uint32_t count)
+    {
+        component_registry& registry = component_registry::get();
+        archetype& from = *mArchetypes[plans[0].src];
+
+        // Строки читаются сейчас: переезды предыдущих групп могли сдвинуть сущности этого архетипа.
+        mApplyRows.resize(count);
+        for(uint32_t i = 0; i < count; ++i)
+            mApplyRows[i] = mLocations[plans[i].target.index].row;
+
+        if(plans[0].dst == archetype::npos)
+        {
+            mApplyEntities.resize(count);
+            for(uint32_t i = 0; i < count; ++i)
+            {
+                from.destroy_row(mApplyRows[i]);
+                mApplyEntities[i] = plans[i].target;
+            }
+            DoEraseRows(from);
+            mEntities.destroy(mApplyEntities.data(), count);
+            return;
+        }
+
+        archetype& to = *mArchetypes[plans[0].dst];
+        if(&to == &from)
+        {
+            // Набор компонентов не изменился, компоненты команд add заменяют существующие.
+            for(uint32_t i = 0; i < count; ++i)
+            {
+                for(uint32_t p = plans[i].payloadBegin; p < plans[i].payloadEnd; ++p)
+                {
+                    const payload_ref& payload = mApplyPayloads[p];
+                    const component_info& info = registry.info(payload.component);
+                    const uint32_t c = to.column_index(payload.component);
+                    void* element = to.DoElement(c, mApplyRows[i]);
+                    internal::destroy_component(info, element);
+                    internal::relocate_component(info, element, payload.data);
+                    to.mark_changed(c, mApplyRows[i], mTick);
+                }
+            }
+            return;
+        }
+
+        mApplyEntities.resize(count);
+        for(uint32_t i = 0; i < count; ++i)
+            mApplyEntities[i] = plans[i].target;
+        const uint32_t firstRow = to.push_rows(mApplyEntities.data(), count);
+        for(uint32_t i = 0; i < count; ++i)
+            mLocations[plans[i].target.index] = location{ to.index(), firstRow + i };
+
+        // Колонка за колонкой: общие компоненты переносятся подряд в конец to, снятые уничтожаются.
+        for(uint32_t c = 0, n = from.column_count(); c < n; ++c)
+        {
+            const archetype::column& column = from.column_at(c);
+            const component_info& info = *column.info;
+            const uint32_t toColumn = to.column_index(column.id);
+            if(toColumn == archetype::npos)
+            {
+                if(info.destroy)
+                {
+                    for(uint32_t i = 0; i < count; ++i)
+                        info.destroy(column.data + mApplyRows[i] * info.size);
+                }
+                continue;
+            }
+
+            char* out = static_cast<char*>(to.DoElement(toColumn, firstRow));
+            if(info.relocate)
+            {
+                for(uint32_t i = 0; i < count; ++i)
+                    info.relocate(out + i * info.size, column.data + mApplyRows[i] * info.size);
+            }
+            else
+            {
+                // Подряд идущие строки (например, весь архетип переезжает целиком) копируются одним memcpy.
+                for(uint32_t i = 0, run; i < count; i += run)
+                {
+                    for(run = 1; i + run < count && mApplyRows[i + run] == mApplyRows[i] + run; ++run)
+                        ;
+                    memcpy(out + i * info.size, column.data + mApplyRows[i] * info.size, run * info.size);
+                }
+            }
+            for(uint32_t i = 0; i < count; ++i)
+                to.copy_ticks(toColumn, firstRow + i, from, c, mApplyRows[i]);
+        }
+
+        // Компоненты команд add: новые переносятся из арены, существующие заменяются.
+        for(uint32_t i = 0; i < count; ++i)
+        {
+            for(uint32_t p = plans[i].payloadBegin; p < plans[i].payloadEnd; ++p)
+            {
+                const payload_ref& payload = mApplyPayloads[p];
+                const component_info& info = registry.info(payload.component);
+                const uint32_t c = to.column_index(payload.component);
+                void* element = to.DoElement(c, firstRow + i);
+                if(from.mask().test(payload.component))
+                {
+                    internal::destroy_component(info, element);
+                    to.mark_changed(c, firstRow + i, mTick);
+                }
+                else
+                    to.mark_added(c, firstRow + i, mTick);
+                internal::relocate_component(info, element, payload.data);
+            }
+        }
+
+        DoEraseRows(from);
+    }
+
+    inline void world::DoEraseRows(archetype& a)
+    {
+        // По убыванию: все строки группы выше текущей уже убраны, поэтому на место каждой
+        // переезжает сущность не из группы.
+        const uint32_t count = (uint32_t)mApplyRows.size();
+        mApplyRowsBuffer.resize(count);
+        const uint32_t* rows = internal::radix_sort(mApplyRows.data(), mApplyRowsBuffer.data(), count,
+                                                    [](uint32_t row) { return (uint64_t)row; });
+        for(uint32_t i = count; i-- > 0;)
+            DoEraseRow(a, rows[i]);
+    }
+}
+
+#endif //CORSAC_STL_WORLD_H
@@ -0,0 +1,218 @@
+//
+// test/Test.h
+//
+// Created by Falldot on 26.11.2021.
+// Copyright (c) 2021 Corsac. All rights reserved.
+//
+#ifndef CORSAC_TEST_H
+#define CORSAC_TEST_H
+
+/**
+ * Описание (Falldot 26.11.2021)
+ *
+ * Каркас модульных тестов corsac::STL.
+ *
+ * Тесты организованы в дерево блоков. add_block только регистрирует дочерний блок,
+ * выполнение начинается с вызова start() у корня: тело блока выполняется, затем по порядку
+ * выполняются зарегистрированные в нем дочерние блоки. Для каждого блока замеряется время
+ * выполнения вместе с дочерними блоками.
+ *
+ * Настройки (определяются до включения Test.h):
+ *      TEST_ENABLE             - без него start() ничего не выполняет и сразу возвращает 0;
+ *      CORSAC_TEST_TIME_OFF    - не выводить время выполнения блоков;
+ *      CORSAC_TEST_RESULT_OFF  - не выводить успешные проверки, только проваленные и итоги блоков.
+ *
+ * start() возвращает 0, если все проверки прошли, иначе 1, и его удобно вернуть из main,
+ * чтобы ctest видел результат.
+ *
+ * Пример использования:
+ *      auto assert = new corsac::Block("STL");
+ *      assert->add_block("vector", [](corsac::Block* assert) {
+ *          assert->is_true("empty", corsac::vector<int>().empty());
+ *          assert->equal("size", v.size(), 3u)->add_comment("after push_back");
+ *      });
+ *      return assert->start();
+ */
+
+#include <new>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#define CORSAC_TEST_UNUSED(x) ((void)(x))
+
+namespace corsac
+{
+    /**
+     * Assert
+     *
+     * Результат одной проверки. К нему можно добавить комментарий, который выводится вместе с результатом.
+     */
+    class Assert
+    {
+    public:
+        Assert(const char* name, bool passed, std::string details = std::string())
+            : mName(name), mDetails(std::move(details)), mPassed(passed) {}
+
+        Assert* add_comment(const char* comment)
+        {
+            mComment = comment;
+            return this;
+        }
+
+        bool passed() const { return mPassed; }
+
+        void print(int depth) const
+        {
+            printf("%*s%s %s", depth * 2, "", mPassed ? "[ok]  " : "[FAIL]", mName.c_str());
+            if(!mDetails.empty())
+                printf(" (%s)", mDetails.c_str());
+            if(!mComment.empty())
+                printf(" // %s", mComment.c_str());
+            printf("\n");
+        }
+
+    private:
+        std::string mName;
+        std::string mDetails;
+        std::string mComment;
+        bool        mPassed;
+    };
+
+    class Block
+    {
+    public:
+        using body_type = std::function<void(Block*)>;
+
+        explicit Block(const char* name, body_type body = body_type())
+            : mName(name), mBody(std::move(body)) {}
+
+        Block(const Block&) = delete;
+        Block& operator=(const Block&) = delete;
+
+        /**
+         * add_block
+         *
+         * Регистрирует дочерний блок. Он будет выполнен после тела текущего блока.
+         */
+        Block* add_block(const char* name, body_type body)
+        {
+            mChildren.emplace_back(new Block(name, std::move(body)));
+            return mChildren.back().get();
+        }
+
+        Assert* is_true(const char* name, bool value)
+        {
+            return add_assert(name, value);
+        }
+
+        Assert* is_false(const char* name, bool value)
+        {
+            return add_assert(name, !value);
+        }
+
+        template <typename T, typename U>
+        Assert* equal(const char* name, const T& actual, const U& expected)
+        {
+            const bool passed = equal_values(actual, expected);
+            return add_assert(name, passed, passed ? std::string() : "got " + to_string(actual) + ", expected " + to_string(expected));
+        }
+
+        /**
+         * start
+         *
+         * Выполняет блок и все дочерние блоки, выводит результаты.
+         * Возвращает 0, если провалившихся проверок нет, иначе 1.
+         */
+        int start()
+        {
+            #if defined(TEST_ENABLE)
+                run(0);
+                printf("\n%zu passed, %zu failed\n", mPassedTotal, mFailedTotal);
+                return mFailedTotal ? 1 : 0;
+            #else
+                return 0;
+            #endif
+        }
+
+        size_t passed_count() const { return mPassedTotal; }
+        size_t failed_count() const { return mFailedTotal; }
+
+    private:
+        void run(int depth)
+        {
+            const auto start = std::chrono::steady_clock::now();
+
+            printf("%*s[%s]\n", depth * 2, "", mName.c_str());
+            if(mBody)
+                mBody(this);
+
+            for(const std::unique_ptr<Assert>& a : mAsserts)
+            {
+                #if defined(CORSAC_TEST_RESULT_OFF)
+                    if(a->passed())
+                        continue;
+                #endif
+                a->print(depth + 1);
+            }
+
+            for(const std::unique_ptr<Block>& child : mChildren)
+            {
+                child->run(depth + 1);
+                mPassedTotal += child->mPassedTotal;
+                mFailedTotal += child->mFailedTotal;
+            }
+
+            #if !defined(CORSAC_TEST_TIME_OFF)
+                const auto   stop = std::chrono::steady_clock::now();
+                const double ms   = std::chrono::duration<double, std::milli>(stop - start).count();
+                printf("%*s%s: %zu passed, %zu failed, %.3f ms\n", depth * 2, "", mName.c_str(), mPassedTotal, mFailedTotal, ms);
+            #else
+                CORSAC_TEST_UNUSED(start);
+            #endif
+        }
+
+        Assert* add_assert(const char* name, bool passed, std::string details = std::string())
+        {
+            ++(passed ? mPassedTotal : mFailedTotal);
+            mAsserts.emplace_back(new Assert(name, passed, std::move(details)));
+            return mAsserts.back().get();
+        }
+
+        template <typename T, typename U>
+        static bool equal_values(const T& actual, const U& expected)
+        {
+            if constexpr(std::is_convertible<T, const char*>::value && std::is_convertible<U, const char*>::value)
+                return strcmp(actual, expected) == 0;
+            else
+                return actual == expected;
+        }
+
+        template <typename T>
+        static std::string to_string(const T& value)
+        {
+            if constexpr(std::is_convertible<T, const char*>::value)
+                return std::string("\"") + static_cast<const char*>(value) + "\"";
+            else if constexpr(std::is_arithmetic<T>::value)
+                return std::to_string(value);
+            else
+                return "?";
+        }
+
+        std::string                         mName;
+        body_type                           mBody;
+        std::vector<std::unique_ptr<Block>> mChildren;
+        std::vector<std::unique_ptr<Assert>> mAsserts;
+        size_t                              mPassedTotal = 0;
+        size_t                              mFailedTotal = 0;
+    };
+}
+
+#endif //CORSAC_TEST_H
@@ -0,0 +1,66 @@
+//
+// test/chrono_test.h
+//
+// Created by Falldot on 18.10.2026.
+// Copyright (c) 2021 Corsac. All rights reserved.
+//
+#ifndef CORSAC_CHRONO_TEST_H
+#define CORSAC_CHRONO_TEST_H
+
+#include "Corsac/chrono.h"
+
+#include <time.h>
+
+bool chrono_test(corsac::Block* assert)
+{
+    using namespace corsac::chrono;
+
+    assert->add_block("steady_clock", [](corsac::Block* assert)
+    {
+        bool monotonic = true;
+        steady_clock::time_point previous = steady_clock::now();
+        for(int i = 0; i < 1000; ++i)
+        {
+            const steady_clock::time_point now = steady_clock::now();
+            monotonic = monotonic && previous <= now;
+            previous = now;
+        }
+        assert->is_true("monotonic", monotonic);
+        assert->is_true("is_steady", steady_clock::is_steady);
+        assert->is_true("high_resolution_clock is steady_clock", corsac::is_same<high_resolution_clock, steady_clock>::value);
+    });
+    assert->add_block("system_clock", [](corsac::Block* assert)
+    {
+        const long long seconds = duration_cast<corsac::chrono::seconds>(system_clock::now().time_since_epoch()).count();
+        const long long expected = (long long)time(nullptr);
+        assert->is_true("epoch is 1970", seconds >= expected - 2 && seconds <= expected + 2);
+    });
+    assert->add_block("tsc_clock", [](corsac::Block* assert)
+    {
+        bool monotonic = true;
+        tsc_clock::time_point previous = tsc_clock::now();
+        for(int i = 0; i < 1000; ++i)
+        {
+            const tsc_clock::time_point now = tsc_clock::now();
+            monotonic = monotonic && previous <= now;
+            previous = now;
+        }
+        assert->is_true("monotonic", monotonic);
+
+        const steady_clock::time_point steadyBegin = steady_clock::now();
+        const tsc_clock::time_point    tscBegin    = tsc_clock::now();
+        while(steady_clock::now() - steadyBegin < milliseconds(20))
+            ;
+        const long long tscNs    = duration_cast<nanoseconds>(tsc_clock::now() - tscBegin).count();
+        const long long steadyNs = duration_cast<nanoseconds>(steady_clock::now() - steadyBegin).count();
+        assert->is_true("agrees with steady_clock", tscNs > steadyNs * 9 / 10 && tscNs < steadyNs * 11 / 10);
+
+        const uint64_t ticks = tsc_clock::ticks();
+        const uint64_t ordered = tsc_clock::ticks_ordered();
+        assert->is_true("ticks_ordered after ticks", ordered >= ticks);
+        assert->is_true("ns_per_tick", tsc_clock::ns_per_tick() > 0.0);
+    });
+    return true;
+}
+
+#endif //CORSAC_CHRONO_TEST_H
@@ -0,0 +1,70 @@
+//
+// test/entity_test.h
+//
+// Created by Falldot on 18.10.2026.
+// Copyright (c) 2021 Corsac. All rights reserved.
+//
+#ifndef CORSAC_ENTITY_TEST_H
+#define CORSAC_ENTITY_TEST_H
+
+#include "Corsac/entity.h"
+
+bool entity_test(corsac::Block* assert)
+{
+    assert->add_block("entity_manager", [](corsac::Block* assert)
+    {
+        corsac::entity_manager entities;
+        assert->is_true("empty", entities.size() == 0 && !entities.alive(corsac::entity()));
+
+        corsac::entity single = entities.create();
+        assert->is_true("create", entities.alive(single) && single.index == 0 && single.generation == 0);
+
+        // Пакет пересекает границы слов маски.
+        static corsac::entity batch[300];
+        entities.create(300, batch);
+        bool created = true;
+        for(uint32_t i = 0; i < 300; ++i)
+            created = created && batch[i].index == i + 1 && entities.alive(batch[i]);
+        assert->is_true("create batch", created && entities.size() == 301);
+        assert->is_true("mask is padded to 256 bits", entities.alive_mask_words() == 8 && entities.validate());
+        assert->is_true("mask bits", entities.alive_mask()[0] == ~uint64_t(0) && entities.alive_mask()[4] == (uint64_t(1) << 45) - 1);
+        assert->equal("mask padding", entities.alive_mask()[7], (uint64_t)0);
+
+        // Каждая вторая сущность уничтожается, повторное уничтожение пропускается.
+        static corsac::entity odd[150];
+        for(uint32_t i = 0; i < 150; ++i)
+            odd[i] = batch[i * 2 + 1];
+        assert->equal("destroy batch", entities.destroy(odd, 150), 150u);
+        assert->equal("destroy twice", entities.destroy(odd, 150), 0u);
+        assert->is_true("stale", !entities.alive(odd[0]) && entities.alive(batch[0]) && entities.size() == 151);
+        assert->is_true("at", entities.at(odd[0].index).is_null() && entities.at(batch[0].index) == batch[0]);
+
+        uint32_t visited = 0;
+        bool ordered = true;
+        corsac::entity previous(0, 0);
+        entities.for_each_alive([&](corsac::entity e)
+        {
+            ordered = ordered && entities.alive(e) && (visited == 0 || previous.index < e.index);
+            previous = e;
+            ++visited;
+        });
+        assert->is_true("for_each_alive", ordered && visited == 151);
+
+        // Освобожденные индексы переиспользуются с новым поколением, остаток берется из конца.
+        static corsac::entity reused[160];
+        entities.create(160, reused);
+        bool recycled = true;
+        for(uint32_t i = 0; i < 150; ++i)
+            recycled = recycled && reused[i].generation == 1 && reused[i].index % 2 == 0 && reused[i].index != 0;
+        assert->is_true("recycle", recycled && reused[150].index == 301 && reused[159].index == 310);
+        assert->is_true("old ids stay dead", !entities.alive(odd[10]) && entities.validate());
+
+        entities.clear();
+        assert->is_true("clear", entities.size() == 0 && !entities.alive(single) && entities.validate());
+        corsac::entity again = entities.create();
+        assert->is_true("generation survives clear", again.index == 0 && again.generation == 1);
+    });
+    return true;
+}
+
+#endif //CORSAC_ENTITY_TEST_H
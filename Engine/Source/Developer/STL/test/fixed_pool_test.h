@@ -0,0 +1,40 @@
+//
+// test/fixed_pool_test.h
+//
+// Created by Falldot on 18.10.2026.
+// Copyright (c) 2021 Corsac. All rights reserved.
+//
+#ifndef CORSAC_FIXED_POOL_TEST_H
+#define CORSAC_FIXED_POOL_TEST_H
+
+#include "Corsac/STL/fixed_pool.h"
+
+bool fixed_pool_test(corsac::Block* assert)
+{
+    assert->add_block("fixed_pool", [](corsac::Block* assert)
+    {
+        // Буфер не кратен размеру узла: после четырех узлов по 24 байта остается хвост в 4 байта,
+        // в который узел не помещается.
+        alignas(8) static char buffer[100];
+        corsac::fixed_pool pool(buffer, sizeof(buffer), 24, 8);
+
+        int allocated = 0;
+        bool inside = true;
+        while(char* p = static_cast<char*>(pool.allocate()))
+        {
+            inside = inside && p >= buffer && p + 24 <= buffer + sizeof(buffer);
+            if(++allocated > 10)
+                break;
+        }
+        assert->equal("nodes", allocated, 4);
+        assert->is_true("nodes inside buffer", inside && !pool.can_allocate());
+
+        // Освобожденный узел переиспользуется.
+        void* p = buffer;
+        pool.deallocate(p);
+        assert->is_true("reuse", pool.can_allocate() && pool.allocate() == p && pool.allocate() == nullptr);
+    });
+    return true;
+}
+
+#endif //CORSAC_FIXED_POOL_TEST_H
@@ -0,0 +1,128 @@
+//
+// test/function_test.h
+//
+// Created by Falldot on 18.10.2026.
+// Copyright (c) 2021 Corsac. All rights reserved.
+//
+#ifndef CORSAC_FUNCTION_TEST_H
+#define CORSAC_FUNCTION_TEST_H
+
+#include "Corsac/functional.h"
+#include "Corsac/unique_ptr.h"
+
+inline int function_test_add(int a, int b)
+{
+    return a + b;
+}
+
+struct function_test_counter
+{
+    static int alive;
+
+    function_test_counter() { ++alive; }
+    function_test_counter(const function_test_counter&) = delete;
+    function_test_counter(function_test_counter&&) noexcept { ++alive; }
+    ~function_test_counter() { --alive; }
+
+    int operator()(int x) const { return x * 2; }
+};
+
+int function_test_counter::alive = 0;
+
+bool function_test(corsac::Block* assert)
+{
+    assert->add_block("unique_function", [](corsac::Block* assert)
+    {
+        static_assert(sizeof(corsac::unique_function<void()>) == 64, "default unique_function must fill one cache line");
+        static_assert(!corsac::is_copy_constructible<corsac::unique_function<void()>>::value, "unique_function must be move-only");
+
+        corsac::unique_function<int()> empty;
+        assert->is_true("empty", !empty && empty == nullptr);
+
+        // Захват некопируемого значения.
+        corsac::unique_function<int()> job = [value = corsac::make_unique<int>(41)] { return *value + 1; };
+        assert->is_true("move-only capture", job && job() == 42);
+
+        corsac::unique_function<int()> moved = corsac::move(job);
+        assert->is_true("move", !job && moved() == 42);
+
+        corsac::unique_function<int(int, int)> pointer = &function_test_add;
+        assert->equal("function pointer", pointer(2, 3), 5);
+        int (*nullPointer)(int, int) = nullptr;
+        corsac::unique_function<int(int, int)> fromNull = nullPointer;
+        assert->is_true("null function pointer is empty", !fromNull);
+
+        // Нетривиальный функтор: перемещается через relocate и уничтожается ровно один раз.
+        {
+            corsac::unique_function<int(int)> a = function_test_counter();
+            assert->equal("nontrivial call", a(21), 42);
+            assert->equal("one alive", function_test_counter::alive, 1);
+            corsac::unique_function<int(int)> b = corsac::move(a);
+            assert->equal("relocated", function_test_counter::alive, 1);
+            b = nullptr;
+            assert->equal("destroyed on reset", function_test_counter::alive, 0);
+            b = function_test_counter();
+        }
+        assert->equal("destroyed on scope exit", function_test_counter::alive, 0);
+
+        // Большой захват помещается в увеличенный буфер.
+        double matrix[16] = {};
+        matrix[5] = 2.5;
+        corsac::unique_function<double(), 160> big = [matrix] { return matrix[5]; };
+        assert->is_true("custom storage", big() == 2.5 && sizeof(big) >= 160);
+
+        corsac::unique_function<int()> left = [] { return 1; }, right = [] { return 2; };
+        swap(left, right);
+        assert->is_true("swap", left() == 2 && right() == 1);
+
+        int counter = 0;
+        corsac::unique_function<void()> mutableJob = [&counter, n = 0]() mutable { counter = ++n; };
+        mutableJob();
+        mutableJob();
+        assert->equal("mutable functor", counter, 2);
+    });
+    assert->add_block("function_ref", [](corsac::Block* assert)
+    {
+        static_assert(sizeof(corsac::function_ref<void()>) == 2 * sizeof(void*), "function_ref must be two pointers");
+
+        auto sum = [](corsac::function_ref<int(int)> f)
+        {
+            int total = 0;
+            for(int i = 1; i <= 4; ++i)
+                total += f(i);
+            return total;
+        };
+
+        int calls = 0;
+        assert->equal("lambda temporary", sum([&calls](int x) { ++calls; return x * x; }), 30);
+        assert->equal("captured state", calls, 4);
+
+        // Ссылка на существующий объект: он не копируется, состояние меняется в оригинале.
+        int counter = 0;
+        auto increment = [&counter, step = 2](int x) mutable { counter += step; return x; };
+        corsac::function_ref<int(int)> ref = increment;
+        ref(0);
+        ref(0);
+        assert->equal("no copy", counter, 4);
+
+        corsac::function_ref<int(int, int)> pointer = &function_test_add;
+        assert->equal("function pointer", pointer(2, 3), 5);
+        corsac::function_ref<int(int, int)> function = function_test_add;
+        assert->equal("function", function(4, 5), 9);
+
+        function_test_counter counterFunctor;
+        corsac::function_ref<long(int)> converted = counterFunctor;
+        assert->equal("return conversion", converted(8), 16L);
+
+        corsac::unique_function<int()> owned = [] { return 7; };
+        corsac::function_ref<int()> fromOwned = owned;
+        assert->equal("refers to unique_function", fromOwned(), 7);
+
+        corsac::function_ref<int(int)> copy = ref;
+        copy(0);
+        assert->equal("copy refers to same callable", counter, 6);
+    });
+    return true;
+}
+
+#endif //CORSAC_FUNCTION_TEST_H
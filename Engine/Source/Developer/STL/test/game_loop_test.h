@@ -0,0 +1,75 @@
+//
+// test/game_loop_test.h
+//
+// Created by Falldot on 18.10.2026.
+// Copyright (c) 2021 Corsac. All rights reserved.
+//
+#ifndef CORSAC_GAME_LOOP_TEST_H
+#define CORSAC_GAME_LOOP_TEST_H
+
+#include "Corsac/game_loop.h"
+
+bool game_loop_test(corsac::Block* assert)
+{
+    using namespace corsac::chrono;
+
+    assert->add_block("fixed_timestep", [](corsac::Block* assert)
+    {
+        corsac::fixed_timestep timestep(milliseconds(10), milliseconds(250), 8);
+        int updates = 0;
+        auto update = [&](corsac::fixed_timestep::duration step) { updates += step == milliseconds(10); };
+
+        assert->equal("25 ms -> 2 steps", timestep.advance(milliseconds(25), update), 2u);
+        assert->is_true("alpha", timestep.alpha() > 0.49 && timestep.alpha() < 0.51);
+        assert->equal("5 ms -> 1 step", timestep.advance(milliseconds(5), update), 1u);
+        assert->equal("alpha after whole step", timestep.alpha(), 0.0);
+        assert->equal("tick", timestep.tick(), (uint64_t)3);
+        assert->equal("update got step", updates, 3);
+
+        // 1 с обрезается до 250 мс, из 25 шагов выполняются 8, остальные отбрасываются.
+        assert->equal("spiral of death clamp", timestep.advance(seconds(1), update), 8u);
+        assert->is_true("dropped time", timestep.dropped_time() == milliseconds(750 + 170));
+        assert->equal("alpha after clamp", timestep.alpha(), 0.0);
+    });
+    assert->add_block("frame_pacer", [](corsac::Block* assert)
+    {
+        corsac::frame_pacer pacer(milliseconds(2));
+        const steady_clock::time_point begin = pacer.wait();
+        steady_clock::time_point previous = begin;
+        bool periodic = true;
+        for(int i = 0; i < 20; ++i)
+        {
+            // Дедлайн либо ровно через период, либо, если кадр опоздал больше чем на период,
+            // переносится на момент вызова - тогда он дальше двух периодов от предыдущего.
+            const steady_clock::time_point deadline = pacer.wait();
+            periodic = periodic && (deadline - previous == milliseconds(2) || deadline - previous > milliseconds(4));
+            previous = deadline;
+        }
+
+        // Реальное время ограничено только снизу: верхняя граница зависит от планировщика и нагрузки машины.
+        const long long elapsedUs = duration_cast<microseconds>(steady_clock::now() - begin).count();
+        assert->is_true("deadlines are periodic", periodic && previous - begin >= milliseconds(40));
+        assert->is_true("holds period", elapsedUs >= 40000);
+        assert->is_true("sleep estimate", pacer.sleep_estimate() > nanoseconds(0));
+
+        corsac::frame_pacer unlimited;
+        const steady_clock::time_point now = steady_clock::now();
+        assert->is_true("zero period does not wait", unlimited.wait() - now < milliseconds(1));
+    });
+    assert->add_block("game_loop", [](corsac::Block* assert)
+    {
+        corsac::game_loop loop(milliseconds(1), milliseconds(2));
+        int frames = 0, updates = 0;
+        bool alphaInRange = true;
+        loop.run([&] { return frames < 10; },
+                 [&](corsac::game_loop::duration) { ++updates; },
+                 [&](double alpha) { ++frames; alphaInRange = alphaInRange && alpha >= 0.0 && alpha < 1.0; });
+
+        assert->equal("frames", frames, 10);
+        assert->is_true("updates follow real time", updates >= 14 && updates <= 40);
+        assert->is_true("alpha in [0, 1)", alphaInRange);
+    });
+    return true;
+}
+
+#endif //CORSAC_GAME_LOOP_TEST_H
@@ -0,0 +1,116 @@
+//
+// test/hash_test.h
+//
+// Created by Falldot on 18.10.2026.
+// Copyright (c) 2021 Corsac. All rights reserved.
+//
+#ifndef CORSAC_HASH_TEST_H
+#define CORSAC_HASH_TEST_H
+
+#include "Corsac/functional.h"
+
+#include <string.h>
+
+bool hash_test(corsac::Block* assert)
+{
+    assert->add_block("hash_bytes", [](corsac::Block* assert)
+    {
+        // Тестовые векторы wyhash final4: строка i хешируется с seed = i.
+        const char* messages[] = { "", "a", "abc", "message digest", "abcdefghijklmnopqrstuvwxyz",
+                                   "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789",
+                                   "12345678901234567890123456789012345678901234567890123456789012345678901234567890" };
+        const uint64_t expected[] = { 0x93228a4de0eec5a2ULL, 0xc5bac3db178713c4ULL, 0xa97f2f7b1d9b3314ULL, 0x786d1f1df3801df4ULL,
+                                      0xdca5a8138ad37c87ULL, 0xb9e734f117cfaf70ULL, 0x6cc5eab49a92d617ULL };
+        bool reference = true;
+        for(uint64_t i = 0; i < 7; ++i)
+            reference = reference && corsac::hash_bytes(messages[i], strlen(messages[i]), i) == expected[i];
+        assert->is_true("reference", reference);
+
+        // Все ветви длины (0, 1..3, 4..16, 17..47, 48+) и невыровненный адрес дают тот же результат.
+        uint8_t buffer[260], shifted[261];
+        for(size_t i = 0; i < sizeof(buffer); ++i)
+            buffer[i] = uint8_t(i * 31 + 7);
+        memcpy(shifted + 1, buffer, sizeof(buffer));
+        bool unaligned = true, distinct = true;
+        for(size_t len = 0; len <= sizeof(buffer); ++len)
+        {
+            const uint64_t h = corsac::hash_bytes(buffer, len);
+            unaligned = unaligned && h == corsac::hash_bytes(shifted + 1, len);
+            if(len > 0)
+                distinct = distinct && h != corsac::hash_bytes(buffer, len - 1);
+        }
+        assert->is_true("unaligned input", unaligned);
+        assert->is_true("length changes hash", distinct);
+
+        // Изменение одного бита меняет в среднем половину битов результата.
+        int flipped = 0, trials = 0;
+        for(size_t byte = 0; byte < 64; ++byte)
+        {
+            for(int bit = 0; bit < 8; ++bit, ++trials)
+            {
+                const uint64_t before = corsac::hash_bytes(buffer, 64);
+                buffer[byte] ^= uint8_t(1 << bit);
+                uint64_t diff = before ^ corsac::hash_bytes(buffer, 64);
+                buffer[byte] ^= uint8_t(1 << bit);
+                for(; diff; diff &= diff - 1)
+                    ++flipped;
+            }
+        }
+        const double average = double(flipped) / trials;
+        assert->is_true("avalanche", average > 30.0 && average < 34.0);
+        assert->is_true("seed", corsac::hash_bytes(buffer, 100, 1) != corsac::hash_bytes(buffer, 100, 2));
+    });
+    assert->add_block("mixed_hash", [](corsac::Block* assert)
+    {
+        // Выровненные указатели и последовательные идентификаторы раскладываются по 256 корзинам
+        // (младшие 8 бит хеша). hash<T> отдает их как есть и занимает лишь часть корзин.
+        // Адреса фиксированы: у настоящего массива база меняется от запуска к запуску (ASLR),
+        // и максимум корзины то укладывается в порог, то нет.
+        size_t identity[256] = {}, mixed[256] = {}, ids[256] = {};
+        for(size_t i = 0; i < 4096; ++i)
+        {
+            void* p = reinterpret_cast<void*>(uintptr_t(0x12340000) + i * 64);
+            ++identity[corsac::hash<void*>()(p) & 255];
+            ++mixed[corsac::mixed_hash<void*>()(p) & 255];
+            ++ids[corsac::mixed_hash<uint32_t>()(uint32_t(i * 256)) & 255];
+        }
+        size_t identityUsed = 0, mixedMax = 0, idsMax = 0;
+        for(size_t i = 0; i < 256; ++i)
+        {
+            identityUsed += identity[i] != 0;
+            mixedMax = mixed[i] > mixedMax ? mixed[i] : mixedMax;
+            idsMax   = ids[i] > idsMax ? ids[i] : idsMax;
+        }
+        assert->is_true("identity hash clusters aligned pointers", identityUsed <= 4);
+        assert->is_true("aligned pointers", mixedMax < 32);  // В среднем 16 на корзину.
+        assert->is_true("strided ids", idsMax < 32);
+
+        assert->is_true("same value same hash", corsac::mixed_hash<int>()(42) == corsac::mixed_hash<int>()(42));
+        assert->is_true("signed zero", corsac::mixed_hash<double>()(0.0) == corsac::mixed_hash<double>()(-0.0));
+        assert->is_true("float bits", corsac::mixed_hash<float>()(0.25f) != corsac::mixed_hash<float>()(0.5f));
+        assert->is_true("mix zero stays zero", corsac::hash_mix(0) == 0 && corsac::hash_mix(1) != 1);
+    });
+    assert->add_block("hash_combine", [](corsac::Block* assert)
+    {
+        size_t ab = 0, ba = 0;
+        corsac::hash_combine(ab, 1);
+        corsac::hash_combine(ab, 2);
+        corsac::hash_combine(ba, 2);
+        corsac::hash_combine(ba, 1);
+        assert->is_true("order matters", ab != ba);
+        assert->is_true("hash_values", corsac::hash_values(1, 2) == ab);
+        assert->is_true("zero fields", corsac::hash_values(0, 0) != corsac::hash_values(0) && corsac::hash_values(0) != 0);
+
+        // Составные ключи (x, y) сетки 64x64 без коллизий в младших 16 битах почти не совпадают.
+        static uint8_t seen[65536];
+        memset(seen, 0, sizeof(seen));
+        size_t collisions = 0;
+        for(uint32_t x = 0; x < 64; ++x)
+            for(uint32_t y = 0; y < 64; ++y)
+                collisions += seen[corsac::hash_values(x, y) & 0xFFFF]++ != 0;
+        assert->is_true("grid keys", collisions < 250); // Ожидается около 125 для случайных хешей.
+    });
+    return true;
+}
+
+#endif //CORSAC_HASH_TEST_H
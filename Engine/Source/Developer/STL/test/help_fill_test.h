@@ -0,0 +1,127 @@
+//
+// test/help_fill_test.h
+//
+// Created by Falldot on 18.10.2026.
+// Copyright (c) 2021 Corsac. All rights reserved.
+//
+#ifndef CORSAC_HELP_FILL_TEST_H
+#define CORSAC_HELP_FILL_TEST_H
+
+#include "Corsac/STL/help_memset.h"
+#include "Corsac/algorithm.h"
+
+#include <string.h>
+
+template <typename T>
+bool help_fill_check(const T& value)
+{
+    static const size_t sizes[] = { 0, 1, 2, 3, 7, 8, 9, 31, 33, 100, 1000, 100000 };
+    static T a[100000 + 4], b[100000 + 4];
+
+    bool ok = true;
+    for(size_t n : sizes)
+        for(size_t offset = 0; offset < 2; ++offset)
+        {
+            memset(a, 0, sizeof(a));
+            memset(b, 0, sizeof(b));
+            for(size_t i = 0; i < n; ++i)
+                b[offset + i] = value;
+
+            corsac::fill(a + offset, a + offset + n, value);
+            ok = ok && memcmp(a, b, sizeof(a)) == 0;
+
+            memset(a, 0, sizeof(a));
+            T* end = corsac::fill_n(a + offset, n, value);
+            ok = ok && end == a + offset + n && memcmp(a, b, sizeof(a)) == 0;
+        }
+    return ok;
+}
+
+// fast_fill_pattern<N> по байтовым смещениям: невременной путь берется только при d % N == 0,
+// остальные смещения идут через обычные записи. Длины лежат по обе стороны порога.
+template <size_t N>
+bool help_fill_pattern_check()
+{
+    using namespace corsac::internal;
+    static unsigned char a[20000], b[20000];
+
+    unsigned char value[N];
+    for(size_t i = 0; i < N; ++i)
+        value[i] = (unsigned char)(i * 37 + 1);
+
+    // Порог задан в main_test.cpp; буферы рассчитаны на порог не больше 4096 байт.
+    const size_t threshold = corsac::min<size_t>(get_fill_pattern_dispatch().nontemporalThreshold, 4096);
+    const size_t counts[] = { threshold / N - 1, threshold / N, threshold / N + 3, 12000 / N + 1 };
+
+    bool ok = true;
+    for(size_t count : counts)
+        for(size_t offset = 0; offset < 2 * N + 1; ++offset)
+        {
+            memset(a, 0, sizeof(a));
+            memset(b, 0, sizeof(b));
+            for(size_t i = 0; i < count; ++i)
+                memcpy(b + offset + i * N, value, N);
+
+            fast_fill_pattern<N>(a + offset, value, count);
+            ok = ok && memcmp(a, b, sizeof(a)) == 0;
+        }
+
+    // Невременные реализации напрямую: приемник выровнен на N, но не на 16 или 32 байта.
+    #if CORSAC_SIMD_X86
+        unsigned char pattern[16];
+        for(size_t i = 0; i < 16; i += N)
+            memcpy(pattern + i, value, N);
+
+        const cpu_info& cpu = get_cpu_info();
+        const fill_pattern_func funcs[] = { cpu.sse2 ? &fill_pattern_stream_sse2 : nullptr, cpu.avx ? &fill_pattern_stream_avx : nullptr };
+        for(fill_pattern_func func : funcs)
+        {
+            if(!func)
+                continue;
+            for(size_t count : { 128 / N, 128 / N + 1, 1000 / N + 3, 4099 / N })
+                for(size_t offset = 0; offset < 48; offset += N)
+                {
+                    memset(a, 0, sizeof(a));
+                    memset(b, 0, sizeof(b));
+                    for(size_t i = 0; i < count; ++i)
+                        memcpy(b + offset + i * N, value, N);
+
+                    func(a + offset, pattern, count * N);
+                    ok = ok && memcmp(a, b, sizeof(a)) == 0;
+                }
+        }
+    #endif
+    return ok;
+}
+
+bool help_fill_test(corsac::Block* assert)
+{
+    assert->add_block("can_fill_pattern", [](corsac::Block* assert)
+    {
+        struct V3 { float x, y, z; };
+        struct V4 { float x, y, z, w; };
+        assert->is_true("param is <uint32_t*, int>", corsac::can_fill_pattern<uint32_t*, int>::value);
+        assert->is_true("param is <V4*, V4>", corsac::can_fill_pattern<V4*, V4>::value);
+        assert->is_false("param is <V3*, V3>", corsac::can_fill_pattern<V3*, V3>::value);
+        assert->is_false("param is <const int*, int>", corsac::can_fill_pattern<const int*, int>::value);
+        assert->is_false("param is <char*, char>", corsac::can_fill_pattern<char*, char>::value);
+    });
+    assert->add_block("fill pattern", [](corsac::Block* assert)
+    {
+        struct V4 { float x, y, z, w; };
+        assert->is_true("param is uint16_t", help_fill_check<uint16_t>(0x1234));
+        assert->is_true("param is uint32_t", help_fill_check<uint32_t>(0xDEADBEEF));
+        assert->is_true("param is double", help_fill_check<double>(3.5));
+        assert->is_true("param is V4", help_fill_check<V4>(V4{ 1.0f, 2.0f, 3.0f, 4.0f }));
+    });
+    assert->add_block("fast_fill_pattern non-temporal", [](corsac::Block* assert)
+    {
+        assert->is_true("param is 2", help_fill_pattern_check<2>());
+        assert->is_true("param is 4", help_fill_pattern_check<4>());
+        assert->is_true("param is 8", help_fill_pattern_check<8>());
+        assert->is_true("param is 16", help_fill_pattern_check<16>());
+    });
+    return true;
+}
+
+#endif //CORSAC_HELP_FILL_TEST_H
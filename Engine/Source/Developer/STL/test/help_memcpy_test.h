@@ -0,0 +1,120 @@
+//
+// test/help_memcpy_test.h
+//
+// Created by Falldot on 18.10.2026.
+// Copyright (c) 2021 Corsac. All rights reserved.
+//
+#ifndef CORSAC_HELP_MEMCPY_TEST_H
+#define CORSAC_HELP_MEMCPY_TEST_H
+
+#include "Corsac/STL/help_memcpy.h"
+#include "Corsac/algorithm.h"
+
+#include <string.h>
+
+bool help_memcpy_test(corsac::Block* assert)
+{
+    // Размеры покрывают все классы: встроенный, средний SIMD и невременной (порог в main_test.cpp).
+    static const size_t sizes[] = { 0, 1, 2, 3, 7, 8, 15, 16, 17, 31, 32, 33, 64, 127, 128, 129, 1000, 4099, 65536 + 3 };
+
+    assert->add_block("fast_memcpy", [](corsac::Block* assert)
+    {
+        static unsigned char src[65536 + 64], dst[65536 + 64], ref[65536 + 64];
+        for(size_t i = 0; i < sizeof(src); ++i)
+            src[i] = (unsigned char)(i * 7 + 3);
+
+        bool ok = true;
+        for(size_t n : sizes)
+            for(size_t offset = 0; offset < 3; ++offset)
+            {
+                memset(dst, 0, sizeof(dst));
+                memset(ref, 0, sizeof(ref));
+                corsac::internal::fast_memcpy(dst + offset, src + 1, n);
+                memcpy(ref + offset, src + 1, n);
+                ok = ok && memcmp(dst, ref, sizeof(dst)) == 0;
+            }
+        assert->is_true("all size classes and offsets", ok);
+    });
+    assert->add_block("memcpy_stream", [](corsac::Block* assert)
+    {
+        using namespace corsac::internal;
+        // Невременные реализации напрямую: невыровненный приемник и хвосты любой длины.
+        static const size_t streamSizes[] = { 128, 129, 143, 191, 255, 256, 1000, 4099, 65536 + 3 };
+        static unsigned char src[65536 + 64], dst[65536 + 64], ref[65536 + 64];
+        for(size_t i = 0; i < sizeof(src); ++i)
+            src[i] = (unsigned char)(i * 7 + 3);
+
+        bool ok = true;
+        #if CORSAC_SIMD_X86
+            const cpu_info& cpu = get_cpu_info();
+            const memcpy_func funcs[] = { cpu.sse2 ? &memcpy_stream_sse2 : nullptr, cpu.avx ? &memcpy_stream_avx : nullptr };
+            for(memcpy_func func : funcs)
+            {
+                if(!func)
+                    continue;
+                for(size_t n : streamSizes)
+                    for(size_t offset : { 0, 1, 15, 17, 31 })
+                    {
+                        memset(dst, 0, sizeof(dst));
+                        memset(ref, 0, sizeof(ref));
+                        func(dst + offset, src + 1, n);
+                        memcpy(ref + offset, src + 1, n);
+                        ok = ok && memcmp(dst, ref, sizeof(dst)) == 0;
+                    }
+            }
+        #endif
+        assert->is_true("unaligned destination and odd tails", ok);
+
+        // Через диспетчер: копия больше порога уходит в невременную реализацию, приемник не выровнен.
+        const size_t threshold = get_memcpy_dispatch().nontemporalThreshold;
+        if(threshold != size_t(-1))
+        {
+            const size_t n = threshold + 131;
+            unsigned char* from = new unsigned char[n + 1];
+            unsigned char* to = new unsigned char[n + 8];
+            for(size_t i = 0; i < n + 1; ++i)
+                from[i] = (unsigned char)(i * 11 + 5);
+            memset(to, 0, n + 8);
+            fast_memcpy(to + 5, from + 1, n);
+            assert->is_true("above threshold", memcmp(to + 5, from + 1, n) == 0 && to[4] == 0 && to[n + 5] == 0);
+            delete[] from;
+            delete[] to;
+        }
+    });
+    assert->add_block("fast_memmove", [](corsac::Block* assert)
+    {
+        static unsigned char a[65536 + 64], b[65536 + 64];
+
+        bool ok = true;
+        for(size_t n : sizes)
+            for(size_t shift = 1; shift < 40; shift += 19)
+            {
+                for(size_t i = 0; i < sizeof(a); ++i)
+                    a[i] = b[i] = (unsigned char)(i * 13 + 1);
+                corsac::internal::fast_memmove(a + shift, a, n);
+                memmove(b + shift, b, n);
+                ok = ok && memcmp(a, b, sizeof(a)) == 0;
+
+                corsac::internal::fast_memmove(a, a + shift, n);
+                memmove(b, b + shift, n);
+                ok = ok && memcmp(a, b, sizeof(a)) == 0;
+            }
+        assert->is_true("overlapping ranges in both directions", ok);
+    });
+    assert->add_block("copy", [](corsac::Block* assert)
+    {
+        int src[100], dst[100];
+        for(int i = 0; i < 100; ++i)
+            src[i] = i;
+        int* end = corsac::copy(src, src + 100, dst);
+        assert->is_true("returns end of result", end == dst + 100);
+        assert->equal("last element", dst[99], 99);
+
+        corsac::copy_backward(src, src + 90, src + 100);
+        assert->equal("copy_backward overlapping", src[99], 89);
+        assert->equal("copy_backward overlapping first", src[10], 0);
+    });
+    return true;
+}
+
+#endif //CORSAC_HELP_MEMCPY_TEST_H
@@ -6,16 +6,66 @@
 //#define CORSAC_TEST_RESULT_OFF
 #define TEST_ENABLE
 
+// Малые пороги, чтобы копии и заполнения из тестов памяти проходили через невременные реализации.
+#define CORSAC_MEMCPY_NONTEMPORAL_THRESHOLD 4096
+#define CORSAC_MEMSET_NONTEMPORAL_THRESHOLD 4096
+
 #include "Test.h"
 
-void* __cdecl operator new[](size_t size, const char* name, int flags, unsigned debugFlags, const char* file, int line)
+#include <cstddef>
+#include <new>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Массивы выделяются через malloc с запасом под выравнивание; адрес исходного блока хранится
+// перед выданным указателем. allocator::deallocate освобождает любой блок через delete[],
+// поэтому обычные и выровненные выделения проходят через одну пару new[]/delete[].
+static void* AllocateArray(size_t size, size_t alignment, size_t alignmentOffset)
+{
+    if (alignment < alignof(std::max_align_t))
+        alignment = alignof(std::max_align_t);
+    alignmentOffset &= alignment - 1;
+
+    void* raw = malloc(size + alignment + alignmentOffset + sizeof(void*));
+    if (!raw)
+        throw std::bad_alloc();
+
+    // Как в allocate_memory: выровнен адрес result - alignmentOffset.
+    const uintptr_t base = ((uintptr_t)raw + sizeof(void*) + alignment - 1) & ~(uintptr_t)(alignment - 1);
+    uint8_t* result = (uint8_t*)(base + alignmentOffset);
+    memcpy(result - sizeof(void*), &raw, sizeof(void*));
+    return result;
+}
+
+void* operator new[](size_t size)
+{
+    return AllocateArray(size, 0, 0);
+}
+
+void operator delete[](void* p) noexcept
 {
-    return new uint8_t[size];
+    if (p)
+    {
+        void* raw;
+        memcpy(&raw, (uint8_t*)p - sizeof(void*), sizeof(void*));
+        free(raw);
+    }
 }
 
-void* __cdecl operator new[](size_t size, size_t alignment, size_t alignmentOffset, const char* pName, int flags, unsigned debugFlags, const char* file, int line)
+void operator delete[](void* p, size_t) noexcept
 {
-    return new uint8_t[size];
+    operator delete[](p);
+}
+
+void* operator new[](size_t size, const char* name, int flags, unsigned debugFlags, const char* file, int line)
+{
+    return AllocateArray(size, 0, 0);
+}
+
+void* operator new[](size_t size, size_t alignment, size_t alignmentOffset, const char* pName, int flags, unsigned debugFlags, const char* file, int line)
+{
+    return AllocateArray(size, alignment, alignmentOffset);
 }
 
 #include "type_traits_test.h"
@@ -25,6 +75,21 @@ void* __cdecl operator new[](size_t size, size_t alignment, size_t alignmentOffs
 #include "type_pod_test.h"
 #include "type_compound_test.h"
 #include "vector_test.h"
+#include "help_memcpy_test.h"
+#include "help_fill_test.h"
+#include "fixed_pool_test.h"
+#include "chrono_test.h"
+#include "profiler_test.h"
+#include "game_loop_test.h"
+#include "random_test.h"
+#include "hash_test.h"
+#include "string_id_test.h"
+#include "function_test.h"
+#include "tuple_vector_test.h"
+#include "slot_map_test.h"
+#include "entity_test.h"
+#include "world_test.h"
+#include "transform_hierarchy_test.h"
 
 
 #include "Corsac/unique_ptr.h"
@@ -49,13 +114,69 @@ int main()
         assert->add_block("type_properties_test", [](corsac::Block *assert) {
             type_properties_test(assert);
         });
-        assert->add_block("type_properties_test", [](corsac::Block *assert) {
+        assert->add_block("type_pod_test", [](corsac::Block *assert) {
             type_pod_test(assert);
         });
         assert->add_block("vector_test", [](corsac::Block *assert) {
             vector_test(assert);
         });
     });
-    assert->start();
-    return 0;
+
+    assert->add_block("containers", [](corsac::Block *assert) {
+        assert->add_block("tuple_vector_test", [](corsac::Block *assert) {
+            tuple_vector_test(assert);
+        });
+        assert->add_block("slot_map_test", [](corsac::Block *assert) {
+            slot_map_test(assert);
+        });
+        assert->add_block("entity_test", [](corsac::Block *assert) {
+            entity_test(assert);
+        });
+        assert->add_block("world_test", [](corsac::Block *assert) {
+            world_test(assert);
+        });
+        assert->add_block("transform_hierarchy_test", [](corsac::Block *assert) {
+            transform_hierarchy_test(assert);
+        });
+    });
+
+    assert->add_block("memory", [](corsac::Block *assert) {
+        assert->add_block("help_memcpy_test", [](corsac::Block *assert) {
+            help_memcpy_test(assert);
+        });
+        assert->add_block("help_fill_test", [](corsac::Block *assert) {
+            help_fill_test(assert);
+        });
+        assert->add_block("fixed_pool_test", [](corsac::Block *assert) {
+            fixed_pool_test(assert);
+        });
+    });
+    assert->add_block("time", [](corsac::Block *assert) {
+        assert->add_block("chrono_test", [](corsac::Block *assert) {
+            chrono_test(assert);
+        });
+        assert->add_block("profiler_test", [](corsac::Block *assert) {
+            profiler_test(assert);
+        });
+        assert->add_block("game_loop_test", [](corsac::Block *assert) {
+            game_loop_test(assert);
+        });
+    });
+    assert->add_block("random", [](corsac::Block *assert) {
+        assert->add_block("random_test", [](corsac::Block *assert) {
+            random_test(assert);
+        });
+    });
+    assert->add_block("functional", [](corsac::Block *assert) {
+        assert->add_block("hash_test", [](corsac::Block *assert) {
+            hash_test(assert);
+        });
+        assert->add_block("string_id_test", [](corsac::Block *assert) {
+            string_id_test(assert);
+        });
+        assert->add_block("function_test", [](corsac::Block *assert) {
+            function_test(assert);
+        });
+    });
+    return assert->start();
 }
@@ -0,0 +1,155 @@
+//
+// test/profiler_test.h
+//
+// Created by Falldot on 18.10.2026.
+// Copyright (c) 2021 Corsac. All rights reserved.
+//
+#ifndef CORSAC_PROFILER_TEST_H
+#define CORSAC_PROFILER_TEST_H
+
+#include "Corsac/profiler.h"
+
+#include <atomic>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <thread>
+
+inline size_t profiler_test_count(const corsac::profile_thread_buffer* buffer, const char* name)
+{
+    size_t count = 0;
+    for(size_t i = 0; i < buffer->size(); ++i)
+        count += strcmp((*buffer)[i].name, name) == 0;
+    return count;
+}
+
+bool profiler_test(corsac::Block* assert)
+{
+    assert->add_block("profile_zone", [](corsac::Block* assert)
+    {
+        corsac::profiler& profiler = corsac::profiler::get();
+        profiler.clear();
+        {
+            CORSAC_PROFILE_SCOPE("outer");
+            CORSAC_PROFILE_SCOPE("inner");
+        }
+        CORSAC_PROFILE_FRAME("frame");
+
+        const corsac::profile_thread_buffer* buffer = profiler.thread_buffer();
+        assert->equal("size", buffer->size(), (size_t)3);
+        assert->equal("inner closes first", buffer->size() == 3 ? (*buffer)[0].name : "", "inner");
+        assert->is_true("outer contains inner", buffer->size() == 3 &&
+                        (*buffer)[1].begin <= (*buffer)[0].begin && (*buffer)[0].end <= (*buffer)[1].end);
+        assert->is_true("frame mark", buffer->size() == 3 && (*buffer)[2].type == corsac::profile_event_type::frame);
+
+        profiler.set_enabled(false);
+        {
+            CORSAC_PROFILE_SCOPE("disabled");
+        }
+        profiler.set_enabled(true);
+        assert->equal("disabled zone is not recorded", buffer->size(), (size_t)3);
+
+        profiler.clear();
+        {
+            CORSAC_PROFILE_SCOPE("after clear");
+        }
+        assert->equal("clear", buffer->size(), (size_t)1);
+    });
+    assert->add_block("threads", [](corsac::Block* assert)
+    {
+        corsac::profiler& profiler = corsac::profiler::get();
+        profiler.clear();
+
+        std::thread worker([]
+        {
+            CORSAC_PROFILE_THREAD("worker");
+            for(int i = 0; i < 100; ++i)
+            {
+                CORSAC_PROFILE_SCOPE("job");
+            }
+        });
+        worker.join();
+
+        size_t buffers = 0, jobs = 0;
+        const corsac::profile_thread_buffer* workerBuffer = nullptr;
+        for(const corsac::profile_thread_buffer* buffer = profiler.first_buffer(); buffer; buffer = buffer->next)
+        {
+            ++buffers;
+            if(profiler_test_count(buffer, "job"))
+                workerBuffer = buffer;
+            jobs += profiler_test_count(buffer, "job");
+        }
+        assert->is_true("separate buffer per thread", buffers >= 2);
+        assert->equal("jobs", jobs, (size_t)100);
+        assert->equal("thread name", workerBuffer ? workerBuffer->thread_name() : "", "worker");
+    });
+    assert->add_block("read during clear", [](corsac::Block* assert)
+    {
+        // Владелец пишет без остановки, читатель копирует события и очищает профилировщик:
+        // после clear() владелец перезаписывает те же слоты, пока читатель их копирует.
+        corsac::profiler& profiler = corsac::profiler::get();
+        profiler.clear();
+
+        std::atomic<const corsac::profile_thread_buffer*> shared{nullptr};
+        std::atomic<bool> stop{false};
+        std::thread worker([&profiler, &shared, &stop]
+        {
+            shared.store(profiler.thread_buffer(), std::memory_order_release);
+            while(!stop.load(std::memory_order_relaxed))
+            {
+                CORSAC_PROFILE_SCOPE("job");
+            }
+        });
+
+        const corsac::profile_thread_buffer* buffer;
+        while(!(buffer = shared.load(std::memory_order_acquire)))
+            std::this_thread::yield();
+
+        bool valid = true;
+        size_t read = 0;
+        for(int round = 0; round < 200; ++round)
+        {
+            const uint64_t state = buffer->state();
+            corsac::profile_event event;
+            for(size_t i = 0; i < (uint32_t)state && buffer->read_event(i, (uint32_t)(state >> 32), event); ++i, ++read)
+                valid = valid && strcmp(event.name, "job") == 0 && event.begin <= event.end;
+            profiler.clear();
+            std::this_thread::yield();
+        }
+        stop.store(true, std::memory_order_relaxed);
+        worker.join();
+
+        assert->is_true("copied events are whole", valid && read > 0);
+    });
+    assert->add_block("chrome trace", [](corsac::Block* assert)
+    {
+        corsac::profiler& profiler = corsac::profiler::get();
+        profiler.clear();
+        {
+            CORSAC_PROFILE_SCOPE("quoted \"zone\"");
+        }
+
+        FILE* file = tmpfile();
+        const bool written = profiler.write_chrome_trace(file);
+        std::string json;
+        if(file)
+        {
+            rewind(file);
+            char chunk[256];
+            size_t n;
+            while((n = fread(chunk, 1, sizeof(chunk), file)) > 0)
+                json.append(chunk, n);
+            fclose(file);
+        }
+
+        assert->is_true("written", written);
+        assert->is_true("trace events", json.find("{\"traceEvents\":[") == 0);
+        assert->is_true("complete event", json.find("\"ph\":\"X\"") != std::string::npos);
+        assert->is_true("escaped name", json.find("\"quoted \\\"zone\\\"\"") != std::string::npos);
+        assert->is_true("thread metadata", json.find("\"thread_name\"") != std::string::npos);
+        assert->is_true("calibrated", profiler.ns_per_tick() > 0.0 && profiler.ns_per_tick() < 100.0);
+    });
+    return true;
+}
+
+#endif //CORSAC_PROFILER_TEST_H
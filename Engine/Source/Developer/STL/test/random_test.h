@@ -0,0 +1,356 @@
+//
+// test/random_test.h
+//
+// Created by Falldot on 18.10.2026.
+// Copyright (c) 2021 Corsac. All rights reserved.
+//
+#ifndef CORSAC_RANDOM_TEST_H
+#define CORSAC_RANDOM_TEST_H
+
+#include "Corsac/random.h"
+#include "Corsac/algorithm.h"
+
+#include <math.h>
+#include <iterator>
+#include <sstream>
+
+bool random_test(corsac::Block* assert)
+{
+    // Эталонные значения взяты из реализаций авторов генераторов.
+    assert->add_block("splitmix64", [](corsac::Block* assert)
+    {
+        corsac::splitmix64 rng(1234567);
+        assert->is_true("reference", rng() == 6457827717110365317ULL && rng() == 3203168211198807973ULL && rng() == 9817491932198370423ULL);
+
+        corsac::splitmix64 a(1), b(1);
+        a.discard(5);
+        for(int i = 0; i < 5; ++i)
+            b();
+        assert->is_true("discard", a == b);
+    });
+    assert->add_block("xoshiro256starstar", [](corsac::Block* assert)
+    {
+        corsac::xoshiro256starstar rng(1, 2, 3, 4);
+        assert->is_true("reference", rng() == 11520ULL && rng() == 0ULL && rng() == 1509978240ULL && rng() == 1215971899390074240ULL);
+
+        corsac::xoshiro256starstar seeded(42);
+        assert->is_true("seed through splitmix64", seeded() == 1546998764402558742ULL && seeded() == 6990951692964543102ULL);
+
+        corsac::xoshiro256starstar jumped(1, 2, 3, 4);
+        jumped.jump();
+        assert->is_true("jump", jumped() == 13534147089533256664ULL && jumped() == 7126240192422241655ULL);
+
+        corsac::xoshiro256starstar longJumped(1, 2, 3, 4);
+        longJumped.long_jump();
+        assert->is_true("long_jump", longJumped() == 5942309088398569549ULL && longJumped() == 15625447729937358436ULL);
+
+        corsac::xoshiro256starstar a(7), b(7);
+        b.jump();
+        assert->is_true("jumped copy differs", a != b);
+        assert->is_true("is default_random_engine", corsac::is_same<corsac::default_random_engine, corsac::xoshiro256starstar>::value);
+    });
+    assert->add_block("pcg32", [](corsac::Block* assert)
+    {
+        corsac::pcg32 rng(42, 54);
+        const uint32_t expected[] = { 0xa15c02b7, 0x7b47f409, 0xba1d3330, 0x83d2f293, 0xbfa4784b, 0xcbed606e };
+        bool ok = true;
+        for(uint32_t e : expected)
+            ok = ok && rng() == e;
+        assert->is_true("reference", ok);
+
+        corsac::pcg32 a(42, 54), b(42, 54);
+        a.advance(1000);
+        for(int i = 0; i < 1000; ++i)
+            b();
+        assert->is_true("advance", a == b);
+        assert->is_true("streams differ", corsac::pcg32(42, 1)() != corsac::pcg32(42, 2)());
+    });
+    assert->add_block("uniform_int_distribution", [](corsac::Block* assert)
+    {
+        corsac::xoshiro256starstar rng;
+        corsac::uniform_int_distribution<uint32_t> dice(1, 6);
+        uint32_t counts[7] = {};
+        for(int i = 0; i < 60000; ++i)
+            ++counts[dice(rng)];
+
+        bool uniform = counts[0] == 0;
+        for(int i = 1; i <= 6; ++i)
+            uniform = uniform && counts[i] > 9000 && counts[i] < 11000;
+        assert->is_true("with xoshiro256starstar", uniform);
+
+        corsac::pcg32 pcg;
+        corsac::uniform_int_distribution<uint8_t> bytes(10, 20);
+        bool inRange = true;
+        for(int i = 0; i < 1000; ++i)
+        {
+            const uint8_t v = bytes(pcg);
+            inRange = inRange && v >= 10 && v <= 20;
+        }
+        assert->is_true("with pcg32", inRange);
+    });
+    assert->add_block("bounded integers", [](corsac::Block* assert)
+    {
+        corsac::pcg32 rng(7);
+
+        corsac::uniform_int_distribution<int> signedDist(-5, 5);
+        bool seen[11] = {};
+        bool inRange = true;
+        for(int i = 0; i < 10000; ++i)
+        {
+            const int v = signedDist(rng);
+            inRange = inRange && v >= -5 && v <= 5;
+            if(v >= -5 && v <= 5)
+                seen[v + 5] = true;
+        }
+        bool all = true;
+        for(bool b : seen)
+            all = all && b;
+        assert->is_true("signed range", inRange && all);
+
+        corsac::uniform_int_distribution<uint64_t> wide(1000, 1000000000000ULL);
+        bool wideInRange = true;
+        for(int i = 0; i < 10000; ++i)
+        {
+            const uint64_t v = wide(rng);
+            wideInRange = wideInRange && v >= 1000 && v <= 1000000000000ULL;
+        }
+        assert->is_true("uint64 range from 32-bit generator", wideInRange);
+
+        corsac::uniform_int_distribution<int64_t> full(corsac::numeric_limits<int64_t>::min(), corsac::numeric_limits<int64_t>::max());
+        bool negative = false, positive = false;
+        for(int i = 0; i < 100; ++i)
+        {
+            const int64_t v = full(rng);
+            negative = negative || v < 0;
+            positive = positive || v > 0;
+        }
+        assert->is_true("full int64 range", negative && positive);
+
+        int values[100];
+        for(int i = 0; i < 100; ++i)
+            values[i] = i;
+        corsac::xoshiro256starstar shuffleRng(3);
+        corsac::shuffle(values, values + 100, shuffleRng);
+        int sum = 0, moved = 0;
+        for(int i = 0; i < 100; ++i)
+        {
+            sum += values[i];
+            moved += values[i] != i;
+        }
+        assert->is_true("shuffle with size_t distribution", sum == 4950 && moved > 50);
+    });
+    assert->add_block("generate", [](corsac::Block* assert)
+    {
+        corsac::xoshiro256starstar a(5), b(5);
+        corsac::uniform_int_distribution<uint32_t> dist(0, 99);
+        uint32_t bulk[1000], single[1000];
+        corsac::generate(bulk, bulk + 1000, a, dist);
+        for(uint32_t& v : single)
+            v = dist(b);
+        assert->is_true("bulk equals per-call", memcmp(bulk, single, sizeof(bulk)) == 0);
+        assert->is_true("has bulk generate", corsac::internal::has_bulk_generate<decltype(dist), uint32_t*, corsac::xoshiro256starstar>::value);
+
+        bool unitFloat = true, unitDouble = true;
+        for(int i = 0; i < 10000; ++i)
+        {
+            const float f = corsac::generate_canonical<float>(a);
+            const double d = corsac::generate_canonical<double>(a);
+            unitFloat = unitFloat && f >= 0.0f && f < 1.0f;
+            unitDouble = unitDouble && d >= 0.0 && d < 1.0;
+        }
+        assert->is_true("generate_canonical<float>", unitFloat);
+        assert->is_true("generate_canonical<double>", unitDouble);
+        assert->equal("bits_to_unit_float(0)", corsac::internal::bits_to_unit_float(0), 0.0f);
+        assert->is_true("bits_to_unit_double(~0) < 1", corsac::internal::bits_to_unit_double(~uint64_t(0)) < 1.0);
+    });
+    assert->add_block("xoshiro256starstar_x4", [](corsac::Block* assert)
+    {
+        corsac::xoshiro256starstar lanes[4] = { corsac::xoshiro256starstar(9), corsac::xoshiro256starstar(9), corsac::xoshiro256starstar(9), corsac::xoshiro256starstar(9) };
+        for(int j = 1; j < 4; ++j)
+            for(int k = 0; k < j; ++k)
+                lanes[j].jump();
+
+        corsac::xoshiro256starstar_x4 rng(9);
+        bool interleaved = true;
+        for(int k = 0; k < 8; ++k)
+            for(int j = 0; j < 4; ++j)
+                interleaved = interleaved && rng() == lanes[j]();
+        assert->is_true("lanes are jumped streams", interleaved);
+
+        corsac::xoshiro256starstar_x4 a(11), b(11);
+        uint64_t bulk[1003];
+        a();
+        a.generate(bulk, bulk + 1003);
+        b();
+        bool same = true;
+        for(uint64_t v : bulk)
+            same = same && v == b();
+        assert->is_true("generate continues operator()", same && a() == b());
+
+        corsac::xoshiro256starstar_x4 c(13), d(13);
+        float floats[203];
+        c.generate_canonical(floats, floats + 203);
+        bool floatsOk = true;
+        for(size_t i = 0; i < 203; i += 2)
+        {
+            const uint64_t bits = d();
+            floatsOk = floatsOk && floats[i] == corsac::internal::bits_to_unit_float(uint32_t(bits));
+            if(i + 1 < 203)
+                floatsOk = floatsOk && floats[i + 1] == corsac::internal::bits_to_unit_float(uint32_t(bits >> 32));
+        }
+        assert->is_true("generate_canonical float", floatsOk);
+
+        corsac::xoshiro256starstar_x4 e(17), f(17);
+        double doubles[101];
+        e.generate_canonical(doubles, doubles + 101);
+        bool doublesOk = true;
+        for(double v : doubles)
+            doublesOk = doublesOk && v == corsac::internal::bits_to_unit_double(f());
+        assert->is_true("generate_canonical double", doublesOk);
+    });
+    assert->add_block("uniform_real_distribution", [](corsac::Block* assert)
+    {
+        corsac::xoshiro256starstar rng(21);
+        corsac::uniform_real_distribution<double> dist(-2.0, 3.0);
+        bool inRange = true;
+        double sum = 0.0;
+        for(int i = 0; i < 100000; ++i)
+        {
+            const double v = dist(rng);
+            inRange = inRange && v >= -2.0 && v < 3.0;
+            sum += v;
+        }
+        assert->is_true("range", inRange);
+        assert->is_true("mean", fabs(sum / 100000 - 0.5) < 0.02);
+
+        corsac::xoshiro256starstar_x4 rng4(21);
+        corsac::uniform_real_distribution<float> spread(10.0f, 20.0f);
+        float values[1001];
+        corsac::generate(values, values + 1001, rng4, spread);
+        bool bulkInRange = true;
+        for(float v : values)
+            bulkInRange = bulkInRange && v >= 10.0f && v <= 20.0f;
+        assert->is_true("bulk with xoshiro256starstar_x4", bulkInRange);
+
+        corsac::uniform_real_distribution<double> copy(dist.param());
+        assert->is_true("param_type", copy == dist && copy.a() == -2.0 && copy.b() == 3.0);
+    });
+    assert->add_block("normal_distribution", [](corsac::Block* assert)
+    {
+        const auto& table = corsac::internal::ziggurat_normal_table::get();
+        assert->is_true("ziggurat table", table.x[1] == corsac::internal::ziggurat_normal_table::R &&
+                        table.x[127] > 0.0 && table.x[127] < 0.3 && table.ratio[127] == 0.0);
+
+        corsac::xoshiro256starstar rng(8);
+        corsac::normal_distribution<double> dist(5.0, 2.0);
+        const int n = 200000;
+        double sum = 0.0, sumSq = 0.0;
+        int beyond3 = 0, beyondR = 0;
+        for(int i = 0; i < n; ++i)
+        {
+            const double v = dist(rng);
+            sum   += v;
+            sumSq += v * v;
+            const double z = fabs(v - 5.0) / 2.0;
+            beyond3 += z > 3.0;
+            beyondR += z > corsac::internal::ziggurat_normal_table::R;
+        }
+        const double mean     = sum / n;
+        const double variance = sumSq / n - mean * mean;
+        assert->is_true("mean", fabs(mean - 5.0) < 0.02);
+        assert->is_true("variance", fabs(variance - 4.0) < 0.08);
+        // P(|z| > 3) = 0.0027, P(|z| > R) = 0.00058: хвост генерируется отдельной веткой.
+        assert->is_true("tail beyond 3 sigma", beyond3 > 400 && beyond3 < 680);
+        assert->is_true("tail beyond R", beyondR > 60 && beyondR < 180);
+
+        corsac::normal_distribution<float> floats;
+        float values[256];
+        corsac::generate(values, values + 256, rng, floats);
+        bool finite = true;
+        for(float v : values)
+            finite = finite && fabs(v) < 10.0f;
+        assert->is_true("float generate", finite);
+        assert->is_true("param_type", corsac::normal_distribution<double>(dist.param()) == dist && dist.stddev() == 2.0);
+    });
+    assert->add_block("bernoulli_distribution", [](corsac::Block* assert)
+    {
+        corsac::pcg32 rng(3);
+        corsac::bernoulli_distribution coin(0.3);
+        int hits = 0;
+        for(int i = 0; i < 100000; ++i)
+            hits += coin(rng);
+        assert->is_true("frequency", hits > 29300 && hits < 30700);
+
+        corsac::bernoulli_distribution never(0.0), always(1.0);
+        bool edges = true;
+        for(int i = 0; i < 1000; ++i)
+            edges = edges && !never(rng) && always(rng);
+        assert->is_true("p = 0 and p = 1", edges);
+
+        bool flags[1000];
+        corsac::generate(flags, flags + 1000, rng, coin);
+        int bulkHits = 0;
+        for(bool f : flags)
+            bulkHits += f;
+        assert->is_true("generate", bulkHits > 220 && bulkHits < 380);
+        assert->is_true("param_type", corsac::bernoulli_distribution(coin.param()) == coin && coin != never);
+    });
+    assert->add_block("discrete_distribution", [](corsac::Block* assert)
+    {
+        corsac::xoshiro256starstar rng(99);
+        corsac::discrete_distribution<int> loot({ 70.0, 25.0, 4.5, 0.5, 0.0 });
+        assert->is_true("probabilities", loot.size() == 5 && fabs(loot.probabilities()[0] - 0.7) < 1e-12 &&
+                        loot.probabilities()[4] == 0.0 && loot.min() == 0 && loot.max() == 4);
+
+        const int n = 200000;
+        int counts[5] = {};
+        for(int i = 0; i < n; ++i)
+            ++counts[loot(rng)];
+        const double expected[5] = { 0.7, 0.25, 0.045, 0.005, 0.0 };
+        bool frequencies = counts[4] == 0;
+        for(int i = 0; i < 4; ++i)
+            frequencies = frequencies && fabs(double(counts[i]) / n - expected[i]) < 0.005;
+        assert->is_true("frequencies", frequencies);
+
+        // Большая таблица: вес i пропорционален i + 1.
+        const size_t size = 1000;
+        uint32_t* weights = new uint32_t[size];
+        for(size_t i = 0; i < size; ++i)
+            weights[i] = uint32_t(i + 1);
+        corsac::discrete_distribution<uint32_t> large(weights, weights + size);
+        delete[] weights;
+        uint32_t samples[4096];
+        corsac::generate(samples, samples + 4096, rng, large);
+        double sum = 0.0;
+        bool inRange = true;
+        for(uint32_t v : samples)
+        {
+            inRange = inRange && v < size;
+            sum += v;
+        }
+        // Среднее (sum i * (i + 1)) / (sum (i + 1)) = 666.
+        assert->is_true("large table", inRange && fabs(sum / 4096 - 666.0) < 15.0);
+
+        corsac::discrete_distribution<int> empty;
+        assert->is_true("empty weights", empty.size() == 1 && empty(rng) == 0);
+
+        corsac::discrete_distribution<int>::param_type params = loot.param();
+        corsac::discrete_distribution<int> copy(params);
+        copy.param(params);
+        assert->is_true("param_type", copy == loot && copy != empty);
+
+        // Однопроходный итератор читается один раз.
+        std::istringstream stream("1 0 3");
+        corsac::discrete_distribution<int> streamed{ std::istream_iterator<double>(stream), std::istream_iterator<double>() };
+        assert->is_true("input iterator", streamed.size() == 3 && streamed.probabilities()[2] == 0.75);
+
+        // Перемещенный объект остается таблицей из одного исхода.
+        corsac::discrete_distribution<int> moved(corsac::move(copy));
+        assert->is_true("moved", moved == loot && copy.size() == 1 && copy(rng) == 0 && copy == empty);
+        copy = corsac::move(moved);
+        assert->is_true("move assignment", copy == loot && moved.size() == 1 && moved(rng) == 0);
+    });
+    return true;
+}
+
+#endif //CORSAC_RANDOM_TEST_H
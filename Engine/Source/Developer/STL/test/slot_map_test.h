@@ -0,0 +1,67 @@
+//
+// test/slot_map_test.h
+//
+// Created by Falldot on 18.10.2026.
+// Copyright (c) 2021 Corsac. All rights reserved.
+//
+#ifndef CORSAC_SLOT_MAP_TEST_H
+#define CORSAC_SLOT_MAP_TEST_H
+
+#include "Corsac/slot_map.h"
+#include "Corsac/unique_ptr.h"
+
+bool slot_map_test(corsac::Block* assert)
+{
+    assert->add_block("slot_map", [](corsac::Block* assert)
+    {
+        corsac::slot_map<int> map;
+        assert->is_true("empty", map.empty() && !map.contains(corsac::slot_map_key()));
+
+        corsac::slot_map_key keys[5];
+        for(int i = 0; i < 5; ++i)
+            keys[i] = map.insert(i * 10);
+        assert->equal("size", map.size(), 5u);
+        assert->is_true("lookup", map[keys[3]] == 30 && *map.find(keys[4]) == 40);
+
+        // Удаление переставляет последний элемент, но ключи остальных остаются действительными.
+        assert->is_true("erase", map.erase(keys[1]));
+        assert->is_true("erased key is stale", !map.contains(keys[1]) && map.find(keys[1]) == nullptr && !map.erase(keys[1]));
+        assert->is_true("other keys survive", map[keys[0]] == 0 && map[keys[2]] == 20 && map[keys[3]] == 30 && map[keys[4]] == 40);
+        assert->equal("dense", map.data()[1], 40);
+        const corsac::slot_map_key freeSlot(keys[1].index, keys[1].generation + 1);
+        assert->is_true("key of a free slot", !map.contains(freeSlot) && map.find(freeSlot) == nullptr);
+
+        // Слот переиспользуется, старый ключ его не видит.
+        const corsac::slot_map_key reused = map.emplace(99);
+        assert->is_true("free list reuse", reused.index == keys[1].index && reused.generation != keys[1].generation);
+        assert->is_true("stale key after reuse", !map.contains(keys[1]) && map[reused] == 99);
+        assert->equal("no new slot", map.slot_count(), 5u);
+
+        int sum = 0;
+        for(int value : map)
+            sum += value;
+        assert->equal("dense iteration", sum, 0 + 20 + 30 + 40 + 99);
+
+        bool keysMatch = true;
+        for(uint32_t n = 0; n < map.size(); ++n)
+            keysMatch = keysMatch && map.find(map.key_at(n)) == map.data() + n;
+        assert->is_true("key_at", keysMatch);
+        assert->is_true("validate", map.validate());
+
+        map.clear();
+        assert->is_true("clear invalidates keys", map.empty() && !map.contains(keys[0]) && !map.contains(reused));
+        const corsac::slot_map_key afterClear = map.insert(7);
+        assert->is_true("insert after clear", map[afterClear] == 7 && !map.contains(keys[0]) && map.slot_count() == 5);
+
+        corsac::slot_map<corsac::unique_ptr<int>> owners;
+        const corsac::slot_map_key a = owners.emplace(corsac::make_unique<int>(1));
+        const corsac::slot_map_key b = owners.emplace(corsac::make_unique<int>(2));
+        owners.erase(a);
+        assert->is_true("move-only values", *owners[b] == 2 && owners.size() == 1);
+
+        assert->is_true("hash", corsac::hash<corsac::slot_map_key>()(a) != corsac::hash<corsac::slot_map_key>()(b));
+    });
+    return true;
+}
+
+#endif //CORSAC_SLOT_MAP_TEST_H
@@ -0,0 +1,104 @@
+//
+// test/string_id_test.h
+//
+// Created by Falldot on 18.10.2026.
+// Copyright (c) 2021 Corsac. All rights reserved.
+//
+#ifndef CORSAC_STRING_ID_TEST_H
+#define CORSAC_STRING_ID_TEST_H
+
+#include "Corsac/string_id.h"
+
+#include <string.h>
+#include <stdio.h>
+#include <thread>
+
+using namespace corsac::string_id_literals;
+
+static_assert(corsac::hash_string("abc", 3, 2) == 0xa97f2f7b1d9b3314ULL, "hash_string must be constexpr");
+static_assert("Transform"_sid == corsac::string_id("Transform"), "string_id literal must be constexpr");
+
+inline const char* string_id_test_dispatch(corsac::string_id type)
+{
+    switch(type.hash())
+    {
+        case "damage"_sid.hash(): return "damage";
+        case "heal"_sid.hash():   return "heal";
+        default:                  return "unknown";
+    }
+}
+
+bool string_id_test(corsac::Block* assert)
+{
+    assert->add_block("hash_string", [](corsac::Block* assert)
+    {
+        // constexpr-версия совпадает с hash_bytes на всех ветвях длины.
+        char text[200];
+        for(size_t i = 0; i < sizeof(text); ++i)
+            text[i] = char(0x20 + (i * 37) % 200); // В том числе байты >= 0x80.
+        bool same = true;
+        for(size_t len = 0; len <= sizeof(text); ++len)
+            same = same && corsac::hash_string(text, len, len) == corsac::hash_bytes(text, len, len);
+        assert->is_true("equals hash_bytes", same);
+        assert->is_true("null-terminated", corsac::hash_string("Transform") == corsac::hash_bytes("Transform", 9));
+    });
+    assert->add_block("string_id", [](corsac::Block* assert)
+    {
+        const corsac::string_id transform = corsac::string_id::intern("Transform");
+        assert->is_true("compile-time equals runtime", transform == "Transform"_sid);
+        assert->equal("c_str", transform.c_str(), "Transform");
+        assert->is_true("not interned", corsac::string_id("never interned").c_str() == nullptr);
+        assert->is_true("different strings", transform != corsac::string_id::intern("Velocity"));
+        assert->is_true("empty", corsac::string_id() == ""_sid);
+
+        const char* stored = transform.c_str();
+        char copy[] = "Transform";
+        assert->is_true("stored once", corsac::string_id::intern(copy).c_str() == stored);
+
+        assert->equal("switch", string_id_test_dispatch(corsac::string_id::intern("heal")), "heal");
+        assert->equal("switch default", string_id_test_dispatch("poison"_sid), "unknown");
+    });
+    assert->add_block("string_intern_table", [](corsac::Block* assert)
+    {
+        corsac::string_intern_table table;
+        char name[32];
+        bool found = true;
+        for(int i = 0; i < 5000; ++i)
+        {
+            const int len = snprintf(name, sizeof(name), "asset_%d", i);
+            table.intern(name, size_t(len), corsac::hash_bytes(name, size_t(len)));
+        }
+        for(int i = 0; i < 5000; ++i)
+        {
+            const int len = snprintf(name, sizeof(name), "asset_%d", i);
+            const char* s = table.find(corsac::hash_bytes(name, size_t(len)));
+            found = found && s && strcmp(s, name) == 0;
+        }
+        assert->equal("size after growth", table.size(), (size_t)5000);
+        assert->is_true("find", found);
+
+        static char longText[100000];
+        memset(longText, 'x', sizeof(longText) - 1);
+        const char* stored = table.intern(longText, sizeof(longText) - 1, corsac::hash_bytes(longText, sizeof(longText) - 1));
+        assert->is_true("longer than page", strlen(stored) == sizeof(longText) - 1);
+
+        // Потоки интернируют одни и те же строки: каждая хранится один раз.
+        corsac::string_intern_table shared;
+        auto worker = [&shared]
+        {
+            char local[32];
+            for(int i = 0; i < 1000; ++i)
+            {
+                const int len = snprintf(local, sizeof(local), "event_%d", i);
+                shared.intern(local, size_t(len), corsac::hash_bytes(local, size_t(len)));
+            }
+        };
+        std::thread a(worker), b(worker);
+        a.join();
+        b.join();
+        assert->equal("threads", shared.size(), (size_t)1000);
+    });
+    return true;
+}
+
+#endif //CORSAC_STRING_ID_TEST_H
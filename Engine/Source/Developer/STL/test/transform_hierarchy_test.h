@@ -0,0 +1,147 @@
+//
+// test/transform_hierarchy_test.h
+//
+// Created by Falldot on 18.10.2026.
+// Copyright (c) 2021 Corsac. All rights reserved.
+//
+#ifndef CORSAC_TRANSFORM_HIERARCHY_TEST_H
+#define CORSAC_TRANSFORM_HIERARCHY_TEST_H
+
+#include "Corsac/transform_hierarchy.h"
+
+#include <vector>
+
+// Мировая матрица подъемом по родителям - эталон для линейного прохода.
+inline corsac::transform_matrix transform_hierarchy_test_world(const corsac::transform_hierarchy& h, corsac::slot_map_key n)
+{
+    corsac::transform_matrix m = h.local(n);
+    for(corsac::slot_map_key p = h.parent(n); !p.is_null(); p = h.parent(p))
+        m = h.local(p) * m;
+    return m;
+}
+
+inline bool transform_hierarchy_test_matches(const corsac::transform_hierarchy& h, const std::vector<corsac::slot_map_key>& nodes)
+{
+    for(corsac::slot_map_key n : nodes)
+    {
+        if(!h.contains(n))
+            continue;
+        const corsac::transform_matrix expected = transform_hierarchy_test_world(h, n);
+        for(int i = 0; i < 12; ++i)
+        {
+            const float d = h.world(n).m[i] - expected.m[i];
+            if(d > 1e-4f || d < -1e-4f)
+                return false;
+        }
+    }
+    return true;
+}
+
+bool transform_hierarchy_test(corsac::Block* assert)
+{
+    assert->add_block("transform_matrix", [](corsac::Block* assert)
+    {
+        using corsac::transform_matrix;
+        const transform_matrix m = transform_matrix::translation(1.0f, 2.0f, 3.0f) * transform_matrix::scale(2.0f, 2.0f, 2.0f);
+        assert->is_true("scale then translate", m.m[0] == 2.0f && m.m[3] == 1.0f && m.m[7] == 2.0f && m.m[11] == 3.0f);
+        const transform_matrix n = transform_matrix::scale(2.0f, 2.0f, 2.0f) * transform_matrix::translation(1.0f, 2.0f, 3.0f);
+        assert->is_true("translate then scale", n.m[3] == 2.0f && n.m[7] == 4.0f && n.m[11] == 6.0f);
+        assert->is_true("identity", transform_matrix::identity() * m == m && m * transform_matrix::identity() == m);
+    });
+
+    assert->add_block("transform_hierarchy", [](corsac::Block* assert)
+    {
+        using corsac::transform_matrix;
+        corsac::transform_hierarchy h;
+
+        // Дерево в глубину сохраняет прямой порядок без перестройки.
+        const auto root  = h.create(transform_matrix::translation(10.0f, 0.0f, 0.0f));
+        const auto arm   = h.create(transform_matrix::translation(0.0f, 1.0f, 0.0f), root);
+        const auto hand  = h.create(transform_matrix::scale(2.0f, 2.0f, 2.0f), arm);
+        const auto other = h.create(transform_matrix::translation(0.0f, 0.0f, 5.0f));
+        assert->is_true("depth-first build stays sorted", h.sorted() && h.validate());
+        assert->is_true("subtree sizes", h.subtree_size(h.row(root)) == 3 && h.subtree_size(h.row(other)) == 1);
+
+        h.update();
+        const transform_matrix& w = h.world(hand);
+        assert->is_true("composition", w.m[3] == 10.0f && w.m[7] == 1.0f && w.m[0] == 2.0f);
+
+        // Изменение родителя доходит до всех потомков.
+        h.set_local(root, transform_matrix::translation(20.0f, 0.0f, 0.0f));
+        h.update();
+        assert->is_true("dirty propagation", h.world(hand).m[3] == 20.0f && h.world(other).m[11] == 5.0f);
+
+        // Ребенок первого корня после второго корня нарушает порядок до sort.
+        const auto late = h.create(transform_matrix::translation(1.0f, 0.0f, 0.0f), root);
+        assert->is_true("child out of order", !h.sorted() && h.validate());
+        h.update();
+        assert->is_true("sorted subtree", h.sorted() && h.validate() && h.subtree_size(h.row(root)) == 4 && h.row(other) == 4);
+        assert->equal("late child", h.world(late).m[3], 21.0f);
+
+        // Перенос поддерева под другой корень.
+        h.set_parent(arm, other);
+        h.update();
+        assert->is_true("reparent", h.validate() && h.parent(hand) == arm && h.parent(arm) == other);
+        assert->is_true("reparent world", h.world(hand).m[3] == 0.0f && h.world(hand).m[11] == 5.0f && h.world(hand).m[7] == 1.0f);
+        h.set_parent(arm, corsac::slot_map_key());
+        h.update();
+        assert->is_true("detach", h.parent(arm).is_null() && h.world(arm).m[11] == 0.0f && h.validate());
+
+        assert->equal("destroy subtree", h.destroy(arm), 2u);
+        assert->is_true("destroyed", !h.contains(arm) && !h.contains(hand) && h.size() == 3 && h.validate());
+        assert->equal("stale", h.destroy(hand), 0u);
+        assert->is_true("survivors", h.world(late).m[3] == 21.0f && h.world(other).m[11] == 5.0f);
+    });
+
+    assert->add_block("random trees", [](corsac::Block* assert)
+    {
+        using corsac::transform_matrix;
+        corsac::transform_hierarchy h;
+        std::vector<corsac::slot_map_key> nodes;
+        uint32_t state = 777;
+        auto next = [&state](uint32_t n) { state = state * 1664525u + 1013904223u; return (state >> 8) % n; };
+
+        for(int i = 0; i < 500; ++i)
+        {
+            const corsac::slot_map_key parent = (nodes.empty() || next(8) == 0) ? corsac::slot_map_key() : nodes[next((uint32_t)nodes.size())];
+            nodes.push_back(h.create(transform_matrix::translation((float)next(10), (float)next(10), 0.0f) * transform_matrix::scale(1.0f, 1.0f, 1.01f), parent));
+        }
+        h.update();
+        assert->is_true("build", h.validate() && transform_hierarchy_test_matches(h, nodes));
+
+        bool ok = true;
+        for(int frame = 0; frame < 20; ++frame)
+        {
+            for(int i = 0; i < 10; ++i)
+            {
+                const corsac::slot_map_key n = nodes[next((uint32_t)nodes.size())];
+                if(h.contains(n))
+                    h.set_local(n, transform_matrix::translation((float)frame, 1.0f, 0.0f));
+            }
+            // Перенос под узел вне собственного поддерева.
+            const corsac::slot_map_key n = nodes[next((uint32_t)nodes.size())];
+            const corsac::slot_map_key p = nodes[next((uint32_t)nodes.size())];
+            if(h.contains(n) && h.contains(p))
+            {
+                bool cycle = false;
+                for(corsac::slot_map_key a = p; !a.is_null(); a = h.parent(a))
+                    cycle = cycle || a == n;
+                if(!cycle)
+                    h.set_parent(n, p);
+            }
+            if(frame % 5 == 4)
+                h.destroy(nodes[next((uint32_t)nodes.size())]);
+
+            // Поддеревья корней считаются по отдельности, как задачи.
+            h.sort();
+            for(uint32_t r = 0; r < h.size(); r += h.subtree_size(r))
+                h.update_range(r, r + h.subtree_size(r));
+            h.clear_dirty();
+            ok = ok && h.validate() && transform_hierarchy_test_matches(h, nodes);
+        }
+        assert->is_true("edits and split update", ok);
+    });
+    return true;
+}
+
+#endif //CORSAC_TRANSFORM_HIERARCHY_TEST_H
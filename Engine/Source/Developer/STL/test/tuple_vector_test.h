@@ -0,0 +1,223 @@
+//
+// test/tuple_vector_test.h
+//
+// Created by Falldot on 18.10.2026.
+// Copyright (c) 2021 Corsac. All rights reserved.
+//
+#ifndef CORSAC_TUPLE_VECTOR_TEST_H
+#define CORSAC_TUPLE_VECTOR_TEST_H
+
+#include "Corsac/tuple_vector.h"
+#include "Corsac/tiled_tuple_vector.h"
+#include "Corsac/unique_ptr.h"
+
+#include <algorithm>
+#include <vector>
+
+struct tuple_vector_test_matrix
+{
+    float m[16];
+};
+
+// Выравнивание больше, чем гарантирует распределитель: перемещение запоминает невыровненный адрес.
+struct alignas(64) tuple_vector_test_wide
+{
+    static inline bool misaligned = false;
+
+    int value;
+
+    explicit tuple_vector_test_wide(int v) : value(v) {}
+    tuple_vector_test_wide(tuple_vector_test_wide&& x) noexcept : value(x.value) { misaligned = misaligned || ((uintptr_t)this % 64) != 0; }
+    tuple_vector_test_wide& operator=(tuple_vector_test_wide&& x) noexcept { value = x.value; return *this; }
+};
+
+namespace corsac
+{
+    template <>
+    struct tuple_vector_column_alignment<tuple_vector_test_matrix> : public integral_constant<size_t, 64> {};
+}
+
+bool tuple_vector_test(corsac::Block* assert)
+{
+    assert->add_block("get_span", [](corsac::Block* assert)
+    {
+        corsac::tuple_vector<char, double, tuple_vector_test_matrix, float> v;
+        for(int i = 0; i < 7; ++i)
+            v.push_back((char)i, (double)i, tuple_vector_test_matrix{ { (float)i } }, (float)i);
+
+        auto chars    = v.get_span<0>();
+        auto doubles  = v.get_span<double>();
+        auto matrices = v.get_span<2>();
+        auto floats   = v.get_span<3>();
+
+        static_assert(decltype(chars)::alignment == 32, "default column alignment");
+        static_assert(decltype(matrices)::alignment == 64, "specialized column alignment");
+
+        assert->is_true("size", chars.size() == 7 && floats.size() == 7 && floats.size_bytes() == 7 * sizeof(float));
+        assert->is_true("data", chars.data() == v.get<0>() && doubles.data() == v.get<1>() && floats.aligned_data() == v.get<3>());
+        assert->is_true("chars aligned", ((uintptr_t)chars.data() % 32) == 0);
+        assert->is_true("doubles aligned", ((uintptr_t)doubles.data() % 32) == 0);
+        assert->is_true("matrices aligned", ((uintptr_t)matrices.data() % 64) == 0);
+        assert->is_true("floats aligned", ((uintptr_t)floats.data() % 32) == 0);
+        assert->is_true("validate", v.validate());
+
+        float sum = 0.0f;
+        for(float f : floats)
+            sum += f;
+        assert->equal("iterate", sum, 21.0f);
+        assert->equal("element", matrices[6].m[0], 6.0f);
+
+        const auto& cv = v;
+        corsac::column_span<const double, 32> constDoubles = cv.get_span<1>();
+        assert->equal("const span", constDoubles[3], 3.0);
+
+        v.clear();
+        assert->is_true("empty", v.get_span<0>().empty());
+    });
+
+    assert->add_block("sort_by", [](corsac::Block* assert)
+    {
+        // Ключи с повторами: устойчивость проверяется по второй колонке (исходный номер строки).
+        corsac::tuple_vector<uint32_t, int, float> v;
+        std::vector<std::pair<uint32_t, int>> expected;
+        uint32_t state = 12345;
+        for(int i = 0; i < 1000; ++i)
+        {
+            state = state * 1664525u + 1013904223u;
+            const uint32_t key = (state >> 16) % 50;
+            v.push_back(key, int(i), (float)i);
+            expected.emplace_back(key, i);
+        }
+        std::stable_sort(expected.begin(), expected.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        v.sort_by<0>();
+        bool sorted = true;
+        for(size_t i = 0; i < v.size(); ++i)
+        {
+            sorted = sorted && v.get<0>()[i] == expected[i].first && v.get<1>()[i] == expected[i].second;
+            sorted = sorted && v.get<2>()[i] == (float)v.get<1>()[i];
+        }
+        assert->is_true("stable by key", sorted);
+
+        v.sort_by<float>(corsac::greater<float>());
+        bool descending = true;
+        for(size_t i = 0; i < v.size(); ++i)
+            descending = descending && v.get<1>()[i] == int(999 - i);
+        assert->is_true("by type with compare", descending);
+
+        const size_t reverse[] = { 4, 3, 2, 1, 0 };
+        corsac::tuple_vector<int, corsac::unique_ptr<int>> owners;
+        for(int i = 0; i < 5; ++i)
+            owners.push_back(int(i), corsac::make_unique<int>(i * 10));
+        owners.apply_permutation(reverse);
+        bool permuted = true;
+        for(int i = 0; i < 5; ++i)
+            permuted = permuted && owners.get<0>()[i] == 4 - i && *owners.get<1>()[i] == (4 - i) * 10;
+        assert->is_true("apply_permutation with move-only column", permuted);
+
+        owners.sort_by<0>();
+        assert->is_true("sort move-only column", owners.get<0>()[0] == 0 && *owners.get<1>()[4] == 40);
+
+        // Временный буфер колонки с выравниванием 64 выравнивается вручную.
+        corsac::tuple_vector<int, tuple_vector_test_wide> wide;
+        for(int i = 0; i < 100; ++i)
+            wide.emplace_back(99 - i, tuple_vector_test_wide(99 - i));
+        tuple_vector_test_wide::misaligned = false;
+        wide.sort_by<0>();
+        const bool wideSorted = wide.get<0>()[5] == 5 && wide.get<1>()[5].value == 5;
+        size_t wideReverse[100];
+        for(size_t i = 0; i < 100; ++i)
+            wideReverse[i] = 99 - i;
+        wide.apply_permutation(wideReverse);
+        assert->is_true("over-aligned scratch", wideSorted && wide.get<1>()[5].value == 94 && !tuple_vector_test_wide::misaligned);
+
+        corsac::tuple_vector<int> empty;
+        empty.sort_by<0>();
+        assert->is_true("empty", empty.empty());
+    });
+
+    assert->add_block("tiled_tuple_vector", [](corsac::Block* assert)
+    {
+        using tiled = corsac::tiled_tuple_vector<8, float, double, int>;
+
+        static_assert(tiled::kAlignment == 32, "columns must be aligned for 256-bit loads");
+        static_assert(tiled::kTileBytes == 32 + 64 + 32, "float, double and int columns of 8 elements");
+
+        tiled v;
+        assert->is_true("empty", v.empty() && v.capacity() == 0 && v.tile_count() == 0);
+
+        for(int i = 0; i < 21; ++i)
+            v.push_back((float)i, (double)i * 2.0, i * 3);
+
+        assert->equal("size", v.size(), (size_t)21);
+        assert->is_true("capacity is a multiple of the tile", v.capacity() >= 21 && v.capacity() % 8 == 0);
+        assert->equal("tile_count", v.tile_count(), (size_t)3);
+        assert->equal("last tile elements", v.tile_elements(2), (size_t)5);
+        assert->is_true("validate", v.validate());
+
+        bool aligned = true;
+        for(size_t t = 0; t < v.tile_count(); ++t)
+        {
+            aligned = aligned && ((uintptr_t)v.tile<0>(t) % 32) == 0;
+            aligned = aligned && ((uintptr_t)v.tile<1>(t) % 32) == 0;
+            aligned = aligned && ((uintptr_t)v.tile<2>(t) % 32) == 0;
+        }
+        assert->is_true("columns are aligned", aligned);
+
+        bool layout = true;
+        for(int i = 0; i < 21; ++i)
+        {
+            layout = layout && v.get<0>(i) == (float)i && v.get<double>(i) == i * 2.0 && v.get<2>(i) == i * 3;
+            layout = layout && &v.get<0>(i) == v.tile<0>(i / 8) + i % 8;
+        }
+        assert->is_true("element layout", layout);
+
+        corsac::tuple<float&, double&, int&> row = v[10];
+        assert->equal("operator[]", corsac::get<2>(row), 30);
+
+        v.each_tile([](size_t count, float* x, double* y, int* z)
+        {
+            for(size_t i = 0; i < count; ++i)
+            {
+                x[i] += 1.0f;
+                y[i] += 1.0;
+                z[i] += 1;
+            }
+        });
+        assert->is_true("each_tile", v.get<0>(20) == 21.0f && v.get<1>(0) == 1.0 && v.get<2>(20) == 61);
+
+        int visited = 0;
+        for(auto it = v.begin(); it != v.end(); ++it)
+            visited += corsac::get<2>(*it) == 3 * visited + 1;
+        assert->equal("iterators", visited, 21);
+
+        tiled copy(v);
+        assert->is_true("copy", copy == v && copy.size() == 21);
+
+        v.erase_unsorted(0);
+        assert->is_true("erase_unsorted", v.size() == 20 && v.get<2>(0) == 61);
+        v.erase(v.begin() + 1, v.begin() + 3);
+        assert->is_true("erase", v.size() == 18 && v.get<2>(1) == 10 && v.get<2>(17) == 58);
+        v.pop_back();
+        assert->is_true("pop_back", v.size() == 17 && corsac::get<2>(v.back()) == 55);
+
+        v.resize(3);
+        v.shrink_to_fit();
+        assert->is_true("shrink_to_fit", v.size() == 3 && v.capacity() == 8 && v.get<2>(2) == 13);
+
+        tiled moved(corsac::move(copy));
+        assert->is_true("move", copy.empty() && moved.size() == 21 && moved.get<2>(20) == 61);
+
+        // Нетривиальные колонки переносятся при росте и уничтожаются.
+        corsac::tiled_tuple_vector<4, corsac::unique_ptr<int>, int> owners;
+        for(int i = 0; i < 10; ++i)
+            owners.emplace_back(corsac::make_unique<int>(i), int(i));
+        bool owned = true;
+        for(int i = 0; i < 10; ++i)
+            owned = owned && *owners.get<0>(i) == i;
+        assert->is_true("move-only column", owned);
+    });
+    return true;
+}
+
+#endif //CORSAC_TUPLE_VECTOR_TEST_H
@@ -28,10 +28,10 @@ bool type_compound_test(corsac::Block* assert)
 {
     assert->add_block("extent", [](corsac::Block* assert)
     {
-        assert->equal("param is int[10]", corsac::extent<int[10]>::value, 10);
-        assert->equal("param is int[3][6]", corsac::extent<int[3][6], 1>::value, 6);
-        assert->equal("param is int[3][6]", corsac::extent<int[3][8][1], 2>::value, 1);
-        assert->equal("param is int[]", corsac::extent<int[]>::value, 0);
+        assert->equal("param is int[10]", corsac::extent<int[10]>::value, (size_t)10);
+        assert->equal("param is int[3][6]", corsac::extent<int[3][6], 1>::value, (size_t)6);
+        assert->equal("param is int[3][6]", corsac::extent<int[3][8][1], 2>::value, (size_t)1);
+        assert->equal("param is int[]", corsac::extent<int[]>::value, (size_t)0);
     });
     assert->add_block("is_array", [](corsac::Block* assert)
     {
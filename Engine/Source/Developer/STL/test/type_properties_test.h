@@ -74,10 +74,10 @@ bool type_properties_test(corsac::Block* assert)
     assert->add_block("alignment_of", [](corsac::Block* assert) {
         struct A {};
         struct B { int8_t p; int16_t q; };
-        assert->equal("param is struct {}", corsac::alignment_of<A>::value, 1);
-        assert->equal("param is struct { int8_t p; int16_t q; }", corsac::alignment_of<B>::value, 2);
-        assert->equal("param is int", corsac::alignment_of_v<int>, 4);
-        assert->equal("param is double", corsac::alignment_of_v<double>, 8);
+        assert->equal("param is struct {}", corsac::alignment_of<A>::value, (size_t)1);
+        assert->equal("param is struct { int8_t p; int16_t q; }", corsac::alignment_of<B>::value, (size_t)2);
+        assert->equal("param is int", corsac::alignment_of_v<int>, (size_t)4);
+        assert->equal("param is double", corsac::alignment_of_v<double>, (size_t)8);
     });
     assert->add_block("is_aligned", [](corsac::Block* assert) {
         struct A { int64_t p; int64_t q; };
@@ -147,11 +147,11 @@ bool type_traits_test(corsac::Block* assert)
     });
     assert->add_block("static_max", [](corsac::Block* assert)
     {
-        assert->equal("param is 3, 5, 11, 3", corsac::static_max<3, 5, 11, 3>::value, 11);
+        assert->equal("param is 3, 5, 11, 3", corsac::static_max<3, 5, 11, 3>::value, (size_t)11);
     });
     assert->add_block("static_min", [](corsac::Block* assert)
     {
-        assert->equal("param is 3, 5, 11, 3", corsac::static_min<3, 5, 11, 3>::value, 3);
+        assert->equal("param is 3, 5, 11, 3", corsac::static_min<3, 5, 11, 3>::value, (size_t)3);
     });
     return true;
 }
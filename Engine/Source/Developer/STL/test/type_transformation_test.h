@@ -74,8 +74,8 @@ bool type_transformation_test(corsac::Block* assert) {
     });
     assert->add_block("aligned_storage", [](corsac::Block *assert) {
         using Type = corsac::aligned_storage<sizeof(int), alignof(double)>::type;
-        assert->equal("param is sizeof(int), alignof(double)", alignof(int), 4);
-        assert->equal("param is sizeof(int), alignof(double)", alignof(Type), 8);
+        assert->equal("param is sizeof(int), alignof(double)", alignof(int), (size_t)4);
+        assert->equal("param is sizeof(int), alignof(double)", alignof(Type), (size_t)8);
     });
     assert->add_block("aligned_union", [](corsac::Block *assert) {
         union U_type
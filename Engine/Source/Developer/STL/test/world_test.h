@@ -0,0 +1,365 @@
+//
+// test/world_test.h
+//
+// Created by Falldot on 18.10.2026.
+// Copyright (c) 2021 Corsac. All rights reserved.
+//
+#ifndef CORSAC_WORLD_TEST_H
+#define CORSAC_WORLD_TEST_H
+
+#include "Corsac/world.h"
+#include "Corsac/query.h"
+#include "Corsac/unique_ptr.h"
+
+#include <algorithm>
+#include <thread>
+#include <utility>
+#include <vector>
+
+struct world_test_position { float x, y, z; };
+struct world_test_velocity { float x, y, z; };
+struct world_test_tag {};
+
+// Считает живые экземпляры: каждый созданный компонент должен быть уничтожен ровно один раз.
+struct world_test_tracked
+{
+    static int& alive() { static int count = 0; return count; }
+
+    int value;
+    explicit world_test_tracked(int v) : value(v) { ++alive(); }
+    world_test_tracked(world_test_tracked&& x) noexcept : value(x.value) { ++alive(); }
+    world_test_tracked(const world_test_tracked&) = delete;
+    ~world_test_tracked() { --alive(); }
+};
+
+bool world_test(corsac::Block* assert)
+{
+    assert->add_block("world", [](corsac::Block* assert)
+    {
+        using namespace corsac;
+        {
+            world w;
+            const entity a = w.spawn(world_test_position{ 1.0f, 2.0f, 3.0f }, world_test_velocity{ 1.0f, 0.0f, 0.0f });
+            const entity b = w.spawn(world_test_position{ 4.0f, 5.0f, 6.0f });
+            const entity c = w.spawn();
+            assert->is_true("spawn", w.size() == 3 && w.alive(a) && w.alive(b) && w.alive(c));
+            assert->is_true("get", w.get<world_test_position>(a)->y == 2.0f && w.get<world_test_velocity>(b) == nullptr);
+            assert->is_true("has", w.has<world_test_velocity>(a) && !w.has<world_test_velocity>(b) && !w.has<world_test_position>(c));
+
+            w.add<world_test_velocity>(b, world_test_velocity{ 0.0f, 1.0f, 0.0f });
+            assert->is_true("add moves to the shared archetype", w.get<world_test_position>(b)->z == 6.0f && w.get<world_test_velocity>(b)->y == 1.0f);
+            assert->is_true("archetype reused", w.archetype_count() == 3);
+            assert->is_true("add keeps neighbours", w.get<world_test_position>(a)->x == 1.0f);
+
+            assert->is_true("remove", w.remove<world_test_velocity>(a) && !w.has<world_test_velocity>(a) && !w.remove<world_test_velocity>(a));
+            assert->equal("remove keeps other components", w.get<world_test_position>(a)->z, 3.0f);
+
+            const archetype& ab = w.archetype_at(2);
+            assert->is_true("column alignment", ((uintptr_t)ab.column_data(0) % CORSAC_WORLD_COLUMN_ALIGNMENT) == 0);
+
+            assert->is_true("despawn", w.despawn(a) && !w.alive(a) && !w.despawn(a) && w.get<world_test_position>(a) == nullptr);
+            assert->is_true("despawn keeps others", w.get<world_test_position>(b)->x == 4.0f && w.size() == 2);
+
+            w.add<world_test_tracked>(c, 7);
+            w.add<world_test_tracked>(c, 8);
+            assert->is_true("add replaces", w.get<world_test_tracked>(c)->value == 8 && world_test_tracked::alive() == 1);
+        }
+        assert->equal("world destroys components", world_test_tracked::alive(), 0);
+    });
+
+    assert->add_block("command_buffer", [](corsac::Block* assert)
+    {
+        using namespace corsac;
+        {
+            world w;
+            static entity entities[300];
+            for(int i = 0; i < 300; ++i)
+                entities[i] = w.spawn(world_test_position{ (float)i, 0.0f, 0.0f });
+
+            command_buffer commands;
+            for(int i = 0; i < 300; ++i)
+            {
+                // Несколько изменений одной сущности сворачиваются в один переезд.
+                commands.add<world_test_velocity>(entities[i], world_test_velocity{ 0.0f, (float)i, 0.0f });
+                commands.add<world_test_tracked>(entities[i], i);
+                if(i % 3 == 0)
+                    commands.remove<world_test_tracked>(entities[i]);
+                if(i % 5 == 0)
+                    commands.despawn(entities[i]);
+            }
+            commands.spawn(world_test_position{ -1.0f, 0.0f, 0.0f }, world_test_tag{});
+            commands.add<world_test_position>(entity(12345, 0), world_test_position{});
+            assert->is_true("deferred", w.size() == 300 && !w.has<world_test_velocity>(entities[1]) && world_test_tracked::alive() == 300);
+
+            w.apply(commands);
+            assert->is_true("buffer is reset", commands.empty());
+            assert->equal("size", w.size(), 300u - 60u + 1u);
+
+            bool applied = true;
+            int tracked = 0;
+            for(int i = 0; i < 300; ++i)
+            {
+                if(i % 5 == 0)
+                {
+                    applied = applied && !w.alive(entities[i]);
+                    continue;
+                }
+                applied = applied && w.get<world_test_position>(entities[i])->x == (float)i;
+                applied = applied && w.get<world_test_velocity>(entities[i])->y == (float)i;
+                applied = applied && w.has<world_test_tracked>(entities[i]) == (i % 3 != 0);
+                if(i % 3 != 0)
+                {
+                    applied = applied && w.get<world_test_tracked>(entities[i])->value == i;
+                    ++tracked;
+                }
+            }
+            assert->is_true("applied", applied);
+            assert->equal("dropped components destroyed", world_test_tracked::alive(), tracked);
+
+            // Сущность, созданная командой, в своем архетипе.
+            bool spawned = false;
+            for(uint32_t i = 0; i < w.archetype_count(); ++i)
+            {
+                archetype& a = w.archetype_at(i);
+                if(a.column_data<world_test_tag>() && a.size() == 1)
+                    spawned = a.column_data<world_test_position>()[0].x == -1.0f;
+            }
+            assert->is_true("spawn", spawned);
+
+            commands.add<world_test_tracked>(entities[1], 100);
+            commands.clear();
+            assert->equal("clear destroys components", world_test_tracked::alive(), tracked);
+
+            // Буферы потоков применяются одним flush.
+            std::thread worker([&w]
+            {
+                for(int i = 0; i < 10; ++i)
+                    w.thread_commands().spawn(world_test_tracked(i));
+            });
+            worker.join();
+            w.thread_commands().despawn(entities[1]);
+            assert->is_true("thread buffers", &w.thread_commands() == &w.thread_commands());
+            w.flush();
+            assert->is_true("flush", w.size() == 300u - 60u + 1u + 10u - 1u && world_test_tracked::alive() == tracked + 10 - 1);
+        }
+        assert->equal("no leaks", world_test_tracked::alive(), 0);
+    });
+    assert->add_block("query", [](corsac::Block* assert)
+    {
+        using namespace corsac;
+        world w;
+        for(int i = 0; i < 10; ++i)
+            w.spawn(world_test_position{ (float)i, 0.0f, 0.0f }, world_test_velocity{ 1.0f, 0.0f, 0.0f });
+        for(int i = 0; i < 5; ++i)
+            w.spawn(world_test_position{ (float)i, 0.0f, 0.0f });
+
+        query<world_test_position, const world_test_velocity> moving(w);
+        query<world_test_position> statics(w, component_mask::of<world_test_velocity>());
+        assert->is_true("match", moving.size() == 10 && moving.archetype_count() == 1);
+        assert->is_true("exclude", statics.size() == 5 && statics.archetype_count() == 1);
+
+        moving.each([](world_test_position& p, const world_test_velocity& v) { p.x += v.x; });
+        float sum = 0.0f;
+        statics.each([&sum](const world_test_position& p) { sum += p.x; });
+        assert->equal("each", sum, 10.0f);
+
+        // Новый архетип попадает в кэш при следующем обходе, старые не проверяются заново.
+        const entity tagged = w.spawn(world_test_position{ 100.0f, 0.0f, 0.0f }, world_test_velocity{ 2.0f, 0.0f, 0.0f }, world_test_tag{});
+        assert->equal("not updated yet", moving.archetype_count(), 1u);
+        uint32_t chunks = 0, rows = 0;
+        moving.each_chunk([&](uint32_t count, world_test_position* p, const world_test_velocity* v)
+        {
+            ++chunks;
+            rows += count;
+            for(uint32_t i = 0; i < count; ++i)
+                p[i].y += v[i].x;
+        });
+        assert->is_true("incremental", moving.archetype_count() == 2 && chunks == 2 && rows == 11);
+        assert->equal("each_chunk", w.get<world_test_position>(tagged)->y, 2.0f);
+
+        bool found = false;
+        moving.each_entity([&](entity e, world_test_position& p, const world_test_velocity&) { found = found || (e == tagged && p.x == 100.0f); });
+        assert->is_true("each_entity", found);
+
+        // Пустые архетипы пропускаются.
+        w.despawn(tagged);
+        chunks = 0;
+        moving.each_chunk([&](uint32_t, world_test_position*, const world_test_velocity*) { ++chunks; });
+        assert->equal("skip empty", chunks, 1u);
+    });
+
+    assert->add_block("change ticks", [](corsac::Block* assert)
+    {
+        using namespace corsac;
+        world w;
+        entity entities[600];
+        for(uint32_t i = 0; i < 600; ++i)
+            entities[i] = w.spawn(world_test_position{ (float)i, 0.0f, 0.0f });
+
+        query<changed<const world_test_position>> changedPositions(w);
+        uint32_t rows = 0, runs = 0;
+        auto countRows = [&](uint32_t count, const world_test_position*) { rows += count; ++runs; };
+
+        changedPositions.each_chunk(countRows);
+        assert->equal("first run sees everything", rows, 600u);
+        rows = runs = 0;
+        changedPositions.each_chunk(countRows);
+        assert->equal("nothing changed", rows, 0u);
+
+        // Запись через get<T> отмечает строку, чтение через get<const T> - нет.
+        w.get<world_test_position>(entities[5])->x = -1.0f;
+        w.get<world_test_position>(entities[400])->x = -1.0f;
+        w.get<const world_test_position>(entities[300]);
+        changedPositions.each_chunk(countRows);
+        assert->is_true("get marks changed", rows == 2 && runs == 2);
+
+        // Неконстантный компонент запроса отмечается обходом, но сам запрос своих записей не видит.
+        query<changed<world_test_position>> writer(w);
+        writer.each([](world_test_position& p) { p.y = 1.0f; });
+        rows = 0;
+        writer.each([&rows](world_test_position&) { ++rows; });
+        assert->equal("query ignores own writes", rows, 0u);
+        rows = runs = 0;
+        changedPositions.each_chunk(countRows);
+        assert->is_true("writes by other query", rows == 600 && runs == 1);
+
+        // Запись напрямую в колонку архетипа тоже отмечается: указатель для записи выдает только column_data_mut.
+        uint32_t positionOnly = 0;
+        while(w.archetype_at(positionOnly).size() != 600)
+            ++positionOnly;
+        archetype& arch = w.archetype_at(positionOnly);
+        const uint32_t column = arch.column_index(component_type_id<world_test_position>());
+        static_cast<world_test_position*>(arch.element_mut(column, 5, w.change_tick()))->z = 2.0f;
+        rows = 0;
+        changedPositions.each_chunk(countRows);
+        assert->equal("element_mut marks changed", rows, 1u);
+        arch.column_data_mut<world_test_position>(w.change_tick())[7].z = 3.0f;
+        rows = 0;
+        changedPositions.each_chunk(countRows);
+        assert->equal("column_data_mut marks the column", rows, 600u);
+
+        // Такты переезжают вместе со строками: перенос в другой архетип и закрытие строки ничего не меняют.
+        w.add<world_test_tag>(entities[10]);
+        w.despawn(entities[0]);
+        rows = 0;
+        changedPositions.each_chunk(countRows);
+        assert->equal("moves keep ticks", rows, 0u);
+
+        query<added<world_test_velocity>, const world_test_position> addedVelocity(w);
+        addedVelocity.each([](world_test_velocity&, const world_test_position&) {});
+        w.add<world_test_velocity>(entities[20], world_test_velocity{ 1.0f, 0.0f, 0.0f });
+        command_buffer commands;
+        commands.add<world_test_velocity>(entities[30], world_test_velocity{ 2.0f, 0.0f, 0.0f });
+        commands.spawn(world_test_position{}, world_test_velocity{ 3.0f, 0.0f, 0.0f });
+        w.apply(commands);
+        float sum = 0.0f;
+        addedVelocity.each([&sum](world_test_velocity& v, const world_test_position&) { sum += v.x; });
+        assert->equal("added", sum, 6.0f);
+
+        // Замена существующего компонента - изменение, но не добавление.
+        w.add<world_test_velocity>(entities[20], world_test_velocity{ 5.0f, 0.0f, 0.0f });
+        query<changed<const world_test_velocity>> changedVelocity(w);
+        changedVelocity.each([](const world_test_velocity&) {});
+        w.add<world_test_velocity>(entities[20], world_test_velocity{ 7.0f, 0.0f, 0.0f });
+        sum = 0.0f;
+        changedVelocity.each([&sum](const world_test_velocity& v) { sum += v.x; });
+        addedVelocity.each([&sum](world_test_velocity& v, const world_test_position&) { sum += v.x; });
+        assert->equal("replace", sum, 7.0f);
+    });
+
+    assert->add_block("snapshot", [](corsac::Block* assert)
+    {
+        using namespace corsac;
+        world w;
+        std::vector<entity> entities;
+        for(uint32_t i = 0; i < 1000; ++i)
+        {
+            entities.push_back(w.spawn(world_test_position{ (float)i, 0.0f, 0.0f }, world_test_velocity{ 1.0f, 0.0f, 0.0f }));
+            if(i % 3 == 0)
+                w.add<world_test_tag>(entities.back());
+        }
+
+        // Состояние мира: позиции всех живых сущностей по индексу.
+        query<const world_test_position> positions(w);
+        auto capture = [&positions]
+        {
+            std::vector<std::pair<uint64_t, float>> state;
+            positions.each_entity([&state](entity e, const world_test_position& p) { state.emplace_back(e.value(), p.x + p.y); });
+            std::sort(state.begin(), state.end());
+            return state;
+        };
+
+        world_snapshot full;
+        const bool taken = w.snapshot(full);
+        const auto fullState = capture();
+        assert->is_true("full", taken && !full.empty() && full.base() == nullptr && full.block_count() == 5);
+
+        // Запись, структурные изменения и новые сущности после снимка.
+        for(uint32_t i = 0; i < 1000; i += 100)
+            w.get<world_test_position>(entities[i])->y = 5.0f;
+        w.despawn(entities[1]);
+        w.remove<world_test_velocity>(entities[2]);
+        const entity fresh = w.spawn(world_test_position{ -1.0f, 0.0f, 0.0f });
+
+        world_snapshot delta;
+        w.snapshot(delta, &full);
+        const auto deltaState = capture();
+        assert->is_true("delta is smaller", delta.base() == &full && delta.size_bytes() < full.size_bytes());
+
+        // Компоненты с деструктором в архетипе, созданном после снимков, уничтожаются при откате.
+        const int tracked = world_test_tracked::alive();
+        w.add<world_test_tracked>(entities[500], 1);
+        w.despawn(entities[700]);
+        for(uint32_t i = 0; i < 1000; ++i)
+        {
+            if(world_test_position* p = w.get<world_test_position>(entities[i]))
+                p->x = 0.0f;
+        }
+
+        // Нетривиальный компонент в непустом архетипе: снимок не делается, мир не меняется.
+        world_snapshot refused;
+        const uint32_t tickBefore = w.change_tick();
+        assert->is_true("non-trivial component refused", !w.snapshot(refused) && refused.empty() && w.change_tick() == tickBefore);
+        assert->is_true("empty snapshot is not restored", !w.restore(refused) && w.has<world_test_tracked>(entities[500]));
+
+        assert->is_true("restore returns true", w.restore(delta));
+        assert->is_true("restore delta", capture() == deltaState && w.alive(fresh) && !w.alive(entities[1]) && w.alive(entities[700]));
+        assert->is_true("restore delta components", !w.has<world_test_velocity>(entities[2]) && w.has<world_test_tag>(entities[3]) && !w.has<world_test_tracked>(entities[500]));
+        assert->equal("destroyed", world_test_tracked::alive(), tracked);
+
+        w.restore(full);
+        assert->is_true("restore full", capture() == fullState && !w.alive(fresh) && w.alive(entities[1]) && w.has<world_test_velocity>(entities[2]));
+        assert->is_true("entities", w.size() == 1000 && w.entities().validate());
+
+        // Восстановленные компоненты видны фильтрам как измененные.
+        query<changed<const world_test_velocity>> changedVelocity(w);
+        changedVelocity.each([](const world_test_velocity&) {});
+        w.restore(full);
+        uint32_t rows = 0;
+        changedVelocity.each([&rows](const world_test_velocity&) { ++rows; });
+        assert->equal("restore marks changed", rows, 1000u);
+
+        // После отката мир продолжает работать: новые сущности занимают свободные индексы.
+        const entity again = w.spawn(world_test_position{ 3.0f, 0.0f, 0.0f });
+        assert->is_true("spawn after restore", w.alive(again) && w.get<world_test_position>(again)->x == 3.0f && w.alive(entities[999]));
+
+        // Индекс свободен в снимке, но занят после него: после отката такая сущность мертва,
+        // хотя ее поколение совпадает с поколением свободного индекса.
+        world r;
+        const entity a = r.spawn(world_test_position{ 1.0f, 0.0f, 0.0f });
+        const entity b = r.spawn(world_test_position{ 2.0f, 0.0f, 0.0f });
+        r.despawn(a);
+        world_snapshot freed;
+        r.snapshot(freed);
+        const entity c = r.spawn(world_test_position{ 3.0f, 0.0f, 0.0f });
+        r.restore(freed);
+        assert->is_true("recycled index is dead", c.index == a.index && !r.alive(c) && r.get<world_test_position>(c) == nullptr);
+        assert->is_true("stale despawn", !r.despawn(c) && r.alive(b) && r.get<world_test_position>(b)->x == 2.0f);
+        const entity d = r.spawn(world_test_position{ 4.0f, 0.0f, 0.0f });
+        const entity e = r.spawn(world_test_position{ 5.0f, 0.0f, 0.0f });
+        assert->is_true("recycled index reused once", d.index == a.index && e.index != d.index && r.size() == 3 && r.entities().validate());
+    });
+    return true;
+}
+
+#endif //CORSAC_WORLD_TEST_H
@@ -18,6 +18,9 @@ namespace corsac
             "\n"
             "project("+project+" VERSION 0.1.0)\n"
             "\n"
+            "set(CMAKE_CXX_STANDARD 17)\n"
+            "set(CMAKE_CXX_STANDARD_REQUIRED ON)\n"
+            "\n"
             "include_directories(\n"
             "        src\n"
             "        $ENV{ProgramFiles}/Corsac/include\n"
@@ -45,6 +48,7 @@ namespace corsac
         return
         {
             "#include \"SDL/SDL.h\"\n"
+            "#include \"Corsac/game_loop.h\"\n"
             "\n"
             "int main(int argc, char *argv[])\n"
             "{\n"
@@ -59,24 +63,32 @@ namespace corsac
             "    if (Renderer == nullptr)\n"
             "        return 1;\n"
             "\n"
-            "    SDL_SetRenderDrawColor(Renderer, 0, 0, 0, 255);\n"
-            "    SDL_RenderClear(Renderer);\n"
+            "    // Симуляция идет шагами по 1/60 с, кадры ограничены 60 в секунду.\n"
+            "    corsac::game_loop Loop(corsac::chrono::microseconds(16667), corsac::chrono::microseconds(16667));\n"
             "\n"
-            "    SDL_Event e;\n"
             "    bool quit = false;\n"
-            "    while(!quit)\n"
-            "    {\n"
-            "        while(SDL_PollEvent(&e) != 0 )\n"
+            "    Loop.run(\n"
+            "        [&]\n"
             "        {\n"
-            "            if( e.type == SDL_QUIT )\n"
+            "            SDL_Event e;\n"
+            "            while(SDL_PollEvent(&e) != 0)\n"
             "            {\n"
-            "                quit = true;\n"
+            "                if(e.type == SDL_QUIT)\n"
+            "                    quit = true;\n"
             "            }\n"
-            "        }\n"
-            "        SDL_SetRenderDrawColor(Renderer, 0, 0, 0, 255);\n"
-            "        SDL_RenderClear(Renderer);\n"
-            "        SDL_RenderPresent(Renderer);\n"
-            "    }\n"
+            "            return !quit;\n"
+            "        },\n"
+            "        [&](corsac::game_loop::duration /*step*/)\n"
+            "        {\n"
+            "            // Обновление состояния игры на один фиксированный шаг.\n"
+            "        },\n"
+            "        [&](double /*alpha*/)\n"
+            "        {\n"
+            "            // alpha - доля шага после последнего обновления, для интерполяции отрисовки.\n"
+            "            SDL_SetRenderDrawColor(Renderer, 0, 0, 0, 255);\n"
+            "            SDL_RenderClear(Renderer);\n"
+            "            SDL_RenderPresent(Renderer);\n"
+            "        });\n"
             "\n"
             "    SDL_DestroyRenderer(Renderer);\n"
             "    SDL_DestroyWindow(Window);\n"